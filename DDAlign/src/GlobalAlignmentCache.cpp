@@ -14,6 +14,7 @@
 // Framework include files
 #include <DD4hep/Detector.h>
 #include <DD4hep/Printout.h>
+#include <DD4hep/VolumeManager.h>
 #include <DDAlign/GlobalAlignmentCache.h>
 #include <DDAlign/GlobalAlignmentOperators.h>
 #include <DD4hep/detail/DetectorInterna.h>
@@ -236,6 +237,13 @@ void GlobalAlignmentCache::apply(GlobalAlignmentStack& stack)    {
 #else
   this->m_detDesc.world()->revalidate();
 #endif
+  /// The placement update callbacks above are not fired: refresh the cached
+  /// volume-to-world transformations of the volume manager explicitly.
+  VolumeManager volmgr = m_detDesc.volumeManager();
+  if ( volmgr.isValid() && volmgr.hasWorldCache() )  {
+    printout(INFO,"GlobalAlignmentCache","Refreshing cached volume-to-world transformations....");
+    volmgr.cacheWorldTransformations();
+  }
 }
 
 /// Apply a vector of SD entries of ordered alignments to the geometry structure
@@ -0,0 +1,159 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : agent
+//
+//==========================================================================
+#ifndef DDCOND_CONDITIONSBINARYSNAPSHOT_H
+#define DDCOND_CONDITIONSBINARYSNAPSHOT_H
+
+// Framework include files
+#include <DD4hep/Conditions.h>
+#include <DD4hep/IOV.h>
+#include <DDCond/ConditionsManager.h>
+
+// C/C++ include files
+#include <cstdint>
+#include <string>
+#include <utility>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for implementation details of the AIDA detector description toolkit
+  namespace cond {
+
+    /// Memory mapped binary snapshot of conditions data
+    /**
+     *  The snapshot is a single file with a fixed header followed by
+     *  - the table of intervals of validity,
+     *  - the table of conditions items sorted by conditions key,
+     *  - the payload data area.
+     *  All offsets are relative to the start of the file. The file is relocatable
+     *  and may be mapped read-only by any number of processes at the same time:
+     *  only the page cache is shared, items are materialized on demand.
+     *
+     *  Only payloads with a flat byte representation are supported: int, long, double,
+     *  std::vector<int>, std::vector<long>, std::vector<double>, std::string
+     *  and alignment deltas.
+     *  Derived conditions are never written: they are recomputed after loading.
+     *
+     *  \author  agent
+     *  \version 1.0
+     *  \ingroup DD4HEP_CONDITIONS
+     */
+    class ConditionsBinarySnapshot  {
+    public:
+      /// Format version. Incremented for every incompatible layout change
+      enum { VERSION = 1 };
+      /// Payload identifiers
+      enum PayloadType : std::uint32_t {
+        PAYLOAD_NONE          = 0,
+        PAYLOAD_INT           = 1,
+        PAYLOAD_LONG          = 2,
+        PAYLOAD_DOUBLE        = 3,
+        PAYLOAD_VECTOR_INT    = 4,
+        PAYLOAD_VECTOR_LONG   = 5,
+        PAYLOAD_VECTOR_DOUBLE = 6,
+        PAYLOAD_DELTA         = 7,
+        PAYLOAD_STRING        = 8
+      };
+      /// File header
+      struct Header  {
+        char          magic[8];
+        std::uint32_t version;
+        std::uint32_t endian;
+        std::uint64_t file_size;
+        std::uint64_t num_iovs;
+        std::uint64_t iov_offset;
+        std::uint64_t num_items;
+        std::uint64_t item_offset;
+        std::uint64_t data_offset;
+        std::uint64_t data_size;
+      };
+      /// Interval of validity record
+      struct IOVRecord  {
+        char          type_name[32];
+        std::uint32_t type;
+        std::uint32_t spare;
+        std::int64_t  lower;
+        std::int64_t  upper;
+      };
+      /// Conditions item record
+      struct ItemRecord  {
+        std::uint64_t key;
+        std::uint32_t iov;
+        std::uint32_t payload;
+        std::uint32_t flags;
+        std::uint32_t spare;
+        std::uint64_t offset;
+        std::uint64_t length;
+      };
+      /// Payload layout of alignment deltas
+      struct DeltaRecord  {
+        double        translation[3];
+        double        pivot[3];
+        double        rotation[3];   // Phi, Theta, Psi
+        std::uint32_t flags;
+        std::uint32_t spare;
+      };
+      /// Range of item records for one conditions key
+      typedef std::pair<const ItemRecord*, const ItemRecord*> Items;
+
+    protected:
+      /// Name of the mapped file
+      std::string  m_name;
+      /// Start address of the mapping
+      const char*  m_base = nullptr;
+      /// Size of the mapping
+      std::size_t  m_size = 0;
+
+    public:
+      /// Default constructor
+      ConditionsBinarySnapshot() = default;
+      /// Inhibit copy constructor
+      ConditionsBinarySnapshot(const ConditionsBinarySnapshot& copy) = delete;
+      /// Default destructor. Unmaps the file
+      virtual ~ConditionsBinarySnapshot();
+      /// Inhibit assignment
+      ConditionsBinarySnapshot& operator=(const ConditionsBinarySnapshot& copy) = delete;
+
+      /// Write all non-derived conditions of the manager to a snapshot file. Returns number of items
+      static std::size_t save(ConditionsManager manager, const std::string& output);
+
+      /// Map snapshot file into memory and validate the header and all item records
+      void open(const std::string& input);
+      /// Unmap the snapshot file
+      void close();
+      /// Check if a file is mapped
+      bool isOpen()  const                      {  return m_base != nullptr;   }
+      /// Access the name of the mapped file
+      const std::string& name()  const          {  return m_name;              }
+      /// Access the file header. Throws an exception if no file is mapped
+      const Header& header()  const;
+      /// Access to the IOV table
+      const IOVRecord* iovs()  const            {  return (const IOVRecord*)(m_base+header().iov_offset);  }
+      /// Access to the first item record
+      const ItemRecord* begin()  const          {  return (const ItemRecord*)(m_base+header().item_offset); }
+      /// Access to the end of the item records
+      const ItemRecord* end()  const            {  return begin() + header().num_items; }
+      /// Access to the raw payload of an item
+      const char* payload(const ItemRecord& r) const  {  return m_base + r.offset;   }
+      /// Access all item records of a given conditions key (one per IOV)
+      Items find(Condition::key_type key)  const;
+      /// Access the IOV record of an item
+      const IOVRecord& iov(const ItemRecord& r)  const  {  return iovs()[r.iov];  }
+      /// Access the IOV key of an item
+      IOV::Key iovKey(const ItemRecord& r)  const;
+      /// Create a new condition object from an item record. Not registered to any pool.
+      Condition materialize(const ItemRecord& r)  const;
+    };
+  }        /* End namespace cond               */
+}          /* End namespace dd4hep             */
+#endif // DDCOND_CONDITIONSBINARYSNAPSHOT_H
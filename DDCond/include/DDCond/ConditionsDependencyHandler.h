@@ -19,6 +19,11 @@
 #include "DDCond/ConditionsPool.h"
 #include "DDCond/ConditionsManager.h"
 
+// C/C++ include files
+#include <mutex>
+#include <atomic>
+#include <shared_mutex>
+
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
@@ -44,6 +49,14 @@ namespace dd4hep {
      *  ConditionResolver interface in order to allow for upgrades of
      *  this implementation which might not be polymorph.
      *
+     *  If the conditions manager property "DerivedConditionsThreads" is
+     *  set to a positive value (and TBB is available), the dependencies
+     *  are ordered in levels of the dependency graph. The items of one
+     *  level do not depend on each other and are computed and resolved
+     *  concurrently. Each level is then block-registered to the pool.
+     *  In this mode callbacks may only access their declared dependencies.
+     *  Circular dependencies automatically fall back to serial processing.
+     *
      *  \author  M.Frank
      *  \version 1.0
      */
@@ -105,13 +118,27 @@ namespace dd4hep {
       Work*                       m_block = 0;
       /// Current item of the block
       Work*                       m_currentWork = 0;
+      /// Number of threads for the parallel evaluation (0: serial)
+      int                         m_numThreads  = 0;
+      /// Flag set if the conditions are already registered (parallel mode)
+      bool                        m_registered  = false;
+      /// Lock to protect the user pool: registrations are exclusive, lookups shared
+      std::shared_mutex           m_lock;
     public:
       /// Number of callbacks to the handler for monitoring
-      mutable size_t              num_callback;
+      mutable std::atomic<size_t> num_callback;
 
     protected:
       /// Internal call to trigger update callback
       void do_callback(Work* dep);
+      /// Access the item currently worked on (thread local in parallel mode)
+      Work*& currentWork();
+      /// Order the work items into levels of independent items. False for circular dependencies
+      bool build_levels(std::vector<std::vector<Work*> >& levels)  const;
+      /// Parallel evaluation: compute, resolve and register level by level
+      void compute_parallel(const std::vector<std::vector<Work*> >& levels);
+      /// Block register resolved work items grouped by their IOV
+      void register_work(const std::vector<Work*>& work);
 
     public:
       /// Initializing constructor
@@ -71,6 +71,10 @@ namespace dd4hep {
       /// Select all ACTIVE conditions pools, which do match the IOV requirement (faster)
       size_t select(const IOV& req_validity, std::vector<Element>& valid);
 
+      /// Reset the age of the pools matching the IOV requirement. All other pools age.
+      /** @return Number of pools matching the IOV requirement                        */
+      size_t touch(const IOV& req_validity);
+
       /// Remove all key based pools with an age beyond the minimum age. 
       /** @return Number of conditions cleaned up and removed.                       */
       int clean(int max_age);
@@ -62,6 +62,8 @@ namespace dd4hep {
         size_t loaded   = 0;
         size_t computed = 0;
         size_t missing  = 0;
+        /// Conditions kept from the previous preparation (incremental mode, subset of selected)
+        size_t reused   = 0;
         Result() = default;
         Result(const Result& result) = default;
         Result& operator=(const Result& result) = default;
@@ -203,6 +205,7 @@ namespace dd4hep {
       loaded   += result.loaded;
       computed += result.computed;
       missing  += result.missing;
+      reused   += result.reused;
       return *this;
     }
     /// Subtract results
@@ -212,6 +215,7 @@ namespace dd4hep {
       loaded   -= result.loaded;
       computed -= result.computed;
       missing  -= result.missing;
+      reused   -= result.reused;
       return *this;
     }
   }       /* End namespace cond        */
@@ -61,7 +61,8 @@ namespace dd4hep {
         REGISTER_FULL   = REGISTER_MANAGER|REGISTER_POOL
       };
       enum LoadFlags  {
-        REF_POOLS       = 1<<1
+        REF_POOLS       = 1<<1,
+        INCREMENTAL     = 1<<2
       };
       
       /// Helper to simplify the registration of new condtitions from arbitrary containers.
@@ -149,6 +150,11 @@ namespace dd4hep {
       void refPools()       { this->flags |= REF_POOLS;                                      }
       /// Set flag to not reference the used pools during prepare (and drop possibly pending)
       void derefPools();
+      /// Set flag to only update expired conditions (and their dependents) at the next prepare
+      /** The used pools are referenced like with refPools(): the kept conditions stay valid
+       *  even if a cleanup removes their pools from the conditions manager.
+       */
+      void incremental()    { this->flags |= INCREMENTAL;                                    }
       /// Access the map of conditions from the desired content
       const ConditionsContent::Conditions& conditions() const { return content->conditions();}
       /// Access the map of computational conditions from the desired content
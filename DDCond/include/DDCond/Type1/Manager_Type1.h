@@ -20,6 +20,7 @@
 
 // C/C++ include files
 #include <memory>
+#include <atomic>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -38,6 +39,12 @@ namespace dd4hep {
      *  For convenience, the class definition is here.
      *  See ConditionsManager.cpp for the implementation.
      *
+     *  Readers (select, select_range and the lookup of existing IOV pools in
+     *  registerIOV) do not lock. They access an immutable snapshot of the
+     *  IOV pools, which is re-published atomically whenever pools are added
+     *  or removed. Old snapshots are deleted once all readers, which may
+     *  still see them, left (epoch based deferred deletion).
+     *
      *  \author  M.Frank
      *  \version 1.0
      *  \ingroup DD4HEP_CONDITIONS
@@ -48,6 +55,18 @@ namespace dd4hep {
     public:
       typedef std::vector<ConditionsIOVPool*> TypedConditionPool;
 
+      /// Immutable copy of the IOV pools of all IOV types for lock-free readers
+      /**
+       *  The pools of each IOV type are ordered by IOV key. The snapshot
+       *  shares the ownership of the pools: pools removed from the manager
+       *  stay alive until the last snapshot referencing them is deleted.
+       */
+      struct PoolSnapshot  {
+        typedef std::pair<IOV::Key, std::shared_ptr<ConditionsPool> > Element;
+        /// IOV pools indexed by IOV type
+        std::vector<std::vector<Element> > pools;
+      };
+
     protected:
 
       /** Generic interface of any concrete instance  */
@@ -75,6 +94,12 @@ namespace dd4hep {
       std::unique_ptr<UpdatePool>  m_updatePool;
       /// Reference to the default conditions cleanup object (if registered)
       std::unique_ptr<ConditionsCleanup> m_cleaner;
+      /// Snapshot of the IOV pools accessed by lock-free readers
+      std::atomic<PoolSnapshot*>   m_snapshot { nullptr };
+      /// Reader epoch. Incremented by every snapshot publication
+      std::atomic<unsigned long>   m_epoch    { 0 };
+      /// Number of active readers per epoch parity
+      std::atomic<long>            m_readers[2];
       
     public:
       /// Managed pool of typed conditions indexed by IOV-type and IOV key
@@ -89,6 +114,9 @@ namespace dd4hep {
       /// Retrieve  a condition set given a Detector Element and the conditions name according to their validity
       bool select_range(key_type key, const IOV& req_validity, RangeConditions& conditions);
 
+      /// Publish a new snapshot of the IOV pools and delete the previous one after the grace period
+      void publish_snapshot();
+
       /// Register a set of new managed condition for an IOV range. Called by __load_immediate
       // void __register_immediate(RangeConditions& c);
 
@@ -0,0 +1,420 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : agent
+//
+//==========================================================================
+
+// Framework include files
+#include <DDCond/ConditionsBinarySnapshot.h>
+#include <DDCond/ConditionsIOVPool.h>
+#include <DD4hep/AlignmentData.h>
+#include <DD4hep/Printout.h>
+#include <DD4hep/Primitives.h>
+#include <DD4hep/detail/ConditionsInterna.h>
+
+// C/C++ include files
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <tuple>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace dd4hep::cond;
+
+namespace  {
+
+  typedef ConditionsBinarySnapshot Snapshot;
+  const char          s_magic[8] = { 'D','D','4','H','C','O','N','D' };
+  const std::uint32_t s_endian   = 0x01020304;
+
+  /// Round up to the next multiple of 8 bytes
+  inline std::size_t aligned(std::size_t len)   {  return (len + 7) & ~std::size_t(7);  }
+
+  /// Minimal payload length of the fixed size payload types
+  std::size_t min_length(std::uint32_t payload)  {
+    switch( payload )  {
+    case Snapshot::PAYLOAD_INT:    return sizeof(std::int32_t);
+    case Snapshot::PAYLOAD_LONG:   return sizeof(std::int64_t);
+    case Snapshot::PAYLOAD_DOUBLE: return sizeof(double);
+    case Snapshot::PAYLOAD_DELTA:  return sizeof(Snapshot::DeltaRecord);
+    default:                       return 0;
+    }
+  }
+
+  /// Check the payload length: fixed size types need their size, arrays a multiple of the element size
+  bool valid_length(std::uint32_t payload, std::uint64_t length)  {
+    switch( payload )  {
+    case Snapshot::PAYLOAD_VECTOR_INT:    return length % sizeof(std::int32_t) == 0;
+    case Snapshot::PAYLOAD_VECTOR_LONG:   return length % sizeof(std::int64_t) == 0;
+    case Snapshot::PAYLOAD_VECTOR_DOUBLE: return length % sizeof(double) == 0;
+    default:                              return length >= min_length(payload);
+    }
+  }
+
+  /// Write item to be sorted before it is written to file
+  struct WriteItem  {
+    dd4hep::Condition::key_type key;
+    std::uint32_t iov, payload, flags;
+    std::uint64_t offset, length;
+  };
+
+  /// Append an array to the data area converting the items to the stored type
+  /// The data area stays 8 byte aligned; the recorded length excludes the padding.
+  template <typename STORED, typename T>
+  void append(std::vector<char>& data, const T* ptr, std::size_t len,
+              std::uint64_t& offset, std::uint64_t& length)  {
+    std::size_t start = data.size();
+    data.resize(aligned(start + len*sizeof(STORED)), 0);
+    for( std::size_t i = 0; i < len; ++i )  {
+      STORED v = STORED(ptr[i]);
+      ::memcpy(&data[start+i*sizeof(STORED)], &v, sizeof(STORED));
+    }
+    offset = start;
+    length = len*sizeof(STORED);
+  }
+
+  /// Read an array from the data area converting the items from the stored type
+  template <typename STORED, typename T>
+  void extract(const char* ptr, std::size_t len, std::vector<T>& result)  {
+    std::size_t num = len/sizeof(STORED);
+    result.resize(num);
+    for( std::size_t i = 0; i < num; ++i )  {
+      STORED v;
+      ::memcpy(&v, ptr+i*sizeof(STORED), sizeof(STORED));
+      result[i] = T(v);
+    }
+  }
+
+  /// Encode the condition payload. Returns PAYLOAD_NONE for unsupported types
+  std::uint32_t encode(dd4hep::Condition c, std::vector<char>& data, std::uint64_t& offset, std::uint64_t& length)  {
+    const std::type_info& t = c.typeInfo();
+    std::uint32_t type = Snapshot::PAYLOAD_NONE;
+    if ( t == typeid(int) )  {
+      append<std::int32_t>(data, &c.get<int>(), 1, offset, length);
+      type   = Snapshot::PAYLOAD_INT;
+    }
+    else if ( t == typeid(long) )  {
+      append<std::int64_t>(data, &c.get<long>(), 1, offset, length);
+      type   = Snapshot::PAYLOAD_LONG;
+    }
+    else if ( t == typeid(double) )  {
+      append<double>(data, &c.get<double>(), 1, offset, length);
+      type   = Snapshot::PAYLOAD_DOUBLE;
+    }
+    else if ( t == typeid(std::vector<int>) )  {
+      const auto& v = c.get<std::vector<int> >();
+      append<std::int32_t>(data, v.data(), v.size(), offset, length);
+      type   = Snapshot::PAYLOAD_VECTOR_INT;
+    }
+    else if ( t == typeid(std::vector<long>) )  {
+      const auto& v = c.get<std::vector<long> >();
+      append<std::int64_t>(data, v.data(), v.size(), offset, length);
+      type   = Snapshot::PAYLOAD_VECTOR_LONG;
+    }
+    else if ( t == typeid(std::vector<double>) )  {
+      const auto& v = c.get<std::vector<double> >();
+      append<double>(data, v.data(), v.size(), offset, length);
+      type   = Snapshot::PAYLOAD_VECTOR_DOUBLE;
+    }
+    else if ( t == typeid(std::string) )  {
+      const auto& v = c.get<std::string>();
+      append<char>(data, v.data(), v.length(), offset, length);
+      type   = Snapshot::PAYLOAD_STRING;
+    }
+    else if ( t == typeid(dd4hep::Delta) )  {
+      const dd4hep::Delta& d = c.get<dd4hep::Delta>();
+      Snapshot::DeltaRecord rec;
+      ::memset(&rec, 0, sizeof(rec));
+      d.translation.GetCoordinates(rec.translation);
+      d.pivot.Vect().GetCoordinates(rec.pivot);
+      rec.rotation[0] = d.rotation.Phi();
+      rec.rotation[1] = d.rotation.Theta();
+      rec.rotation[2] = d.rotation.Psi();
+      rec.flags       = d.flags;
+      append<char>(data, (const char*)&rec, sizeof(rec), offset, length);
+      type   = Snapshot::PAYLOAD_DELTA;
+    }
+    return type;
+  }
+
+  /// Fill a fixed size character field
+  void copy_name(char* target, std::size_t len, const std::string& source)   {
+    ::memset(target, 0, len);
+    ::strncpy(target, source.c_str(), len-1);
+  }
+}
+
+/// Default destructor. Unmaps the file
+ConditionsBinarySnapshot::~ConditionsBinarySnapshot()   {
+  close();
+}
+
+/// Write all non-derived conditions of the manager to a snapshot file. Returns number of items
+std::size_t ConditionsBinarySnapshot::save(ConditionsManager manager, const std::string& output)   {
+  typedef std::tuple<unsigned int, IOV::Key_value_type, IOV::Key_value_type> iov_key_t;
+  std::map<iov_key_t, std::uint32_t> iov_index;
+  std::vector<IOVRecord>             iov_records;
+  std::vector<WriteItem>             items;
+  std::vector<char>                  data;
+  std::size_t                        num_skipped = 0;
+
+  for( const IOVType* type : manager.iovTypesUsed() )  {
+    if ( !type ) continue;
+    ConditionsIOVPool* iov_pool = manager.iovPool(*type);
+    if ( !iov_pool ) continue;
+    for( const auto& cp : iov_pool->elements )  {
+      RangeConditions rc;
+      cp.second->select_all(rc);
+      if ( rc.empty() ) continue;
+
+      iov_key_t  ik(type->type, cp.first.first, cp.first.second);
+      auto       ii = iov_index.find(ik);
+      if ( ii == iov_index.end() )  {
+        IOVRecord rec;
+        copy_name(rec.type_name, sizeof(rec.type_name), type->name);
+        rec.type  = type->type;
+        rec.spare = 0;
+        rec.lower = cp.first.first;
+        rec.upper = cp.first.second;
+        ii = iov_index.emplace(ik, std::uint32_t(iov_records.size())).first;
+        iov_records.emplace_back(rec);
+      }
+      for( Condition c : rc )  {
+        WriteItem item { c.key(), ii->second, 0, 0, 0, 0 };
+        if ( c->testFlag(Condition::DERIVED) || !c.is_bound() )  {
+          ++num_skipped;
+          continue;
+        }
+        item.payload = encode(c, data, item.offset, item.length);
+        if ( item.payload == PAYLOAD_NONE )  {
+          printout(DEBUG,"BinarySnapshot","+++ Skip %016llX: unsupported payload type %s",
+                   c.key(), typeName(c.typeInfo()).c_str());
+          ++num_skipped;
+          continue;
+        }
+        item.flags = c->flags & ~Condition::ACTIVE;
+        items.emplace_back(item);
+      }
+    }
+  }
+  std::stable_sort(items.begin(), items.end(),
+                   [](const WriteItem& a, const WriteItem& b)  {  return a.key < b.key;  });
+
+  Header hdr;
+  ::memset(&hdr, 0, sizeof(hdr));
+  ::memcpy(hdr.magic, s_magic, sizeof(hdr.magic));
+  hdr.version     = VERSION;
+  hdr.endian      = s_endian;
+  hdr.num_iovs    = iov_records.size();
+  hdr.iov_offset  = aligned(sizeof(Header));
+  hdr.num_items   = items.size();
+  hdr.item_offset = aligned(hdr.iov_offset + hdr.num_iovs*sizeof(IOVRecord));
+  hdr.data_offset = aligned(hdr.item_offset + hdr.num_items*sizeof(ItemRecord));
+  hdr.data_size   = data.size();
+  hdr.file_size   = hdr.data_offset + hdr.data_size;
+
+  std::vector<ItemRecord> item_records;
+  item_records.reserve(items.size());
+  for( const auto& i : items )  {
+    ItemRecord rec { i.key, i.iov, i.payload, i.flags, 0, hdr.data_offset + i.offset, i.length };
+    item_records.emplace_back(rec);
+  }
+
+  /// Write to a temporary file and rename: processes mapping the old file are not affected
+  std::string tmp = output + ".tmp";
+  {
+    std::ofstream out(tmp, std::ios::binary|std::ios::trunc);
+    if ( !out.good() )  {
+      except("BinarySnapshot","+++ Failed to open output file %s: %s",
+             tmp.c_str(), std::strerror(errno));
+    }
+    const char pad[8] = { 0,0,0,0,0,0,0,0 };
+    out.write((const char*)&hdr, sizeof(hdr));
+    out.write(pad, hdr.iov_offset - sizeof(hdr));
+    out.write((const char*)iov_records.data(), iov_records.size()*sizeof(IOVRecord));
+    out.write(pad, hdr.item_offset - hdr.iov_offset - iov_records.size()*sizeof(IOVRecord));
+    out.write((const char*)item_records.data(), item_records.size()*sizeof(ItemRecord));
+    out.write(pad, hdr.data_offset - hdr.item_offset - item_records.size()*sizeof(ItemRecord));
+    out.write(data.data(), data.size());
+    if ( !out.good() )  {
+      except("BinarySnapshot","+++ Failed to write output file %s", tmp.c_str());
+    }
+  }
+  if ( 0 != ::rename(tmp.c_str(), output.c_str()) )  {
+    except("BinarySnapshot","+++ Failed to rename %s to %s: %s",
+           tmp.c_str(), output.c_str(), std::strerror(errno));
+  }
+  printout(INFO,"BinarySnapshot","+++ Wrote %ld conditions in %ld IOVs to %s [%ld bytes]. Skipped %ld.",
+           items.size(), iov_records.size(), output.c_str(), hdr.file_size, num_skipped);
+  return items.size();
+}
+
+/// Map snapshot file into memory and validate the header and all item records
+void ConditionsBinarySnapshot::open(const std::string& input)   {
+  struct stat st;
+  close();
+  int fd = ::open(input.c_str(), O_RDONLY);
+  if ( fd < 0 )  {
+    except("BinarySnapshot","+++ Failed to open snapshot %s: %s",
+           input.c_str(), std::strerror(errno));
+  }
+  if ( 0 != ::fstat(fd, &st) || std::size_t(st.st_size) < sizeof(Header) )  {
+    ::close(fd);
+    except("BinarySnapshot","+++ Snapshot %s is not a valid conditions snapshot.", input.c_str());
+  }
+  void* ptr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if ( ptr == MAP_FAILED )  {
+    except("BinarySnapshot","+++ Failed to map snapshot %s: %s",
+           input.c_str(), std::strerror(errno));
+  }
+  m_base = (const char*)ptr;
+  m_size = st.st_size;
+  m_name = input;
+
+  const Header& h = header();
+  const char* err = nullptr;
+  if ( 0 != ::memcmp(h.magic, s_magic, sizeof(s_magic)) )
+    err = "bad magic word";
+  else if ( h.endian != s_endian )
+    err = "incompatible byte order";
+  else if ( h.version != VERSION )
+    err = "unsupported format version";
+  else if ( h.file_size != m_size )
+    err = "truncated file";
+  else if ( h.iov_offset  + h.num_iovs*sizeof(IOVRecord)   > m_size ||
+            h.item_offset + h.num_items*sizeof(ItemRecord) > m_size ||
+            h.data_offset + h.data_size                    > m_size )
+    err = "inconsistent section offsets";
+  else  {
+    /// Validate all item records once: the accessors index the IOV table without checks
+    const ItemRecord* prev = nullptr;
+    for( const ItemRecord* r = begin(); r != end(); prev = r, ++r )  {
+      if ( r->iov >= h.num_iovs || r->offset < h.data_offset ||
+           r->length > h.data_size || r->offset - h.data_offset > h.data_size - r->length ||
+           !valid_length(r->payload, r->length) )  {
+        err = "corrupted item record";
+        break;
+      }
+      else if ( prev && prev->key > r->key )  {
+        err = "unsorted item records";
+        break;
+      }
+    }
+  }
+  if ( err )  {
+    close();
+    except("BinarySnapshot","+++ Snapshot %s: %s.", input.c_str(), err);
+  }
+  ::madvise(ptr, m_size, MADV_RANDOM);
+  printout(DEBUG,"BinarySnapshot","+++ Mapped %s: %ld conditions in %ld IOVs.",
+           input.c_str(), h.num_items, h.num_iovs);
+}
+
+/// Unmap the snapshot file
+void ConditionsBinarySnapshot::close()   {
+  if ( m_base )  {
+    ::munmap((void*)m_base, m_size);
+  }
+  m_base = nullptr;
+  m_size = 0;
+}
+
+/// Access the file header
+const ConditionsBinarySnapshot::Header& ConditionsBinarySnapshot::header()  const  {
+  if ( !m_base )  {
+    except("BinarySnapshot","+++ Snapshot %s is not open.", m_name.c_str());
+  }
+  return *(const Header*)m_base;
+}
+
+/// Access all item records of a given conditions key (one per IOV)
+ConditionsBinarySnapshot::Items ConditionsBinarySnapshot::find(Condition::key_type key)  const  {
+  struct _cmp  {
+    bool operator()(const ItemRecord& r, Condition::key_type k)  const {  return r.key < k;  }
+    bool operator()(Condition::key_type k, const ItemRecord& r)  const {  return k < r.key;  }
+  };
+  if ( m_base )
+    return std::equal_range(begin(), end(), key, _cmp());
+  return Items(nullptr, nullptr);
+}
+
+/// Access the IOV key of an item
+dd4hep::IOV::Key ConditionsBinarySnapshot::iovKey(const ItemRecord& r)  const  {
+  const IOVRecord& i = iov(r);
+  return IOV::Key(i.lower, i.upper);
+}
+
+/// Create a new condition object from an item record. Not registered to any pool.
+dd4hep::Condition ConditionsBinarySnapshot::materialize(const ItemRecord& r)  const  {
+  const Header& h = header();
+  if ( r.iov >= h.num_iovs || r.offset < h.data_offset ||
+       r.offset + r.length > h.data_offset + h.data_size ||
+       !valid_length(r.payload, r.length) )  {
+    except("BinarySnapshot","+++ Snapshot %s: corrupted item %016llX.",
+           m_name.c_str(), (unsigned long long)r.key);
+  }
+  const char* ptr = payload(r);
+  Condition   c(r.key);
+  c->flags = r.flags;
+  switch( r.payload )  {
+  case PAYLOAD_INT:  {
+    std::int32_t v;
+    ::memcpy(&v, ptr, sizeof(v));
+    c.bind<int>() = v;
+    break;
+  }
+  case PAYLOAD_LONG:  {
+    std::int64_t v;
+    ::memcpy(&v, ptr, sizeof(v));
+    c.bind<long>() = long(v);
+    break;
+  }
+  case PAYLOAD_DOUBLE:  {
+    double v;
+    ::memcpy(&v, ptr, sizeof(v));
+    c.bind<double>() = v;
+    break;
+  }
+  case PAYLOAD_VECTOR_INT:
+    extract<std::int32_t>(ptr, r.length, c.bind<std::vector<int> >());
+    break;
+  case PAYLOAD_VECTOR_LONG:
+    extract<std::int64_t>(ptr, r.length, c.bind<std::vector<long> >());
+    break;
+  case PAYLOAD_VECTOR_DOUBLE:
+    extract<double>(ptr, r.length, c.bind<std::vector<double> >());
+    break;
+  case PAYLOAD_STRING:
+    c.bind<std::string>().assign(ptr, r.length);
+    break;
+  case PAYLOAD_DELTA:  {
+    DeltaRecord rec;
+    ::memcpy(&rec, ptr, sizeof(rec));
+    Delta& d = c.bind<Delta>();
+    d.translation.SetCoordinates(rec.translation);
+    d.pivot.SetComponents(rec.pivot[0], rec.pivot[1], rec.pivot[2]);
+    d.rotation.SetComponents(rec.rotation[0], rec.rotation[1], rec.rotation[2]);
+    d.flags = rec.flags;
+    break;
+  }
+  default:
+    except("BinarySnapshot","+++ Snapshot %s: unknown payload type %u for item %016llX.",
+           m_name.c_str(), r.payload, (unsigned long long)r.key);
+  }
+  return c;
+}
@@ -18,9 +18,20 @@
 #include <DD4hep/Printout.h>
 #include <TTimeStamp.h>
 
+#ifdef DD4HEP_USE_TBB
+#include <tbb/task_arena.h>
+#include <tbb/parallel_for.h>
+#endif
+
+// C/C++ include files
+#include <algorithm>
+
 using namespace dd4hep::cond;
 
 namespace {
+  /// Item currently worked on by this thread during the parallel evaluation
+  thread_local ConditionsDependencyHandler::Work* s_parallelWork = nullptr;
+
   std::string dependency_name(const ConditionDependency* d)  {
 #if defined(DD4HEP_CONDITIONS_HAVE_NAME)
     return d->target.name;
@@ -76,6 +87,9 @@ ConditionsDependencyHandler::ConditionsDependencyHandler(ConditionsManager   mgr
     p += sizeof(Work);
   }
   m_iovType = iov.iovType;
+#ifdef DD4HEP_USE_TBB
+  m_numThreads = m_manager->derivedConditionsThreads();
+#endif
 }
 
 /// Default destructor
@@ -90,54 +104,105 @@ dd4hep::Detector& ConditionsDependencyHandler::detectorDescription() const  {
   return m_manager->detectorDescription();
 }
 
-/// 1rst pass: Compute/create the missing conditions
-void ConditionsDependencyHandler::compute()   {
-  m_state = CREATED;
-  for( const auto& i : m_todo )   {
-    if ( !i.second->condition )  {
-      do_callback(i.second);
-      if ( !i.second->condition )  {
-        except("DependencyHandler",
-               "Derived condition was not created after calling the creation callback!");
+/// Access the item currently worked on (thread local in parallel mode)
+ConditionsDependencyHandler::Work*& ConditionsDependencyHandler::currentWork()   {
+  return m_numThreads > 0 ? s_parallelWork : m_currentWork;
+}
+
+/// Order the work items into levels of independent items. False for circular dependencies
+bool ConditionsDependencyHandler::build_levels(std::vector<std::vector<Work*> >& levels)  const   {
+  enum { UNSEEN = -2, ACTIVE = -1 };
+  std::vector<int> level(m_todo.size(), UNSEEN);
+  std::vector<std::pair<Work*,std::size_t> > stack;
+  auto index = [this](const Work* w)  {  return std::size_t(w - m_block);  };
+
+  /// Depth first traversal without recursion: dependency chains may be long
+  for( const auto& t : m_todo )   {
+    if ( level[index(t.second)] != UNSEEN ) continue;
+    level[index(t.second)] = ACTIVE;
+    stack.emplace_back(t.second, 0);
+    while( !stack.empty() )   {
+      Work* w = stack.back().first;
+      const auto& deps = w->context.dependency->dependencies;
+      if ( stack.back().second < deps.size() )   {
+        auto i = m_todo.find(deps[stack.back().second++].hash);
+        if ( i != m_todo.end() )   {
+          int& lvl = level[index(i->second)];
+          if ( lvl == ACTIVE ) return false;
+          if ( lvl == UNSEEN )   {
+            lvl = ACTIVE;
+            stack.emplace_back(i->second, 0);
+          }
+        }
+        continue;
       }
+      int lvl = 0;
+      for( const auto& d : deps )   {
+        auto i = m_todo.find(d.hash);
+        if ( i != m_todo.end() ) lvl = std::max(lvl, level[index(i->second)]+1);
+      }
+      level[index(w)] = lvl;
+      stack.pop_back();
     }
-    // printout(INFO,"UserPool","Already calcluated: %s",d->name());
   }
+  for( const auto& t : m_todo )   {
+    std::size_t lvl = level[index(t.second)];
+    if ( levels.size() <= lvl ) levels.resize(lvl+1);
+    levels[lvl].emplace_back(t.second);
+  }
+  return true;
 }
 
-/// 2nd pass:  Handler callback for the second turn to resolve missing dependencies
-void ConditionsDependencyHandler::resolve()    {
+/// Parallel evaluation: compute, resolve and register level by level
+void ConditionsDependencyHandler::compute_parallel(const std::vector<std::vector<Work*> >& levels)   {
+#ifdef DD4HEP_USE_TBB
+  tbb::task_arena arena(m_numThreads);
+  for( const auto& items : levels )   {
+    /// All dependencies of this level are already resolved and registered
+    m_state = CREATED;
+    arena.execute([this, &items]()   {
+      tbb::parallel_for(std::size_t(0), items.size(), [this, &items](std::size_t i)  {
+        Work* w = items[i];
+        s_parallelWork = nullptr;
+        if ( !w->condition ) do_callback(w);
+        if ( !w->condition )  {
+          except("DependencyHandler",
+                 "Derived condition was not created after calling the creation callback!");
+        }
+      });
+    });
+    m_state = RESOLVED;
+    arena.execute([this, &items]()   {
+      tbb::parallel_for(std::size_t(0), items.size(), [this, &items](std::size_t i)  {
+        Work* w = items[i];
+        s_parallelWork = w;
+        if ( w->state != RESOLVED ) w->resolve(s_parallelWork);
+        s_parallelWork = nullptr;
+      });
+    });
+    register_work(items);
+  }
+  m_registered = true;
+#else
+  (void)levels;
+#endif
+}
+
+/// Block register resolved work items grouped by their IOV
+void ConditionsDependencyHandler::register_work(const std::vector<Work*>& work)   {
   PrintLevel prt_lvl = INFO;
   std::vector<Condition> tmp;
   std::map<IOV::Key,std::vector<Condition> > work_pools;
-  Work* w;
 
-  m_state = RESOLVED;
-  for( const auto& c : m_todo )   {
-    w = c.second;
-    m_currentWork = w;
-    if ( w->state != RESOLVED )   {
-      w->resolve(m_currentWork);
-    }
+  // Optimize pool interactions: Cache pool in map assuming there are only few pools created
+  for( Work* w : work )   {
     // Fill an empty map of condition vectors for the block inserts
     auto ret = work_pools.emplace(w->iov->keyData,tmp);
     if ( ret.second )   {
       // There is sort of the hope that most conditions go into 1 pool...
-      ret.first->second.reserve(m_todo.size());
+      ret.first->second.reserve(work.size());
     }
-  }
-  // Optimize pool interactions: Cache pool in map assuming there are only few pools created
-  for( const auto& c : m_todo )   {
-    w = c.second;
-    auto& section = work_pools[w->iov->keyData];
-    section.emplace_back(w->condition);
-#if 0
-    printout(prt_lvl,"DependencyHandler","++ Register %s %s %s  [%s]",
-             w->context.dependency->target.toString().c_str(),
-             w->context.dependency->detector.path().c_str(),
-             w->condition->iov->str().c_str(),
-             typeName(typeid(*w->condition)).c_str());
-#endif
+    ret.first->second.emplace_back(w->condition);
   }
   // Now block register all conditions to the manager AND to the user pool
   // In principle at thi stage the conditions manager should be locked
@@ -156,14 +221,65 @@ void ConditionsDependencyHandler::resolve()    {
   }
 }
 
+/// 1rst pass: Compute/create the missing conditions
+void ConditionsDependencyHandler::compute()   {
+  if ( m_numThreads > 0 )   {
+    std::vector<std::vector<Work*> > levels;
+    if ( build_levels(levels) )   {
+      printout(DEBUG,"DependencyHandler","Compute %ld derived conditions in %ld levels with %d threads.",
+               m_todo.size(), levels.size(), m_numThreads);
+      compute_parallel(levels);
+      return;
+    }
+    printout(INFO,"DependencyHandler",
+             "Circular dependencies between derived conditions: Use serial evaluation.");
+    m_numThreads = 0;
+  }
+  m_state = CREATED;
+  for( const auto& i : m_todo )   {
+    if ( !i.second->condition )  {
+      do_callback(i.second);
+      if ( !i.second->condition )  {
+        except("DependencyHandler",
+               "Derived condition was not created after calling the creation callback!");
+      }
+    }
+    // printout(INFO,"UserPool","Already calcluated: %s",d->name());
+  }
+}
+
+/// 2nd pass:  Handler callback for the second turn to resolve missing dependencies
+void ConditionsDependencyHandler::resolve()    {
+  std::vector<Work*> work;
+  Work* w;
+
+  /// Parallel mode: all conditions are already resolved and registered level by level
+  if ( m_registered )   {
+    return;
+  }
+  m_state = RESOLVED;
+  work.reserve(m_todo.size());
+  for( const auto& c : m_todo )   {
+    w = c.second;
+    m_currentWork = w;
+    if ( w->state != RESOLVED )   {
+      w->resolve(m_currentWork);
+    }
+    work.emplace_back(w);
+  }
+  register_work(work);
+}
+
 /// Interface to handle multi-condition inserts by callbacks: One single insert
 bool ConditionsDependencyHandler::registerOne(const IOV& iov, Condition cond)    {
+  std::lock_guard<std::shared_mutex> lock(m_lock);
   return m_pool.registerOne(iov, cond);
 }
 
 /// Handle multi-condition inserts by callbacks: block insertions of conditions with identical IOV
 std::size_t
 ConditionsDependencyHandler::registerMany(const IOV& iov, const std::vector<Condition>& values)   {
+  std::lock_guard<std::shared_mutex> lock(m_lock);
   return m_pool.registerMany(iov, values);
 }
 
@@ -187,9 +303,11 @@ ConditionsDependencyHandler::getByItem(Condition::itemkey_type key)   {
         return 1;
       }
     };
-    item_selector proc(key);
-    m_pool.scan(conditionsProcessor(proc));
-    for (auto c : proc.conditions ) m_currentWork->do_intersection(c->iov);
+    item_selector proc(key);  {
+      std::shared_lock<std::shared_mutex> lock(m_lock);
+      m_pool.scan(conditionsProcessor(proc));
+    }
+    for (auto c : proc.conditions ) currentWork()->do_intersection(c->iov);
     return proc.conditions;
   }
   except("DependencyHandler",
@@ -203,8 +321,11 @@ ConditionsDependencyHandler::get(Condition::detkey_type det_key)   {
   if ( m_state == RESOLVED )   {
     ConditionKey::KeyMaker lower(det_key, Condition::FIRST_ITEM_KEY);
     ConditionKey::KeyMaker upper(det_key, Condition::LAST_ITEM_KEY);
-    std::vector<Condition> conditions = m_pool.get(lower.hash, upper.hash);
-    for (auto c : conditions ) m_currentWork->do_intersection(c->iov);
+    std::vector<Condition> conditions;  {
+      std::shared_lock<std::shared_mutex> lock(m_lock);
+      conditions = m_pool.get(lower.hash, upper.hash);
+    }
+    for (auto c : conditions ) currentWork()->do_intersection(c->iov);
     return conditions;
   }
   except("DependencyHandler",
@@ -225,9 +346,13 @@ ConditionsDependencyHandler::get(Condition::key_type key,
                                  bool throw_if_not)
 {
   /// If we are not already resolving here, we follow the normal procedure
-  Condition c = m_pool.get(key);
+  Work*& current = currentWork();
+  Condition c;  {
+    std::shared_lock<std::shared_mutex> lock(m_lock);
+    c = m_pool.get(key);
+  }
   if ( c.isValid() )  {
-    m_currentWork->do_intersection(c->iov);
+    if ( current ) current->do_intersection(c->iov);
     return c;
   }
   auto i = m_todo.find(key);
@@ -237,14 +362,14 @@ ConditionsDependencyHandler::get(Condition::key_type key,
       return w->condition;
     }
     else if ( w->state == CREATED )   {
-      return w->resolve(m_currentWork);
+      return w->resolve(current);
     }
     else if ( w->state == INVALID )  {
       do_callback(w);
       if ( w->condition && w->state == RESOLVED ) // cross-dependencies...
         return w->condition;
       else if ( w->condition )
-        return w->resolve(m_currentWork);
+        return w->resolve(current);
     }
   }
   if ( throw_if_not )  {
@@ -291,8 +416,9 @@ ConditionsDependencyHandler::get(Condition::key_type key,
 void ConditionsDependencyHandler::do_callback(Work* work)   {
   const ConditionDependency* dep = work->context.dependency;
   try  {
-    Work* previous  = m_currentWork;
-    m_currentWork   = work;
+    Work*& current  = currentWork();
+    Work* previous  = current;
+    current         = work;
     if ( work->callstack > 0 )   {
       // if we end up here it means a previous construction call never finished
       // because the bugger tried to access another condition, which in turn
@@ -311,7 +437,7 @@ void ConditionsDependencyHandler::do_callback(Work* work)   {
     ++work->callstack;
     work->condition = (*dep->callback)(dep->target, work->context).ptr();
     --work->callstack;
-    m_currentWork   = previous;
+    current         = previous;
     if ( work->condition )  {
       if ( !work->iov )  {
         work->_iov = IOV(m_iovType,IOV::Key(IOV::MIN_KEY, IOV::MAX_KEY));
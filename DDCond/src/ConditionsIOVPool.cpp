@@ -149,6 +149,21 @@ size_t ConditionsIOVPool::select(const IOV&              req_validity,
   return num_selected;
 }
 
+/// Reset the age of the pools matching the IOV requirement. All other pools age.
+size_t ConditionsIOVPool::touch(const IOV& req_validity)   {
+  size_t num_selected = 0;
+  const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
+  for( const auto& i : elements )  {
+    if ( !IOV::key_contains_range(i.first, req_key) )  {
+      ++i.second->age_value;
+      continue;
+    }
+    i.second->age_value = 0;
+    ++num_selected;
+  }
+  return num_selected;
+}
+
 /// Select all ACTIVE conditions, which do match the IOV requirement
 size_t ConditionsIOVPool::select(const IOV& req_validity, 
                                  Elements&  valid,
@@ -48,6 +48,8 @@ ConditionsSlice::~ConditionsSlice()   {
 
 /// Set flag to not reference the used pools during prepare (and drop possibly pending)
 void ConditionsSlice::derefPools()     {
+  /// Incremental slices keep conditions of the referenced pools: drop them first
+  if ( (this->flags&INCREMENTAL) && pool.get() ) pool->clear();
   used_pools.clear(); // Drop all refs possibly pending
   this->flags &= ~REF_POOLS;
 }
@@ -34,6 +34,10 @@
 #include <DDCond/ConditionsIOVPool.h>
 #include <DDCond/ConditionsDataLoader.h>
 
+// C/C++ include files
+#include <algorithm>
+#include <thread>
+
 using namespace dd4hep::cond;
 
 typedef UpdatePool::UpdateEntries Updates;
@@ -54,6 +58,26 @@ namespace {
 
   int s_debug = dd4hep::INFO;
 
+  /// Helper: Register a lock-free reader of the pool snapshot for the lifetime of the object
+  /**
+   *  The reader announces itself in the current epoch. If the epoch changed
+   *  in the meantime (a new snapshot was published) the announcement is retried.
+   */
+  class SnapshotReader  {
+    std::atomic<long>* readers = nullptr;
+  public:
+    SnapshotReader(std::atomic<unsigned long>& epoch, std::atomic<long>* rdrs)  {
+      for(;;)   {
+        unsigned long e = epoch.load();
+        readers = &rdrs[e&1];
+        ++(*readers);
+        if ( epoch.load() == e ) return;
+        --(*readers);
+      }
+    }
+    ~SnapshotReader()  {  --(*readers);  }
+  };
+
   /// Helper: IOV Check function declaration
   template <typename T> const dd4hep::IOVType* check_iov_type(const Manager_Type1* o, const dd4hep::IOV* iov);
 
@@ -138,6 +162,8 @@ Manager_Type1::Manager_Type1(Detector& description_instance)
     m_updateLock(), m_poolLock(), m_updatePool(), m_rawPool(), m_locked(0)
 {
   InstanceCount::increment(this);
+  m_readers[0] = 0;
+  m_readers[1] = 0;
   declareProperty("MaxIOVTypes",         m_maxIOVTypes=32);
   declareProperty("PoolType",            m_poolType   = "");
   declareProperty("UpdatePoolType",      m_updateType = "DD4hep_ConditionsLinearUpdatePool");
@@ -149,6 +175,7 @@ Manager_Type1::Manager_Type1(Detector& description_instance)
 
 /// Default destructor
 Manager_Type1::~Manager_Type1()   {
+  delete m_snapshot.exchange(nullptr);
   for_each(m_rawPool.begin(), m_rawPool.end(), detail::DestroyObject<ConditionsIOVPool*>());
   InstanceCount::decrement(this);
 }
@@ -212,11 +239,42 @@ const dd4hep::IOVType* Manager_Type1::iovType (const std::string& iov_name) cons
   return 0;
 }
 
+/// Publish a new snapshot of the IOV pools and delete the previous one after the grace period
+void Manager_Type1::publish_snapshot()   {
+  dd4hep_lock_t lock(m_poolLock);
+  PoolSnapshot* snap = new PoolSnapshot();
+  snap->pools.resize(m_rawPool.size());
+  for( std::size_t i = 0; i < m_rawPool.size(); ++i )   {
+    if ( m_rawPool[i] )
+      snap->pools[i].assign(m_rawPool[i]->elements.begin(), m_rawPool[i]->elements.end());
+  }
+  PoolSnapshot* old = m_snapshot.exchange(snap);
+  if ( old )   {
+    /// Readers entering from now on see the new snapshot. Wait for those of the last epoch
+    unsigned long e = m_epoch.fetch_add(1);
+    while( m_readers[e&1].load() != 0 )
+      std::this_thread::yield();
+    delete old;
+  }
+}
+
 /// Register IOV with type and key
 ConditionsPool* Manager_Type1::registerIOV(const IOVType& typ, IOV::Key key)   {
+  {
+    // Fast path: the pool already exists. Lookup without lock
+    SnapshotReader reader(m_epoch, m_readers);
+    const PoolSnapshot* snap = m_snapshot.load();
+    if ( snap && typ.type < snap->pools.size() )   {
+      const auto& pools = snap->pools[typ.type];
+      auto i = std::lower_bound(pools.begin(), pools.end(), key,
+                                [](const PoolSnapshot::Element& e, const IOV::Key& k) { return e.first < k; });
+      if ( i != pools.end() && i->first == key )
+        return i->second.get();
+    }
+  }
   // IOV read and checked. Now register it, but always locked!
-  ConditionsIOVPool* pool = m_rawPool[typ.type];
   dd4hep_lock_t      lock(m_poolLock);
+  ConditionsIOVPool* pool = m_rawPool[typ.type];
   if ( !pool )  {
     m_rawPool[typ.type] = pool = new ConditionsIOVPool(&typ);
   }
@@ -230,6 +288,7 @@ ConditionsPool* Manager_Type1::registerIOV(const IOVType& typ, IOV::Key key)   {
   const void* argv_pool[] = {this, iov, 0};
   std::shared_ptr<ConditionsPool> cond_pool(createPlugin<ConditionsPool>(m_poolType,m_detDesc,2,argv_pool));
   pool->elements.emplace(key,cond_pool);
+  publish_snapshot();
   printout(INFO,"ConditionsMgr","Created IOV Pool for:%s",iov->str().c_str());
   return cond_pool.get();
 }
@@ -350,7 +409,9 @@ int Manager_Type1::clean(const IOVType* typ, int max_age)   {
   dd4hep_lock_t lock(m_updateLock);
   ConditionsIOVPool* pool = m_rawPool[typ->type];
   if ( pool )  {
+    dd4hep_lock_t pool_lock(m_poolLock);
     count += pool->clean(max_age);
+    publish_snapshot();
   }
   return count;
 }
@@ -358,6 +419,7 @@ int Manager_Type1::clean(const IOVType* typ, int max_age)   {
 /// Invoke cache cleanup with user defined policy
 std::pair<int,int> Manager_Type1::clean(const ConditionsCleanup& cleaner)   {
   std::pair<int,int> count(0,0);
+  dd4hep_lock_t lock(m_poolLock);
   for( TypedConditionPool::iterator i=m_rawPool.begin(); i != m_rawPool.end(); ++i)  {
     ConditionsIOVPool* p = *i;
     if ( p && cleaner(*p) )  {
@@ -365,12 +427,14 @@ std::pair<int,int> Manager_Type1::clean(const ConditionsCleanup& cleaner)   {
       count.second += p->clean(cleaner);
     }
   }
+  if ( count.first > 0 ) publish_snapshot();
   return count;
 }
 
 /// Full cleanup of all managed conditions.
 std::pair<int,int> Manager_Type1::clear()   {
   std::pair<int,int> count(0,0);
+  dd4hep_lock_t lock(m_poolLock);
   for( TypedConditionPool::iterator i=m_rawPool.begin(); i != m_rawPool.end(); ++i)  {
     ConditionsIOVPool* p = *i;
     if ( p )  {
@@ -378,6 +442,7 @@ std::pair<int,int> Manager_Type1::clear()   {
       count.second += p->clean(0);
     }
   }
+  publish_snapshot();
   return count;
 }
 
@@ -409,15 +474,19 @@ bool Manager_Type1::select(Condition::key_type key,
                            const IOV& req_validity,
                            RangeConditions& conditions)   {
   {
-    ConditionsIOVPool* p = 0;
-    dd4hep_lock_t locked_action(m_poolLock);
-    p = m_rawPool[req_validity.type]; // Existence already checked by caller!
-    p->select(key, req_validity, conditions);
-  }
-  {
-    dd4hep_lock_t locked_action(m_updateLock);
-    m_updatePool->select_range(key, req_validity, conditions);
+    SnapshotReader reader(m_epoch, m_readers);
+    const PoolSnapshot* snap = m_snapshot.load();
+    if ( snap && req_validity.type < snap->pools.size() )  {
+      const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
+      for( const auto& e : snap->pools[req_validity.type] )  {
+        if ( IOV::key_contains_range(e.first, req_key) )  {
+          e.second->select(key, conditions);
+        }
+      }
+    }
   }
+  dd4hep_lock_t locked_action(m_updateLock);
+  m_updatePool->select_range(key, req_validity, conditions);
   return !conditions.empty();
 }
 
@@ -427,15 +496,21 @@ bool Manager_Type1::select_range(Condition::key_type key,
                                  RangeConditions& conditions)
 {
   {
-    ConditionsIOVPool* p = 0;
-    dd4hep_lock_t locked_action(m_poolLock);
-    p = m_rawPool[req_validity.type]; // Existence alread checked by caller!
-    p->selectRange(key, req_validity, conditions);
-  }
-  {
-    dd4hep_lock_t locked_action(m_updateLock);
-    m_updatePool->select_range(key, req_validity, conditions);
+    SnapshotReader reader(m_epoch, m_readers);
+    const PoolSnapshot* snap = m_snapshot.load();
+    if ( snap && req_validity.type < snap->pools.size() )  {
+      const IOV::Key range = req_validity.key();
+      for( const auto& e : snap->pools[req_validity.type] )  {
+        const IOV::Key& k = e.first;
+        if ( IOV::key_is_contained(k,range) ||         // IOV test contained in key. Take it!
+             IOV::key_overlaps_lower_end(k,range) ||   // IOV overlap on test on the lower end of key
+             IOV::key_overlaps_higher_end(k,range) )   // IOV overlap of test on the higher end of key
+          e.second->select(key, conditions);
+      }
+    }
   }
+  dd4hep_lock_t locked_action(m_updateLock);
+  m_updatePool->select_range(key, req_validity, conditions);
   return is_range_complete(req_validity,conditions);
 }
 #if 0
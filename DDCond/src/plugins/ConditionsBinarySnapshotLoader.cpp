@@ -0,0 +1,156 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : agent
+//
+//==========================================================================
+#ifndef DD4HEP_CONDITIONS_CONDITIONSBINARYSNAPSHOTLOADER_H
+#define DD4HEP_CONDITIONS_CONDITIONSBINARYSNAPSHOTLOADER_H
+
+// Framework include files
+#include <DDCond/ConditionsDataLoader.h>
+#include <DDCond/ConditionsBinarySnapshot.h>
+
+// C/C++ include files
+#include <memory>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for implementation details of the AIDA detector description toolkit
+  namespace cond  {
+
+    /// Conditions loader reading memory mapped binary snapshots
+    /**
+     *  All sources added to the loader are mapped read-only on first use.
+     *  Conditions are only materialized when requested by a slice:
+     *  for every required key the first snapshot providing an IOV of the
+     *  requested type, which contains the requested interval, is used.
+     *
+     *  \author   agent
+     *  \version  1.0
+     *  \ingroup  DD4HEP_CONDITIONS
+     */
+    class ConditionsBinarySnapshotLoader : public ConditionsDataLoader   {
+      typedef std::vector<std::unique_ptr<ConditionsBinarySnapshot> > Snapshots;
+      /// Mapped snapshot files
+      Snapshots m_snapshots;
+      /// Map all pending sources
+      void map_sources();
+
+    public:
+      /// Default constructor
+      ConditionsBinarySnapshotLoader(Detector& description, ConditionsManager mgr, const std::string& nam);
+      /// Default destructor
+      virtual ~ConditionsBinarySnapshotLoader();
+      /// Load a number of conditions items from the snapshots according to the required IOV
+      virtual size_t load_many(  const IOV&       req_validity,
+                                 RequiredItems&   work,
+                                 LoadedItems&     loaded,
+                                 IOV&             combined_validity)  override;
+    };
+  }    /* End namespace cond                             */
+}      /* End namespace dd4hep                           */
+#endif /* DD4HEP_CONDITIONS_CONDITIONSBINARYSNAPSHOTLOADER_H  */
+
+//#include <ConditionsBinarySnapshotLoader.h>
+#include <DD4hep/Printout.h>
+#include <DD4hep/Factories.h>
+#include <DD4hep/detail/ConditionsInterna.h>
+
+// C/C++ include files
+#include <map>
+
+// Forward declarations
+using namespace dd4hep::cond;
+
+namespace {
+  void* create_loader(dd4hep::Detector& description, int argc, char** argv)   {
+    const char* name = argc>0 ? argv[0] : "MMapLoader";
+    ConditionsManagerObject* mgr = (ConditionsManagerObject*)(argc>0 ? argv[1] : 0);
+    return new ConditionsBinarySnapshotLoader(description,ConditionsManager(mgr),name);
+  }
+}
+DECLARE_DD4HEP_CONSTRUCTOR(DD4hep_Conditions_mmap_Loader,create_loader)
+
+/// Standard constructor, initializes variables
+ConditionsBinarySnapshotLoader::ConditionsBinarySnapshotLoader(Detector& description, ConditionsManager mgr, const std::string& nam)
+: ConditionsDataLoader(description, mgr, nam)
+{
+}
+
+/// Default Destructor
+ConditionsBinarySnapshotLoader::~ConditionsBinarySnapshotLoader() {
+  m_snapshots.clear();
+}
+
+/// Map all pending sources
+void ConditionsBinarySnapshotLoader::map_sources()   {
+  for( const auto& src : m_sources )  {
+    std::string nam = src.first;
+    std::size_t idx = nam.find("mmap:");
+    if ( idx == 0 ) nam = nam.substr(5);
+    std::unique_ptr<ConditionsBinarySnapshot> snap(new ConditionsBinarySnapshot());
+    snap->open(nam);
+    printout(INFO,"BinarySnapshot","+++ Mapped conditions snapshot %s [%ld items]",
+             nam.c_str(), long(snap->header().num_items));
+    m_snapshots.emplace_back(std::move(snap));
+  }
+  m_sources.clear();
+}
+
+/// Load a number of conditions items from the snapshots according to the required IOV
+size_t ConditionsBinarySnapshotLoader::load_many(const IOV&      req_validity,
+                                                 RequiredItems&  work,
+                                                 LoadedItems&    loaded,
+                                                 IOV&            combined_validity)
+{
+  typedef std::map<IOV::Key, std::vector<Condition> > Blocks;
+  const IOVType* typ = req_validity.iovType;
+  std::size_t    len = loaded.size();
+  Blocks         blocks;
+
+  if ( !m_sources.empty() )  {
+    map_sources();
+  }
+  if ( !typ )  {
+    except("BinarySnapshot","+++ load_many: Invalid IOV type of the requested validity.");
+  }
+  for( const auto& w : work )  {
+    Condition::key_type key = w.first;
+    if ( loaded.find(key) != loaded.end() ) continue;
+    for( const auto& snap : m_snapshots )  {
+      const ConditionsBinarySnapshot::ItemRecord* found = nullptr;
+      auto items = snap->find(key);
+      for( auto* r = items.first; r != items.second; ++r )  {
+        const ConditionsBinarySnapshot::IOVRecord& iov = snap->iov(*r);
+        if ( iov.type == typ->type &&
+             IOV::key_contains_range(snap->iovKey(*r), req_validity.keyData) )  {
+          found = r;
+          break;
+        }
+      }
+      if ( found )  {
+        IOV::Key  k = snap->iovKey(*found);
+        Condition c = snap->materialize(*found);
+        blocks[k].emplace_back(c);
+        loaded.emplace(key, c);
+        combined_validity.iov_intersection(k);
+        break;
+      }
+    }
+  }
+  for( const auto& b : blocks )  {
+    ConditionsPool* pool = m_mgr.registerIOV(*typ, b.first);
+    m_mgr.blockRegister(*pool, b.second);
+  }
+  printout(DEBUG,"BinarySnapshot","+++ Loaded %ld out of %ld conditions for IOV %s",
+           long(loaded.size()-len), long(work.size()), req_validity.str().c_str());
+  return loaded.size()-len;
+}
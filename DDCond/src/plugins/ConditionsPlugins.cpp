@@ -30,6 +30,7 @@
 #include <DDCond/ConditionsManager.h>
 #include <DDCond/ConditionsIOVPool.h>
 #include <DDCond/ConditionsRepository.h>
+#include <DDCond/ConditionsBinarySnapshot.h>
 #include <DDCond/ConditionsManagerObject.h>
 
 // C/C++ include files
@@ -551,3 +552,79 @@ static long ddcond_load_repository(Detector& /* description */, int argc, char**
 }
 DECLARE_APPLY(DD4hep_ConditionsLoadRepository,ddcond_load_repository)
 // ======================================================================================
+
+/// Plugin entry point: Write all loaded non-derived conditions to a memory mappable binary snapshot
+/**
+ *  Factory: DD4hep_ConditionsSaveBinarySnapshot
+ *
+ *  The snapshot may be read with the conditions loader of type "mmap".
+ *
+ *  \author  agent
+ *  \version 1.0
+ */
+static long ddcond_save_binary_snapshot(Detector& description, int argc, char** argv) {
+  bool arg_error = false;
+  std::string output = "";
+  for(int i=0; i<argc && argv[i]; ++i)  {      
+    if ( 0 == ::strncmp("-output",argv[i],4) )
+      output = argv[++i];
+    else
+      arg_error = true;
+  }
+  if ( arg_error || output.empty() )  {
+    /// Help printout describing the basic command line interface
+    std::cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_ConditionsSaveBinarySnapshot           \n\n"
+      "     -output <string>         Output file name.                             \n\n"
+      "\tArguments given: " << arguments(argc,argv) << std::endl << std::flush;
+    ::exit(EINVAL);
+  }
+  printout(INFO,"Conditions","+++ ConditionsBinarySnapshot: Creating %s",output.c_str());
+  ConditionsManager manager = ConditionsManager::from(description);
+  ConditionsBinarySnapshot::save(manager,output);
+  return 1;
+}
+DECLARE_APPLY(DD4hep_ConditionsSaveBinarySnapshot,ddcond_save_binary_snapshot)
+
+// ======================================================================================
+/// Plugin entry point: Dump the content of a binary conditions snapshot
+/**
+ *  Factory: DD4hep_ConditionsDumpBinarySnapshot
+ *
+ *  \author  agent
+ *  \version 1.0
+ */
+static long ddcond_dump_binary_snapshot(Detector& /* description */, int argc, char** argv)   {
+  bool arg_error = false;
+  std::string input = "";
+  for(int i=0; i<argc && argv[i]; ++i)  {      
+    if ( 0 == ::strncmp("-input",argv[i],4) )
+      input = argv[++i];
+    else
+      arg_error = true;
+  }
+  if ( arg_error || input.empty() )  {
+    /// Help printout describing the basic command line interface
+    std::cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_ConditionsDumpBinarySnapshot           \n\n"
+      "     -input <string>          Input file name.                              \n\n"
+      "\tArguments given: " << arguments(argc,argv) << std::endl << std::flush;
+    ::exit(EINVAL);
+  }
+  ConditionsBinarySnapshot snap;
+  snap.open(input);
+  const auto& hdr = snap.header();
+  printout(INFO,"Snapshot","+++ %s: version %u  %ld IOVs  %ld items  %ld bytes payload",
+           input.c_str(), hdr.version, long(hdr.num_iovs), long(hdr.num_items), long(hdr.data_size));
+  for( const auto* r = snap.begin(); r != snap.end(); ++r )  {
+    const auto& iov = snap.iov(*r);
+    printout(INFO,"Snapshot","%016llX  %-8s [%ld,%ld]  payload:%u  length:%ld",
+             (unsigned long long)r->key, iov.type_name, long(iov.lower), long(iov.upper),
+             r->payload, long(r->length));
+  }
+  return 1;
+}
+DECLARE_APPLY(DD4hep_ConditionsDumpBinarySnapshot,ddcond_dump_binary_snapshot)
+// ======================================================================================
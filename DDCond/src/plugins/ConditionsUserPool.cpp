@@ -58,6 +58,9 @@ namespace dd4hep {
       /// Internal insertion helper
       bool i_insert(Condition::Object* o);
 
+      /// Incremental update: drop expired conditions and their dependents, keep the rest
+      size_t i_updateIncremental(const IOV& required, const ConditionsSlice& slice, IOV& pool_iov);
+
     public:
       /// Default constructor
       ConditionsMappedUserPool(ConditionsManager mgr, ConditionsIOVPool* pool);
@@ -439,6 +442,64 @@ bool ConditionsMappedUserPool<MAPPING>::remove(Condition::key_type hash_key)
   return false;
 }
 
+/// Incremental update: drop expired conditions and their dependents, keep the rest
+template<typename MAPPING>
+std::size_t ConditionsMappedUserPool<MAPPING>::i_updateIncremental(const IOV&             required,
+                                                                   const ConditionsSlice& slice,
+                                                                   IOV&                   pool_iov)
+{
+  const IOV::Key req_key = required.key(); // 16 bytes => better copy!
+  std::vector<Condition::key_type> changed;
+  for( auto j = m_conditions.begin(); j != m_conditions.end(); )   {
+    Condition::Object* c = (*j).second;
+    if ( c->iov && IOV::key_contains_range(c->iov->keyData, req_key) )  {
+      ++j;
+      continue;
+    }
+    changed.emplace_back((*j).first);
+    j = m_conditions.erase(j);
+  }
+  // Derived conditions downstream of changed conditions must be recomputed
+  if ( !changed.empty() )   {
+    std::multimap<Condition::key_type, Condition::key_type> users;
+    for( const auto& d : slice.derived() )   {
+      for( const auto& k : d.second->dependencies )
+        users.emplace(k.hash, d.first);
+    }
+    for( std::size_t i = 0; i < changed.size(); ++i )   {
+      auto range = users.equal_range(changed[i]);
+      for( auto u = range.first; u != range.second; ++u )   {
+        auto j = m_conditions.find(u->second);
+        if ( j != m_conditions.end() )   {
+          m_conditions.erase(j);
+          changed.emplace_back(u->second);
+        }
+      }
+    }
+  }
+  std::size_t num_reused = m_conditions.size();
+  for( const auto& e : m_conditions )
+    pool_iov.iov_intersection(e.second->iov->key());
+  // Like the full selection: the pools of the reused conditions must not age.
+  // Otherwise a cleanup would delete conditions still held by this pool.
+  m_iovPool->touch(required);
+  // Re-select changed conditions from the IOV pools. The others get loaded or computed
+  RangeConditions valid;
+  for( Condition::key_type key : changed )   {
+    valid.clear();
+    m_iovPool->select(key, required, valid);
+    if ( !valid.empty() )   {
+      Condition::Object* c = valid.front().ptr();
+      m_conditions.emplace(key, c);
+      pool_iov.iov_intersection(c->iov->key());
+    }
+  }
+  printout((flags&PRINT_LOAD) ? INFO : DEBUG,"UserPool",
+           "Incremental update: %ld conditions reused, %ld changed, %ld re-selected.",
+           num_reused, changed.size(), m_conditions.size()-num_reused);
+  return num_reused;
+}
+
 /// Evaluate and register all derived conditions from the dependency list
 template<typename MAPPING>
 std::size_t ConditionsMappedUserPool<MAPPING>::compute(const Dependencies& deps,
@@ -521,11 +582,17 @@ ConditionsMappedUserPool<MAPPING>::prepare(const IOV&                  required,
   static std::mutex lock;
   std::lock_guard<std::mutex> guard(lock);
 
-  m_conditions.clear();
   slice_miss_cond.clear();
   slice_miss_calc.clear();
   pool_iov.reset().invert();
-  m_iovPool->select(required, Operators::mapConditionsSelect(m_conditions), pool_iov);
+  if ( (slice.flags&ConditionsSlice::INCREMENTAL) && !m_conditions.empty() &&
+       m_iov.iovType == required.iovType )   {
+    result.reused = i_updateIncremental(required, slice, pool_iov);
+  }
+  else   {
+    m_conditions.clear();
+    m_iovPool->select(required, Operators::mapConditionsSelect(m_conditions), pool_iov);
+  }
   m_iov = pool_iov;
   CondMissing cond_missing(slice_cond.size()+m_conditions.size());
   CalcMissing calc_missing(slice_calc.size()+m_conditions.size());
@@ -621,7 +688,9 @@ ConditionsMappedUserPool<MAPPING>::prepare(const IOV&                  required,
   }
   slice.status = result;
   slice.used_pools.clear();
-  if ( slice.flags&ConditionsSlice::REF_POOLS )   {
+  // Incremental slices keep the conditions between preparations: the pools
+  // must stay alive even if a cleanup removes them from the IOV pool.
+  if ( slice.flags&(ConditionsSlice::REF_POOLS|ConditionsSlice::INCREMENTAL) )   {
     m_iovPool->select(required, slice.used_pools);
   }
   return result;
@@ -27,12 +27,25 @@ class DD4hepRootPersistency : public TNamed  {
 public:
   typedef std::map<std::string, dd4hep::Handle<dd4hep::NamedObject> >  HandleMap;
 
+  /// Persistent layout of the detector description
+  /** Both layouts store the detector description as one object graph:
+   *  DetElements, volumes and readouts of all subdetectors are always read.
+   */
+  enum Layout  {
+    /// Complete detector description including the volume manager
+    FULL = 0,
+    /// The volume manager is not saved. Its subdetector sections are populated on first access
+    VOLMGR_ON_DEMAND = 1
+  };
+
   /// The main data block
   dd4hep::DetectorData*     m_data = 0;
   /// Helper since plain segmentations cannot be saved
   std::map<dd4hep::Readout,std::pair<dd4hep::IDDescriptor,dd4hep::DDSegmentation::Segmentation*> > m_segments;
   /// Helper to save alignment conditions from the DetElement nominals
   std::map<dd4hep::DetElement,dd4hep::AlignmentCondition> nominals;
+  /// Persistent layout used when saving the data
+  int m_layout = FULL;
 
   /// Default constructor
   DD4hepRootPersistency();
@@ -41,7 +54,7 @@ public:
   virtual ~DD4hepRootPersistency();
 
   /// Save an existing detector description in memory to a ROOT file
-  static int save(dd4hep::Detector& description, const char* fname, const char* instance = "Geometry");
+  static int save(dd4hep::Detector& description, const char* fname, const char* instance = "Geometry", int layout = FULL);
   /// Load an detector description from a ROOT file to memory
   static int load(dd4hep::Detector& description, const char* fname, const char* instance = "Geometry");
   
@@ -87,7 +100,7 @@ public:
   const HandleMap& idSpecifications() const   {    return m_data->m_idDict;           }
 
   /// ROOT implementation macro
-  ClassDef(DD4hepRootPersistency,1);
+  ClassDef(DD4hepRootPersistency,2);
 };
 
 
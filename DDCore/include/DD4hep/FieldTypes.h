@@ -18,6 +18,7 @@
 #include <DD4hep/Shapes.h>
 
 // C/C++ include files
+#include <cstdint>
 #include <vector>
 
 /// Namespace for the AIDA detector description toolkit
@@ -188,5 +189,93 @@ namespace dd4hep {
     virtual void fieldComponents(const double* pos, double* field);
   };
 
+  /// Implementation object of a magnetic field map on a regular grid
+  /**
+   *  The field values are stored on a regular grid in a binary file, which is
+   *  mapped read-only into memory. Two grid geometries are supported:
+   *  - CARTESIAN:   nodes in (x,y,z), components (Bx,By,Bz). Trilinear interpolation.
+   *  - CYLINDRICAL: nodes in (r,z),   components (Br,Bphi,Bz). Bilinear interpolation.
+   *                 The result is rotated to the azimuth of the position.
+   *
+   *  Each node occupies 16 bytes (3 floats and padding). The node data starts
+   *  at a 64 byte boundary, so that the two nodes adjacent along the fastest
+   *  axis share one cache line.
+   *
+   *  Coordinates may be folded on the x, y and z axes. For a negative coordinate
+   *  on a folded axis the absolute value is looked up, and the field components
+   *  are multiplied with the parity of that axis.
+   *  Outside the grid the field map does not contribute. An axis with a single
+   *  node is not bounded: the field is invariant along this axis.
+   *
+   *  \author  agent
+   *  \version 1.0
+   *  \ingroup DD4HEP_CORE
+   */
+  class FieldMapField : public CartesianField::Object {
+  public:
+    enum Geometry { CARTESIAN = 1, CYLINDRICAL = 2 };
+    enum { VERSION = 1 };
+    /// File header of the binary grid. Lengths and field values in the units of the file
+    struct Header  {
+      char          magic[8];
+      std::uint32_t version;
+      std::uint32_t geometry;
+      std::uint32_t dimension[3];
+      std::uint32_t spare;
+      double        start[3];
+      double        step[3];
+      std::uint64_t data_offset;
+      std::uint64_t data_size;
+    };
+    /// Field node
+    struct Node  {
+      float         b[3];
+      float         spare;
+    };
+    /// Name of the mapped file
+    std::string    file;
+    /// Grid geometry
+    int            geometry    { CARTESIAN };
+    /// Bit mask of folded axes (1: x, 2: y, 4: z)
+    int            fold        { 0 };
+    /// Parity of the field components for every folded axis
+    double         parity[3][3] {{1,1,1},{1,1,1},{1,1,1}};
+
+  protected:
+    /// Number of nodes per grid axis
+    long           dimension[3] { 0, 0, 0 };
+    /// Position of the first node in internal units
+    double         start[3]     { 0, 0, 0 };
+    /// Inverse node distance in internal units
+    double         inv_step[3]  { 0, 0, 0 };
+    /// Index stride per grid axis
+    long           stride[3]    { 0, 0, 0 };
+    /// Conversion of the stored lengths to internal units
+    double         length_unit  { 1e0 };
+    /// Conversion of the stored field values to internal units
+    double         field_unit   { 1e0 };
+    /// Start of the node data
+    const Node*    nodes        { nullptr };   //! not persistent
+    /// Start address and size of the file mapping
+    void*          mapping      { nullptr };   //! not persistent
+    std::size_t    mapping_size { 0 };         //! not persistent
+
+  public:
+    /// Initializing constructor
+    FieldMapField();
+    /// Default destructor: unmaps the file
+    virtual ~FieldMapField();
+    /// Map the grid file. Lengths are converted with lunit, field values with funit
+    void load(const std::string& file_name, double lunit, double funit);
+    /// Map the grid file again after the field was read from a ROOT file
+    void remap();
+    /// Write a field map file. Values are given as triplets per node, the first grid axis runs fastest
+    static void write(const std::string& file_name, int geometry,
+                      const unsigned dim[3], const double start[3], const double step[3],
+                      const std::vector<float>& values);
+    /// Call to access the field components at a given location
+    virtual void fieldComponents(const double* pos, double* field);
+  };
+
 }         /* End namespace dd4hep             */
 #endif // DD4HEP_FIELDTYPES_H
@@ -80,6 +80,8 @@ namespace dd4hep {
     std::string toString() const;
     /// Access the BitFieldCoder object
     BitFieldCoder* decoder()  const;
+    /// Check that a compile time coder (DDSegmentation::BitFieldCoderFixed) matches. Throws on mismatch
+    template <typename FIXED_CODER> void verify()  const  {  FIXED_CODER::verify(*decoder());  }
     /// Re-build object in place
     void rebuild(const std::string& description);
   };
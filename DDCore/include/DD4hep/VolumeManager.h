@@ -32,6 +32,35 @@ namespace dd4hep {
     class VolumeManagerObject;
   }
   
+  /// Composed volume-to-world transformation of one placement cached by the volume manager
+  /**
+   *  Rotation (row-major) and translation of the product of the
+   *  DetElement's nominal world transformation and the volume-to-element
+   *  transformation. Filled only if the volume manager's world
+   *  transformation cache is enabled (see VolumeManager::WORLD_CACHE).
+   *
+   * \author  agent
+   * \version 1.0
+   * \ingroup DD4HEP_CORE
+   */
+  class VolumeManagerTransform {
+  public:
+    /// Rotation matrix (row-major)
+    double rotation[9];
+    /// Translation vector
+    double translation[3];
+  public:
+    /// Assign the content of a ROOT matrix
+    void set(const TGeoMatrix& matrix);
+    /// Transform local coordinates to the world coordinates
+    void localToWorld(const double local[3], double world[3])  const  {
+      const double* r = rotation;
+      world[0] = translation[0] + local[0]*r[0] + local[1]*r[1] + local[2]*r[2];
+      world[1] = translation[1] + local[0]*r[3] + local[1]*r[4] + local[2]*r[5];
+      world[2] = translation[2] + local[0]*r[6] + local[1]*r[7] + local[2]*r[8];
+    }
+  };
+
   /// This structure describes the cached data for one placement held by the volume manager
   /**
    *  This structure is slightly optimized, since there are soooo many instances:
@@ -57,6 +86,8 @@ namespace dd4hep {
     VolumeID     mask       = ~0x0ULL;
     /// Flag to indicate optional information
     long         flag       = 0;
+    /// Optional cached volume-to-world transformation
+    const VolumeManagerTransform* worldTrafo = 0;  //! Not ROOT persistent
   public:
     /// Default constructor
     VolumeManagerContext() = default;
@@ -122,6 +153,11 @@ namespace dd4hep {
    *  subdetectors must have the same length to ensure the uniqueness of the
    *  placement keys.
    *
+   *  In LAZY mode the subdetectors are only scanned when a volume identifier
+   *  of the subdetector is looked up the first time. The subdetector is identified
+   *  by the "system" field of its readout; subdetectors without are scanned at once.
+   *  Lookups are serialized only as long as subdetectors are pending.
+   *
    *  By default the volume manager in TREE mode (-> 1)) is attached to the
    *  Detector instance and also managed by this instance.
    *  If you wish to create instances yourself, you must ensure that the
@@ -140,6 +176,9 @@ namespace dd4hep {
       TREE = 1 << 1,   // Build 1 level DetElement hierarchy while populating
       ONE  = 1 << 2,   // Populate all daughter volumes into one big lookup-container
       // This flag may be in parallel with 'TREE'
+      FROZEN = 1 << 3, // Build the read-only flat lookup index after populating
+      WORLD_CACHE = 1 << 4, // Cache the composed volume-to-world transformations
+      LAZY = 1 << 5,   // Populate the subdetector sections on first access only
       LAST
     };
 
@@ -197,6 +236,34 @@ namespace dd4hep {
     /// Register physical volume with the manager and pre-computed volume id
     bool adoptPlacement(VolumeID volume_id, VolumeManagerContext* context);
 
+    /// Populate all subdetector sections, which were deferred by the LAZY flag.
+    /** Must be called before accessing the sections of a LAZY volume manager directly.
+     *  Returns the number of added placements.
+     */
+    std::size_t populate();
+
+    /// Build the read-only flat lookup index. No placements may be added afterwards.
+    /** The index is a cache-friendly replacement of the map based lookup.
+     *  It may only be built for the top level volume manager.
+     *  Returns the number of indexed placements.
+     */
+    std::size_t freeze();
+    /// Check if the flat lookup index was built
+    bool isFrozen()  const;
+
+    /// Cache the composed volume-to-world transformation of all placements.
+    /** Once enabled, VolumeManagerContext::localToWorld needs only one affine
+     *  transformation. The cache is refreshed by the PLACEMENT_CHANGED update
+     *  callback of the subdetectors and when global alignments are applied
+     *  by the GlobalAlignmentCache. Other modifications of the geometry require
+     *  to call this function again.
+     *  It may only be built for the top level volume manager.
+     *  Returns the number of cached transformations.
+     */
+    std::size_t cacheWorldTransformations();
+    /// Check if the volume-to-world transformations are cached
+    bool hasWorldCache()  const;
+
     /** This set of functions is required when reading/analyzing
      *  already created hits which have a VolumeID attached.
      */
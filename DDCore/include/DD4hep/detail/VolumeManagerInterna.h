@@ -30,12 +30,18 @@
 // ROOT include files
 #include <TGeoMatrix.h>
 
+// C/C++ include files
+#include <vector>
+#include <atomic>
+
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
   /// Namespace for implementation details of the AIDA detector description toolkit
   namespace detail {
 
+    class VolumeManagerObject;
+
     /// Extended context. Needs to be public for persistency reasons
     /**
      *
@@ -55,6 +61,51 @@ namespace dd4hep {
       ~VolumeManagerContextExtension() = default;
     };
   
+    /// Frozen, read-only lookup index of the volume manager
+    /**
+     *  Flat replacement of the map based lookup in VolumeManager::lookupContext.
+     *  The index is built once after the volume manager is populated.
+     *  All placements of one manager section are stored in a contiguous
+     *  block of sorted keys. Sections are searched in the same order as
+     *  by the map based lookup, hence the lookup semantics are identical.
+     *
+     * \author  agent
+     * \version 1.0
+     * \ingroup DD4HEP_CORE
+     */
+    class VolumeManagerIndex  {
+    public:
+      /// Index section describing the placements of one volume manager
+      struct Section  {
+        /// Sub-detector mask applied to the volume identifier before the search
+        VolumeID      mask  = ~0x0ULL;
+        /// First entry of the section in the key/context arrays
+        std::size_t   begin = 0;
+        /// End of the section in the key/context arrays
+        std::size_t   end   = 0;
+      };
+      /// Sections in lookup order
+      std::vector<Section>               sections;
+      /// Sorted volume identifiers (sorted within each section)
+      std::vector<VolumeID>              keys;
+      /// Volume contexts with the same index as the keys
+      std::vector<VolumeManagerContext*> contexts;
+
+    public:
+      /// Default constructor
+      VolumeManagerIndex() = default;
+      /// No copy constructor
+      VolumeManagerIndex(const VolumeManagerIndex& copy) = delete;
+      /// Default destructor. The contexts are owned by the volume managers
+      ~VolumeManagerIndex() = default;
+      /// No copy assignment
+      VolumeManagerIndex& operator=(const VolumeManagerIndex& copy) = delete;
+      /// Add all placements of a volume manager as a new section
+      void add(const VolumeManagerObject& manager);
+      /// Search the index for a matching ID
+      VolumeManagerContext* search(VolumeID id) const;
+    };
+
     /// This structure describes the internal data of the volume manager object
     /**
      *
@@ -84,6 +135,22 @@ namespace dd4hep {
       VolumeID               detMask = ~0x0ULL;
       /// Population flags
       int                    flags   = VolumeManager::NONE;
+      /// Frozen lookup index (top level manager only)
+      VolumeManagerIndex*    index   = 0;  //! Not ROOT persistent
+      /// Cached volume-to-world transformations of the placements in 'volumes'
+      std::vector<VolumeManagerTransform> transforms;  //! Not ROOT persistent
+      /// Subdetector not yet scanned: identified by the value of its "system" field
+      struct PendingSection  {
+        DetElement             detector;
+        const BitFieldElement* system = 0;
+        FieldID                sysID  = 0;
+      };
+      /// Subdetectors not yet scanned (LAZY population, top level manager only)
+      std::vector<PendingSection> pending;            //! Not ROOT persistent
+      /// Detector description used to scan pending subdetectors
+      const Detector*        description = 0;         //! Not ROOT persistent
+      /// Set while subdetectors are pending. Lookups are only serialized while set
+      std::atomic<bool>      lazy { false };          //! Not ROOT persistent
     public:
       /// Default constructor
       VolumeManagerObject() = default;
@@ -101,6 +168,12 @@ namespace dd4hep {
       VolumeManagerContext* search(const VolumeID& id) const;
       /// Update callback when alignment has changed (called only for subdetectors....)
       void update(unsigned long tags, DetElement& det, void* param);
+      /// (Re-)compute the cached volume-to-world transformations of all placements
+      std::size_t updateTransforms();
+      /// Scan the pending subdetector containing the volume identifier. Unknown identifiers scan nothing
+      std::size_t populate(VolumeID volume_id);
+      /// Scan all pending subdetectors
+      std::size_t populate();
     };
 
   }       /* End namespace detail                  */
@@ -0,0 +1,210 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+
+#ifndef DDSEGMENTATION_BITFIELDCODERFIXED_H
+#define DDSEGMENTATION_BITFIELDCODERFIXED_H 1
+
+#include "DDSegmentation/BitFieldCoder.h"
+
+#include <string_view>
+#include <stdexcept>
+#include <sstream>
+
+namespace dd4hep {
+
+  namespace DDSegmentation {
+
+    /// Compile time equivalent of the BitFieldElement.
+    /** All members are literal values: accessors are inlined to a shift and a mask
+     *  when the element is a constant expression.
+     */
+    class BitFieldElementFixed  {
+    public:
+      std::string_view name;
+      CellID   mask     {};
+      unsigned offset   {};
+      unsigned width    {};
+      bool     isSigned {};
+
+      /// calculate this field's value given an external 64 bit bitmap
+      constexpr FieldID value(CellID id) const  {
+        FieldID val = FieldID( ( id & mask ) >> offset ) ;
+        if( isSigned && ( val & ( 1LL << ( width - 1 ) ) ) != 0 )  // negative value
+          val -= ( 1LL << width ) ;
+        return val ;
+      }
+      /// assign the given value to the bit field. Same range check as BitFieldElement::set
+      constexpr void set(CellID& field, FieldID in) const  {
+        FieldID minVal = isSigned ? ( 1LL << ( width - 1 ) ) - ( 1LL << width ) : 0 ;
+        FieldID maxVal = isSigned ? ( 1LL << ( width - 1 ) ) - 1 : ( 1LL << width ) ;
+        if( in < minVal || in > maxVal )
+          throw std::runtime_error(" BitFieldElementFixed '" + std::string(name) + "': out of range") ;
+        field &= ~mask ;  // zero out the field's range
+        field |= ( ( CellID(in) << offset ) & mask ) ;
+      }
+    };
+
+    /// BitFieldCoder with a descriptor fixed at compile time.
+    /** The descriptor string is parsed by the compiler. Field lookups by name
+     *  are constant expressions, hence decoding a field costs one shift and one mask
+     *  without any indirection through the field vector or the name map.
+     *  Unknown field names or malformed descriptors fail to compile when used
+     *  in a constant expression.
+     *
+     *  Since the geometry is loaded at run time, the descriptor must be checked
+     *  once against the IDDescriptor of the readout, e.g. when a sensitive
+     *  action or a converter is configured.
+     *
+     *  Example:<br>
+     *    inline constexpr char tracker_id[] = "system:5,side:-2,layer:9,module:8,sensor:8,x:32:-16,y:-16"; <br>
+     *    using TrackerCoder = BitFieldCoderFixed<tracker_id> ;         <br>
+     *    TrackerCoder::verify( *readout.idSpec().decoder() ) ;        <br>
+     *    constexpr auto layer = TrackerCoder::field( "layer" ) ;      <br>
+     *    int l = layer.value( cellID ) ;                              <br>
+     *    int x = TrackerCoder::get<TrackerCoder::index("x")>( cellID ) ; <br>
+     *
+     *  \author  agent
+     *  \version 1.0
+     */
+    template <const char* DESCRIPTION> class BitFieldCoderFixed  {
+    public:
+      /// The descriptor string
+      static constexpr std::string_view description  { DESCRIPTION };
+
+    private:
+      /// Parse an unsigned number
+      static constexpr unsigned to_number(std::string_view s)  {
+        unsigned val = 0 ;
+        if( s.empty() ) throw std::invalid_argument("BitFieldCoderFixed: empty number") ;
+        for( char c : s )  {
+          if( c < '0' || c > '9' ) throw std::invalid_argument("BitFieldCoderFixed: invalid number") ;
+          val = 10*val + unsigned(c - '0') ;
+        }
+        return val ;
+      }
+      /// Next non-empty token starting at position 'pos'. Updates pos to the end of the token
+      static constexpr std::string_view token(std::string_view s, char del, std::size_t& pos)  {
+        while( pos < s.size() && s[pos] == del ) ++pos ;
+        std::size_t start = pos ;
+        while( pos < s.size() && s[pos] != del ) ++pos ;
+        return s.substr(start, pos-start) ;
+      }
+      /// Decode one field descriptor: name:[start]:[-]length
+      static constexpr BitFieldElementFixed decode(std::string_view desc, unsigned& offset)  {
+        std::string_view tok[4] {} ;
+        std::size_t pos = 0, num = 0 ;
+        for( ; num < 4 ; ++num )  {
+          tok[num] = token(desc, ':', pos) ;
+          if( tok[num].empty() ) break ;
+        }
+        BitFieldElementFixed f {} ;
+        std::string_view wid ;
+        f.name = tok[0] ;
+        switch( num )  {
+        case 2:
+          f.offset = offset ;
+          wid      = tok[1] ;
+          break ;
+        case 3:
+          f.offset = to_number(tok[1]) ;
+          wid      = tok[2] ;
+          break ;
+        default:
+          throw std::invalid_argument("BitFieldCoderFixed: invalid number of subfields") ;
+        }
+        f.isSigned = !wid.empty() && wid[0] == '-' ;
+        f.width    = to_number(f.isSigned ? wid.substr(1) : wid) ;
+        if( f.offset > 63 || f.offset + f.width > 64 )
+          throw std::out_of_range("BitFieldCoderFixed: field out of range") ;
+        f.mask     = ( ( 0x0001ULL << f.width ) - 1 ) << f.offset ;
+        offset     = f.offset + f.width ;
+        return f ;
+      }
+
+    public:
+      /// Number of fields
+      static constexpr std::size_t size()  {
+        std::size_t pos = 0, num = 0 ;
+        while( !token(description, ',', pos).empty() ) ++num ;
+        return num ;
+      }
+      /// Access field by index
+      static constexpr BitFieldElementFixed field(std::size_t idx)  {
+        std::size_t pos = 0 ;
+        unsigned offset = 0 ;
+        for( std::size_t i = 0 ; ; ++i )  {
+          std::string_view desc = token(description, ',', pos) ;
+          if( desc.empty() )
+            throw std::out_of_range("BitFieldCoderFixed: invalid field index") ;
+          BitFieldElementFixed f = decode(desc, offset) ;
+          if( i == idx ) return f ;
+        }
+      }
+      /// Index for field named 'name'. Unknown names do not compile in constant expressions
+      static constexpr std::size_t index(std::string_view name)  {
+        for( std::size_t i = 0, n = size() ; i < n ; ++i )
+          if( field(i).name == name ) return i ;
+        throw std::runtime_error(" BitFieldCoderFixed: unknown name: " + std::string(name)) ;
+      }
+      /// Access field by name
+      static constexpr BitFieldElementFixed field(std::string_view name)  {
+        return field(index(name)) ;
+      }
+      /// The mask of all the bits used in the description
+      static constexpr CellID mask()  {
+        CellID m = 0 ;
+        for( std::size_t i = 0, n = size() ; i < n ; ++i )  {
+          CellID fm = field(i).mask ;
+          if( m & fm ) throw std::invalid_argument("BitFieldCoderFixed: overlapping fields") ;
+          m |= fm ;
+        }
+        return m ;
+      }
+
+      /// Get value of sub-field specified by index
+      template <std::size_t IDX> static constexpr FieldID get(CellID bitfield)  {
+        constexpr BitFieldElementFixed f = field(IDX) ;
+        return f.value(bitfield) ;
+      }
+      /// Set value of sub-field specified by index
+      template <std::size_t IDX> static constexpr void set(CellID& bitfield, FieldID value)  {
+        constexpr BitFieldElementFixed f = field(IDX) ;
+        f.set(bitfield, value) ;
+      }
+
+      /// Check if a run time decoder has the identical layout
+      static bool matches(const BitFieldCoder& coder)  {
+        constexpr std::size_t n = size() ;
+        if( coder.size() != n ) return false ;
+        for( std::size_t i = 0 ; i < n ; ++i )  {
+          const BitFieldElement&     r = coder[unsigned(i)] ;
+          const BitFieldElementFixed f = field(i) ;
+          if( r.name() != f.name || r.offset() != f.offset ||
+              r.width() != f.width || r.isSigned() != f.isSigned )
+            return false ;
+        }
+        return true ;
+      }
+      /// Check the run time decoder (e.g. the decoder of an IDDescriptor). Throws an exception on mismatch
+      static void verify(const BitFieldCoder& coder)  {
+        static_assert( mask() != 0, "BitFieldCoderFixed: empty descriptor" ) ;
+        if( !matches(coder) )  {
+          std::stringstream s ;
+          s << " BitFieldCoderFixed: descriptor mismatch. Compiled: '" << description
+            << "' Loaded: '" << coder.fieldDescription() << "'" ;
+          throw std::runtime_error( s.str() ) ;
+        }
+      }
+    };
+
+  } // end namespace
+} // end namespace
+#endif
@@ -88,10 +88,12 @@ namespace dd4hep {
       /// set the field name used for U
       void setFieldNameU(const std::string& fieldName) {
         _uId = fieldName;
+        resolveIdentifiers();
       }
       /// set the field name used for V
       void setFieldNameV(const std::string& fieldName) {
         _vId = fieldName;
+        resolveIdentifiers();
       }
       /** \brief Returns a vector<double> of the cellDimensions of the given cell ID
           in natural order of dimensions, e.g., dx/dy/dz, or dr/r*dPhi
@@ -115,8 +117,12 @@ namespace dd4hep {
       double _offsetV;
       /// the field name used for U
       std::string _uId;
+      /// the bit field element used for U
+      const BitFieldElement* _uField = 0;   //! No ROOT persistency
       /// the field name used for V
       std::string _vId;
+      /// the bit field element used for V
+      const BitFieldElement* _vField = 0;   //! No ROOT persistency
       /// the U grid angle
       double _gridAngle;
     };
@@ -37,6 +37,12 @@ namespace dd4hep {
       virtual Vector3D position(const CellID& cellID) const;
       /// determine the cell ID based on the position
       virtual CellID cellID(const Vector3D& localPosition, const Vector3D& globalPosition, const VolumeID& volumeID) const;
+      /// determine the local positions of n cell IDs (batch version, SoA layout)
+      virtual void positions(std::size_t n, const CellID* cellIDs, double* x, double* y, double* z) const;
+      /// determine n cell IDs from the local positions (batch version, SoA layout)
+      virtual void cellIDs(std::size_t n, const double* lx, const double* ly, const double* lz,
+                           const double* gx, const double* gy, const double* gz,
+                           const VolumeID* volumeIDs, CellID* cellIDs) const;
       /// access the grid size in X
       double gridSizeX() const {
         return _gridSizeX;
@@ -80,10 +86,12 @@ namespace dd4hep {
       /// set the field name used for X
       void setFieldNameX(const std::string& fieldName) {
         _xId = fieldName;
+        resolveIdentifiers();
       }
       /// set the field name used for Y
       void setFieldNameZ(const std::string& fieldName) {
         _zId = fieldName;
+        resolveIdentifiers();
       }
       /** \brief Returns a vector<double> of the cellDimensions of the given cell ID
           in natural order of dimensions, e.g., dx/dy/dz, or dr/r*dPhi
@@ -107,8 +115,12 @@ namespace dd4hep {
       double _offsetZ;
       /// the field name used for X
       std::string _xId;
+      /// the bit field element used for X
+      const BitFieldElement* _xField = 0;   //! No ROOT persistency
       /// the field name used for Z
       std::string _zId;
+      /// the bit field element used for Z
+      const BitFieldElement* _zField = 0;   //! No ROOT persistency
     };
 
   } /* namespace DDSegmentation */
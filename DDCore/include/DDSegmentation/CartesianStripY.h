@@ -50,7 +50,7 @@ namespace dd4hep {
       /// set the coordinate offset in Y
       void setOffsetY(double offset) { _offsetY = offset; }
       /// set the field name used for Y
-      void setFieldNameY(const std::string& fieldName) { _xId = fieldName; }
+      void setFieldNameY(const std::string& fieldName) { _xId = fieldName; resolveIdentifiers(); }
       /** \brief Returns a vector<double> of the cellDimensions of the given cell ID
           in natural order of dimensions, e.g., dx/dy/dz, or dr/r*dPhi
 
@@ -68,6 +68,8 @@ namespace dd4hep {
       double _offsetY;
       /// the field name used for Y
       std::string _xId;
+      /// the bit field element used for Y
+      const BitFieldElement* _xField = 0;   //! No ROOT persistency
     };
   }  // namespace DDSegmentation
 } /* namespace dd4hep */
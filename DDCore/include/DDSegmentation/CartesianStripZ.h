@@ -51,7 +51,7 @@ namespace dd4hep {
       /// set the coordinate offset in Z
       void setOffsetZ(double offset) { _offsetZ = offset; }
       /// set the field name used for Z
-      void setFieldNameZ(const std::string& fieldName) { _xId = fieldName; }
+      void setFieldNameZ(const std::string& fieldName) { _xId = fieldName; resolveIdentifiers(); }
       /** \brief Returns a vector<double> of the cellDimensions of the given cell ID
           in natural order of dimensions, e.g., dx/dy/dz, or dr/r*dPhi
 
@@ -69,6 +69,8 @@ namespace dd4hep {
       double _offsetZ;
       /// the field name used for Z
       std::string _xId;
+      /// the bit field element used for Z
+      const BitFieldElement* _xField = 0;   //! No ROOT persistency
     };
   }  // namespace DDSegmentation
 } /* namespace dd4hep */
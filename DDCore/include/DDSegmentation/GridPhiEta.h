@@ -131,12 +131,14 @@ namespace dd4hep {
        */
       inline void setFieldNameEta(const std::string& fieldName) {
         m_etaID = fieldName;
+        resolveIdentifiers();
       }
       /**  Set the field name used for azimuthal angle.
        *   @param[in] aFieldName Field name for phi.
        */
       inline void setFieldNamePhi(const std::string& fieldName) {
         m_phiID = fieldName;
+        resolveIdentifiers();
       }
 
     protected:
@@ -151,8 +153,12 @@ namespace dd4hep {
       double m_offsetPhi;
       /// the field name used for eta
       std::string m_etaID;
+      /// the bit field element used for eta
+      const BitFieldElement* m_etaField = 0;   //! No ROOT persistency
       /// the field name used for phi
       std::string m_phiID;
+      /// the bit field element used for phi
+      const BitFieldElement* m_phiField = 0;   //! No ROOT persistency
     };
   }
 }
@@ -91,6 +91,7 @@ namespace dd4hep {
        */
       inline void setFieldNameR(const std::string& fieldName) {
         m_rID = fieldName;
+        resolveIdentifiers();
       }
 
     private:
@@ -101,6 +102,8 @@ namespace dd4hep {
       double m_offsetR;
       /// the field name used for r
       std::string m_rID;
+      /// the bit field element used for r
+      const BitFieldElement* m_rField = 0;   //! No ROOT persistency
 
     };
   }
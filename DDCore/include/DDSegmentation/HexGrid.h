@@ -88,10 +88,12 @@ namespace dd4hep {
       /// set the field name used for X
       void setFieldNameX(const std::string& fieldName) {
         _xId = fieldName;
+        resolveIdentifiers();
       }
       /// set the field name used for Y
       void setFieldNameY(const std::string& fieldName) {
         _yId = fieldName;
+        resolveIdentifiers();
       }
       /// set the keyword used to determine which volumes to stagger
       void setStaggerKeyword(const std::string& staggerKeyword) {
@@ -120,10 +122,16 @@ namespace dd4hep {
       double _offsetY;
       /// the field name used for X
       std::string _xId;
+      /// the bit field element used for X
+      const BitFieldElement* _xField = 0;   //! No ROOT persistency
       /// the field name used for Y
       std::string _yId;
+      /// the bit field element used for Y
+      const BitFieldElement* _yField = 0;   //! No ROOT persistency
       /// the keyword used to determine which volumes to stagger
       std::string _staggerKeyword;
+      /// the bit field element used to determine which volumes to stagger
+      const BitFieldElement* _staggerField = 0;   //! No ROOT persistency
     };
 
   } /* namespace DDSegmentation */
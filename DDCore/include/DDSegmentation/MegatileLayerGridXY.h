@@ -102,10 +102,12 @@ namespace dd4hep {
       /// set the field name used for X
       void setFieldNameX(const std::string& fieldName) {
         _xId = fieldName;
+        resolveIdentifiers();
       }
       /// set the field name used for Y
       void setFieldNameY(const std::string& fieldName) {
         _yId = fieldName;
+        resolveIdentifiers();
       }
 
       virtual std::vector<double> cellDimensions(const CellID& cellID) const;
@@ -155,12 +157,20 @@ namespace dd4hep {
       
       /// the field name used for X
       std::string _xId;
+      /// the bit field element used for X
+      const BitFieldElement* _xField = 0;   //! No ROOT persistency
       /// the field name used for Y
       std::string _yId;
+      /// the bit field element used for Y
+      const BitFieldElement* _yField = 0;   //! No ROOT persistency
       /// encoding field used for the layer
       std::string _identifierLayer;
+      /// bit field element used for the layer
+      const BitFieldElement* _layerField = 0;   //! No ROOT persistency
       /// encoding field used for the wafer
       std::string _identifierWafer;
+      /// bit field element used for the wafer
+      const BitFieldElement* _waferField = 0;   //! No ROOT persistency
 
       std::string _layerConfig;
 
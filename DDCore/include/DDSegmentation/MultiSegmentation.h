@@ -48,6 +48,9 @@ namespace dd4hep {
       /// Debug flags
       int m_debug;
 
+      /// Group the entries of a batch by sub-segmentation. Unknown identifiers throw
+      std::vector<std::vector<std::size_t> > group(std::size_t n, const CellID* cellIDs) const;
+
     public:
       /// Default constructor passing the encoding string
       MultiSegmentation(const std::string& cellEncoding = "");
@@ -70,6 +73,14 @@ namespace dd4hep {
       /// determine the cell ID based on the position
       virtual CellID cellID(const Vector3D& localPosition, const Vector3D& globalPosition, const VolumeID& volumeID) const;
 
+      /// determine the local positions of n cell IDs. Batches are grouped by the discriminator value
+      virtual void positions(std::size_t n, const CellID* cellIDs, double* x, double* y, double* z) const;
+
+      /// determine n cell IDs from the local positions. Batches are grouped by the discriminator value
+      virtual void cellIDs(std::size_t n, const double* lx, const double* ly, const double* lz,
+                           const double* gx, const double* gy, const double* gz,
+                           const VolumeID* volumeIDs, CellID* cellIDs) const;
+
       /** \brief Returns a vector<double> of the cellDimensions of the given cell ID
           in natural order of dimensions, e.g., dx/dy/dz, or dr/r*dPhi
 
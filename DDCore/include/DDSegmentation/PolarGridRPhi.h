@@ -39,6 +39,12 @@ namespace dd4hep {
       virtual Vector3D position(const CellID& cellID) const;
       /// determine the cell ID based on the position
       virtual CellID cellID(const Vector3D& localPosition, const Vector3D& globalPosition, const VolumeID& volumeID) const;
+      /// determine the local positions of n cell IDs (batch version, SoA layout)
+      virtual void positions(std::size_t n, const CellID* cellIDs, double* x, double* y, double* z) const;
+      /// determine n cell IDs from the local positions (batch version, SoA layout)
+      virtual void cellIDs(std::size_t n, const double* lx, const double* ly, const double* lz,
+                           const double* gx, const double* gy, const double* gz,
+                           const VolumeID* volumeIDs, CellID* cellIDs) const;
       /// access the grid size in R
       double gridSizeR() const {
         return _gridSizeR;
@@ -82,10 +88,12 @@ namespace dd4hep {
       /// set the field name used for X
       void setFieldNameR(const std::string& fieldName) {
         _rId = fieldName;
+        resolveIdentifiers();
       }
       /// set the field name used for Y
       void setFieldNamePhi(const std::string& fieldName) {
         _phiId = fieldName;
+        resolveIdentifiers();
       }
       /** \brief Returns a vector<double> of the cellDimensions of the given cell ID
           in natural order of dimensions: dr, r*dPhi
@@ -109,8 +117,12 @@ namespace dd4hep {
       double _offsetPhi;
       /// the field name used for R
       std::string _rId;
+      /// the bit field element used for R
+      const BitFieldElement* _rField = 0;   //! No ROOT persistency
       /// the field name used for Phi
       std::string _phiId;
+      /// the bit field element used for Phi
+      const BitFieldElement* _phiField = 0;   //! No ROOT persistency
     };
 
   } /* namespace DDSegmentation */
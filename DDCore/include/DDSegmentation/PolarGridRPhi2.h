@@ -124,10 +124,12 @@ namespace dd4hep {
       /// set the field name used for X
       void setFieldNameR(const std::string& fieldName) {
         _rId = fieldName;
+        resolveIdentifiers();
       }
       /// set the field name used for Y
       void setFieldNamePhi(const std::string& fieldName) {
         _phiId = fieldName;
+        resolveIdentifiers();
       }
       /** \brief Returns a vector<double> of the cellDimensions of the given cell ID
           in natural order of dimensions: dr, r*dPhi
@@ -151,8 +153,12 @@ namespace dd4hep {
       double _offsetPhi;
       /// the field name used for R
       std::string _rId;
+      /// the bit field element used for R
+      const BitFieldElement* _rField = 0;   //! No ROOT persistency
       /// the field name used for Phi
       std::string _phiId;
+      /// the bit field element used for Phi
+      const BitFieldElement* _phiField = 0;   //! No ROOT persistency
     };
 
   } /* namespace DDSegmentation */
@@ -85,10 +85,12 @@ namespace dd4hep {
       /// set the field name used for theta
       void setFieldNameTheta(const std::string& fieldName) {
         _thetaID = fieldName;
+        resolveIdentifiers();
       }
       /// set the field name used for phi
       void setFieldNamePhi(const std::string& fieldName) {
         _phiID = fieldName;
+        resolveIdentifiers();
       }
 
     protected:
@@ -102,8 +104,12 @@ namespace dd4hep {
       double _offsetPhi;
       /// the field name used for theta
       std::string _thetaID;
+      /// the bit field element used for theta
+      const BitFieldElement* _thetaField = 0;   //! No ROOT persistency
       /// the field name used for phi
       std::string _phiID;
+      /// the bit field element used for phi
+      const BitFieldElement* _phiField = 0;   //! No ROOT persistency
 
     };
 
@@ -23,6 +23,7 @@
 #include <DDSegmentation/BitFieldCoder.h>
 #include <DDSegmentation/SegmentationParameter.h>
 
+#include <cmath>
 #include <map>
 #include <set>
 #include <string>
@@ -83,6 +84,19 @@ namespace dd4hep {
       /// Determine the cell ID based on the position
       virtual CellID cellID(const Vector3D& localPosition, const Vector3D& globalPosition,
                             const VolumeID& volumeID) const = 0;
+      /// Batch version of position(): determine the local positions of n cell IDs (SoA layout)
+      /** The default implementation loops over the scalar call.
+       *  Sub-classes overriding position() and cellID() must override the batch versions as well.
+       */
+      virtual void positions(std::size_t n, const CellID* cellIDs, double* x, double* y, double* z) const;
+      /// Batch version of cellID(): determine n cell IDs from local and global positions (SoA layout)
+      /** If the global coordinates gx, gy and gz are null, the local positions are passed
+       *  as global positions to the scalar call.
+       *  The default implementation loops over the scalar call.
+       */
+      virtual void cellIDs(std::size_t n, const double* lx, const double* ly, const double* lz,
+                           const double* gx, const double* gy, const double* gz,
+                           const VolumeID* volumeIDs, CellID* cellIDs) const;
       /// Determine the volume ID from the full cell ID by removing all local fields
       virtual VolumeID volumeID(const CellID& cellID) const;
       /// Calculates the neighbours of the given cell ID and adds them to the list of neighbours
@@ -136,6 +150,9 @@ namespace dd4hep {
       }
 
     protected:
+      /// String parameter holding a field name: changing the value re-resolves the bit field elements
+      class IdentifierParameter;
+
       /// Default constructor used by derived classes passing the encoding string
       Segmentation(const std::string& cellEncoding = "");
       /// Default constructor used by derived classes passing an existing decoder
@@ -150,7 +167,47 @@ namespace dd4hep {
       /// Add a cell identifier to this segmentation. Used by derived classes to define their required identifiers
       void registerIdentifier(const std::string& nam, const std::string& desc, std::string& ident,
                               const std::string& defaultVal);
+      /// Add a cell identifier and bind the bit field element resolved whenever the decoder or the identifier changes
+      void registerIdentifier(const std::string& nam, const std::string& desc, std::string& ident,
+                              const std::string& defaultVal, const BitFieldElement*& field);
+      /// Bind a bit field element to a field name of the decoder. Resolved together with the identifiers
+      /** If the field name is a registered string parameter, changing the parameter value re-resolves the element */
+      void registerField(std::string& ident, const BitFieldElement*& field);
+      /// Resolve the bit field elements of all registered cell identifiers and bound fields
+      void resolveIdentifiers();
+      /// Access the resolved bit field element of an identifier. Unknown identifiers throw like BitFieldCoder::index
+      const BitFieldElement& field(const BitFieldElement* elt, const std::string& ident) const {
+        return elt ? *elt : (*_decoder)[ident];
+      }
 
+      /// Inlined, branch free access to one bit field element used by the batch interfaces
+      struct BatchField  {
+        const BitFieldElement& element;
+        CellID   mask;
+        unsigned offset, left, right;
+        FieldID  minVal, maxVal;
+        bool     isSigned;
+        /// Initializing constructor
+        BatchField(const BitFieldElement& e)
+          : element(e), mask(e.mask()), offset(e.offset()),
+            left(64 - e.offset() - e.width()), right(64 - e.width()),
+            minVal(e.minValue()), maxVal(e.maxValue()), isSigned(e.isSigned())  {
+        }
+        /// Decode the field value. Identical to BitFieldElement::value
+        FieldID value(CellID id) const  {
+          return isSigned ? FieldID(id << left) >> right : FieldID((id << left) >> right);
+        }
+        /// Encode the field value. Out of range values are passed to BitFieldElement::set, which throws
+        void set(CellID& id, FieldID val) const  {
+          if ( val < minVal || val > maxVal )
+            element.set(id, val);
+          id = (id & ~mask) | ((CellID(val) << offset) & mask);
+        }
+      };
+      /// Inline version of positionToBin for the batch interfaces. The cell size must have been checked
+      static int positionToBinUnchecked(double position, double cellSize, double offset)  {
+        return int(std::floor((position + 0.5 * cellSize - offset) / cellSize));
+      }
       /// Helper method to convert a bin number to a 1D position
       static double binToPosition(FieldID bin, double cellSize, double offset = 0.);
       /// Helper method to convert a 1D position to a cell ID
@@ -171,6 +228,12 @@ namespace dd4hep {
       std::map<std::string, Parameter> _parameters;   //! No ROOT persistency
       /// The indices used for the encoding
       std::map<std::string, StringParameter> _indexIdentifiers;   //! No ROOT persistency
+      /// Bit field elements bound to field names of the decoder
+      std::vector<std::pair<const std::string*, const BitFieldElement**> > _identifierFields;   //! No ROOT persistency
+      /// Mask of all resolved identifier fields
+      CellID _identifierMask = 0;   //! No ROOT persistency
+      /// Flag if all identifiers could be resolved by the decoder
+      bool _identifiersResolved = false;   //! No ROOT persistency
       /// The cell ID encoder and decoder
       const BitFieldCoder* _decoder = 0;
       /// Keeps track of the decoder ownership
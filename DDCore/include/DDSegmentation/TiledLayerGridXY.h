@@ -113,10 +113,12 @@ namespace dd4hep {
       /// set the field name used for X
       void setFieldNameX(const std::string& fieldName) {
         _xId = fieldName;
+        resolveIdentifiers();
       }
       /// set the field name used for Y
       void setFieldNameY(const std::string& fieldName) {
         _yId = fieldName;
+        resolveIdentifiers();
       }
       /// set the field name used for Y
       void setFieldNameLayer(const std::string& fieldName) {
@@ -154,10 +156,16 @@ namespace dd4hep {
       double _offsetY;
       /// the field name used for X
       std::string _xId;
+      /// the bit field element used for X
+      const BitFieldElement* _xField = 0;   //! No ROOT persistency
       /// the field name used for Y
       std::string _yId;
+      /// the bit field element used for Y
+      const BitFieldElement* _yField = 0;   //! No ROOT persistency
       /// encoding field used for the layer
       std::string _identifierLayer; 
+      /// bit field element used for the layer
+      const BitFieldElement* _layerField = 0;   //! No ROOT persistency
       /// list of layer x offset
       std::vector<double> _layerOffsetX;
       /// list of layer y offset
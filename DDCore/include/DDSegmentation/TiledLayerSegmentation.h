@@ -93,14 +93,17 @@ namespace dd4hep {
       /// set the encoding field name used for X
       void setIdentifierX(const std::string& fieldName) {
         _identifierX = fieldName;
+        resolveIdentifiers();
       }
       /// set the encoding field name used for Y
       void setIdentifierY(const std::string& fieldName) {
         _identifierY = fieldName;
+        resolveIdentifiers();
       }
       /// set the encoding field name used for layer
       void setIdentifierLayer(const std::string& fieldName) {
         _identifierLayer = fieldName;
+        resolveIdentifiers();
       }
 
       /// set the dimensions of the given layer
@@ -112,8 +115,11 @@ namespace dd4hep {
       double _gridSizeX; /// default grid size in X
       double _gridSizeY; /// default grid size in Y
       std::string _identifierX; /// encoding field used for X
+      const BitFieldElement* _xField = 0; //! No ROOT persistency, bit field element used for X
       std::string _identifierY; /// encoding field used for Y
+      const BitFieldElement* _yField = 0; //! No ROOT persistency, bit field element used for Y
       std::string _identifierLayer; /// encoding field used for the layer
+      const BitFieldElement* _layerField = 0; //! No ROOT persistency, bit field element used for the layer
       std::vector<int> _layerIndices; /// list of valid layer identifiers
       std::vector<double> _layerDimensionsX; /// list of layer x dimensions
       std::vector<double> _layerDimensionsY; /// list of layer y dimensions
@@ -102,10 +102,12 @@ namespace dd4hep {
       /// set the field name used for X
       void setFieldNameX(const std::string& fieldName) {
         _xId = fieldName;
+        resolveIdentifiers();
       }
       /// set the field name used for Y
       void setFieldNameY(const std::string& fieldName) {
         _yId = fieldName;
+        resolveIdentifiers();
       }
       /** \brief Returns a vector<double> of the cellDimensions of the given cell ID
           in natural order of dimensions, e.g., dx/dy/dz, or dr/r*dPhi
@@ -133,12 +135,20 @@ namespace dd4hep {
       double _waferOffsetY[MAX_GROUPS][MAX_WAFERS];
       /// the field name used for X
       std::string _xId;
+      /// the bit field element used for X
+      const BitFieldElement* _xField = 0;   //! No ROOT persistency
       /// the field name used for Y
       std::string _yId;
+      /// the bit field element used for Y
+      const BitFieldElement* _yField = 0;   //! No ROOT persistency
       /// encoding field used for the Magic Wafer group
       std::string _identifierMGWaferGroup; 
+      /// bit field element used for the Magic Wafer group
+      const BitFieldElement* _groupMGWaferField = 0;   //! No ROOT persistency
       /// encoding field used for the wafer
       std::string _identifierWafer; 
+      /// bit field element used for the wafer
+      const BitFieldElement* _waferField = 0;   //! No ROOT persistency
     };
 
   } /* namespace DDSegmentation */
@@ -15,6 +15,7 @@
 #include <DD4hep/Printout.h>
 #include <DD4hep/DD4hepRootPersistency.h>
 #include <DD4hep/detail/ObjectsInterna.h>
+#include <DD4hep/detail/DetectorInterna.h>
 #include <DD4hep/detail/SegmentationsInterna.h>
 
 // ROOT include files
@@ -44,7 +45,7 @@ DD4hepRootPersistency::DD4hepRootPersistency() : TNamed() {
 DD4hepRootPersistency::~DD4hepRootPersistency() {
 }
 
-int DD4hepRootPersistency::save(Detector& description, const char* fname, const char* instance)   {
+int DD4hepRootPersistency::save(Detector& description, const char* fname, const char* instance, int layout)   {
   TFile* f = TFile::Open(fname,"RECREATE");
   if ( f && !f->IsZombie()) {
     try  {
@@ -53,8 +54,13 @@ int DD4hepRootPersistency::save(Detector& description, const char* fname, const
       DetectorData::patchRootStreamer(TGeoNode::Class());
       load_nominal_alignments(description.world());
       DD4hepRootPersistency* persist = new DD4hepRootPersistency();
+      persist->m_layout = layout;
       persist->m_data = new dd4hep::DetectorData();
       persist->m_data->adoptData(dynamic_cast<DetectorData&>(description),false);
+      if ( layout == VOLMGR_ON_DEMAND )  {
+        /// The volume manager tables are rebuilt on demand after loading
+        persist->m_data->m_volManager = VolumeManager();
+      }
       for( const auto& sens : persist->m_data->m_sensitive )  {
         dd4hep::SensitiveDetector sd = sens.second;
         dd4hep::Readout ro = sd.readout();
@@ -71,6 +77,10 @@ int DD4hepRootPersistency::save(Detector& description, const char* fname, const
         }
         printout(ALWAYS,"DD4hepRootPersistency","+++ Saving %ld nominals....",persist->nominals.size());
       }
+      else if ( layout == VOLMGR_ON_DEMAND )  {
+        printout(ALWAYS,"DD4hepRootPersistency",
+                 "+++ Volume manager not saved. Its sections are populated on demand after loading.");
+      }
       else  {
         printout(ALWAYS,
                  "DD4hepRootPersistency","+++ No valid Volume manager. No nominals saved.",
@@ -89,6 +99,10 @@ int DD4hepRootPersistency::save(Detector& description, const char* fname, const
                  "+++ Successfully saved geometry data to file.");
       }
       delete f;
+      /// The source description stays usable: return the extensions and the world's back-link
+      dynamic_cast<DetectorData&>(description).m_extensions.move(persist->m_data->m_extensions);
+      World world = description.world();
+      world->description = &description;
       delete persist;
       DetectorData::unpatchRootStreamer(TGeoVolume::Class());
       DetectorData::unpatchRootStreamer(TGeoNode::Class());
@@ -163,13 +177,21 @@ int DD4hepRootPersistency::load(Detector& description, const char* fname, const
                    "+++ Fixed VolumeManager TOTALS     %-24s  %6ld volumes %4ld sdets %4ld mgrs.","",num[0],num[1],num[2]);
           printout(ALWAYS,"DD4hepRootPersistency","+++ loaded %ld nominals....",persist->nominals.size());
         }
-        else   {
+        else if ( persist->m_layout != VOLMGR_ON_DEMAND )   {
           printout(ALWAYS,"DD4hepRootPersistency","+++ Volume manager NOT restored. [Was it ever up when saved?]");
         }
         DetectorData* tar_data = dynamic_cast<DetectorData*>(&description);
         DetectorData* src_data = dynamic_cast<DetectorData*>(source);
         if( tar_data != nullptr && src_data != nullptr )  {
           tar_data->adoptData(*src_data,false);
+          if ( persist->m_layout == VOLMGR_ON_DEMAND )   {
+            /// Only the volume manager sections of subdetectors accessed by the application get scanned
+            tar_data->m_volManager = VolumeManager(description, "World", description.world(), Readout(),
+                                                   VolumeManager::TREE|VolumeManager::LAZY);
+            printout(ALWAYS,"DD4hepRootPersistency",
+                     "+++ Volume manager sections of %ld subdetectors are populated on demand.",
+                     description.world().children().size());
+          }
           TTimeStamp stop;
           printout(ALWAYS,"DD4hepRootPersistency",
                    "+++ Successfully loaded detector description from file:%s  [%8.3f seconds]",
@@ -425,6 +447,7 @@ namespace {
     /// Check nominal alignments of the volume manager
     size_t checkNominals(VolumeManager mgr)   {
       int count = 0;
+      mgr.populate();   // Sections may have been deferred (VOLMGR_ON_DEMAND layout)
       const auto& sdets = mgr->subdetectors;
       for( const auto& vm : sdets )  {
         VolumeManager::Object* obj   = vm.second.ptr();
@@ -12,8 +12,19 @@
 //==========================================================================
 
 #include <DD4hep/FieldTypes.h>
+#include <DD4hep/Printout.h>
 #include <DD4hep/detail/Handle.inl>
+#include <algorithm>
+#include <cerrno>
 #include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 using namespace dd4hep;
 
@@ -26,6 +37,7 @@ DD4HEP_INSTANTIATE_HANDLE(ConstantField);
 DD4HEP_INSTANTIATE_HANDLE(SolenoidField);
 DD4HEP_INSTANTIATE_HANDLE(DipoleField);
 DD4HEP_INSTANTIATE_HANDLE(MultipoleField);
+DD4HEP_INSTANTIATE_HANDLE(FieldMapField);
 
 /// Compute  the field components at a given location and add to given field
 void ConstantField::fieldComponents(const double* pos, double* field) {
@@ -204,3 +216,202 @@ void MultipoleField::fieldComponents(const double* pos, double* field) {
     field[2] += f.Z();
   }
 }
+
+namespace  {
+  constexpr static char FIELDMAP_MAGIC[8] = { 'D','D','4','H','F','M','A','P' };
+
+  /// Number of grid nodes. Returns 0 for empty grids and if the data size would overflow
+  std::size_t grid_nodes(const std::uint32_t dim[3])   {
+    const std::size_t max_nodes = std::numeric_limits<std::size_t>::max() / sizeof(FieldMapField::Node);
+    std::size_t num_nodes = 1;
+    for( int i = 0; i < 3; ++i )  {
+      std::size_t d = dim[i];
+      num_nodes = (d == 0 || num_nodes > max_nodes / d) ? 0 : num_nodes * d;
+    }
+    return num_nodes;
+  }
+}
+
+/// Initializing constructor
+FieldMapField::FieldMapField()   {
+  field_type = CartesianField::MAGNETIC;
+}
+
+/// Default destructor: unmaps the file
+FieldMapField::~FieldMapField()   {
+  if ( mapping )  {
+    ::munmap(mapping, mapping_size);
+    mapping = nullptr;
+  }
+}
+
+/// Write a field map file. Values are given as triplets per node, the first grid axis runs fastest
+void FieldMapField::write(const std::string& file_name, int geom,
+                          const unsigned dim[3], const double first[3], const double step[3],
+                          const std::vector<float>& values)
+{
+  Header hdr;
+  std::size_t num_nodes = grid_nodes(dim);
+  if ( num_nodes == 0 || values.size() != 3*num_nodes )  {
+    except("FieldMapField","+++ %s: Inconsistent field map: %ld nodes, %ld values.",
+           file_name.c_str(), long(num_nodes), long(values.size()));
+  }
+  ::memset(&hdr, 0, sizeof(hdr));
+  ::memcpy(hdr.magic, FIELDMAP_MAGIC, sizeof(hdr.magic));
+  hdr.version     = VERSION;
+  hdr.geometry    = geom;
+  for( int i = 0; i < 3; ++i )  {
+    hdr.dimension[i] = dim[i];
+    hdr.start[i]     = first[i];
+    hdr.step[i]      = step[i];
+  }
+  hdr.data_offset = (sizeof(Header) + 63) & ~std::uint64_t(63);
+  hdr.data_size   = num_nodes * sizeof(Node);
+
+  std::string tmp = file_name + ".tmp";
+  std::ofstream out(tmp, std::ios::binary|std::ios::trunc);
+  if ( !out )  {
+    except("FieldMapField","+++ Failed to open field map %s: %s", tmp.c_str(), std::strerror(errno));
+  }
+  char pad[64];
+  ::memset(pad, 0, sizeof(pad));
+  out.write((const char*)&hdr, sizeof(hdr));
+  out.write(pad, hdr.data_offset - sizeof(hdr));
+  for( std::size_t i = 0; i < num_nodes; ++i )  {
+    Node n { { values[3*i], values[3*i+1], values[3*i+2] }, 0e0f };
+    out.write((const char*)&n, sizeof(n));
+  }
+  out.close();
+  if ( !out || 0 != ::rename(tmp.c_str(), file_name.c_str()) )  {
+    except("FieldMapField","+++ Failed to write field map %s: %s", file_name.c_str(), std::strerror(errno));
+  }
+}
+
+/// Map the grid file. Lengths are converted with lunit, field values with funit
+void FieldMapField::load(const std::string& file_name, double lunit, double funit)   {
+  struct stat st;
+  int fd = ::open(file_name.c_str(), O_RDONLY);
+  if ( fd < 0 || 0 != ::fstat(fd, &st) )  {
+    if ( fd >= 0 ) ::close(fd);
+    except("FieldMapField","+++ Failed to open field map %s: %s", file_name.c_str(), std::strerror(errno));
+  }
+  std::size_t len = st.st_size;
+  void* addr = len >= sizeof(Header) ? ::mmap(nullptr, len, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+  ::close(fd);
+  if ( addr == MAP_FAILED )  {
+    except("FieldMapField","+++ Failed to map field map %s [%ld bytes]", file_name.c_str(), long(len));
+  }
+  const Header* hdr = (const Header*)addr;
+  std::size_t num_nodes = grid_nodes(hdr->dimension);
+  const char* err = nullptr;
+  if ( 0 != ::memcmp(hdr->magic, FIELDMAP_MAGIC, sizeof(hdr->magic)) )
+    err = "invalid magic word";
+  else if ( hdr->version != VERSION )
+    err = "incompatible version";
+  else if ( hdr->geometry != CARTESIAN && hdr->geometry != CYLINDRICAL )
+    err = "unknown grid geometry";
+  else if ( hdr->geometry == CYLINDRICAL && hdr->dimension[2] != 1 )
+    err = "cylindrical grids have no third axis";
+  else if ( num_nodes == 0 || hdr->data_size < num_nodes * sizeof(Node) )
+    err = "invalid grid dimensions";
+  else if ( (hdr->data_offset % 64) != 0 || hdr->data_offset > len || hdr->data_size > len - hdr->data_offset )
+    err = "invalid data area";
+  for( int i = 0; !err && i < 3; ++i )  {
+    if ( hdr->dimension[i] > 1 && !(hdr->step[i] > 0e0) )
+      err = "invalid node distance";
+  }
+  if ( err )  {
+    ::munmap(addr, len);
+    except("FieldMapField","+++ Invalid field map %s: %s", file_name.c_str(), err);
+  }
+  ::madvise(addr, len, MADV_WILLNEED);
+  if ( mapping )  {
+    ::munmap(mapping, mapping_size);
+  }
+  file         = file_name;
+  mapping      = addr;
+  mapping_size = len;
+  geometry     = hdr->geometry;
+  length_unit  = lunit;
+  field_unit   = funit;
+  nodes        = (const Node*)((const char*)addr + hdr->data_offset);
+  long s = 1;
+  for( int i = 0; i < 3; ++i )  {
+    dimension[i] = hdr->dimension[i];
+    start[i]     = hdr->start[i] * lunit;
+    inv_step[i]  = dimension[i] > 1 ? 1e0 / (hdr->step[i] * lunit) : 0e0;
+    stride[i]    = dimension[i] > 1 ? s : 0;
+    s *= dimension[i];
+  }
+  // In cylindrical grids only the z axis may be folded
+  if ( geometry == CYLINDRICAL ) fold &= 4;
+  printout(INFO,"FieldMapField","+++ Mapped %s field map %s: %ld x %ld x %ld nodes.",
+           geometry == CYLINDRICAL ? "cylindrical" : "cartesian", file_name.c_str(),
+           dimension[0], dimension[1], dimension[2]);
+}
+
+/// Map the grid file again after the field was read from a ROOT file
+void FieldMapField::remap()   {
+  if ( !mapping && !file.empty() )  {
+    load(file, length_unit, field_unit);
+  }
+}
+
+/// Compute the field components at a given location and add to given field
+void FieldMapField::fieldComponents(const double* pos, double* field) {
+  double q[3], u[3], w[3], sgn[3] = { 1e0, 1e0, 1e0 };
+  long   idx[3];
+
+  // Fold the coordinates on the symmetry axes. The components follow the parity of the axis
+  for( int a = 0; a < 3; ++a )  {
+    bool flip = ((fold >> a) & 1) && pos[a] < 0e0;
+    q[a] = flip ? -pos[a] : pos[a];
+    sgn[0] *= flip ? parity[a][0] : 1e0;
+    sgn[1] *= flip ? parity[a][1] : 1e0;
+    sgn[2] *= flip ? parity[a][2] : 1e0;
+  }
+  double r = 0e0;
+  if ( geometry == CYLINDRICAL )  {
+    r    = std::sqrt(q[0]*q[0] + q[1]*q[1]);
+    u[0] = r;
+    u[1] = q[2];
+    u[2] = 0e0;
+  }
+  else  {
+    u[0] = q[0];
+    u[1] = q[1];
+    u[2] = q[2];
+  }
+  for( int a = 0; a < 3; ++a )  {
+    double t = (u[a] - start[a]) * inv_step[a];
+    // Outside the grid (or NaN): no contribution
+    if ( !(t >= 0e0 && t <= double(dimension[a]-1)) ) return;
+    idx[a] = std::min(long(t), std::max(dimension[a]-2, 0L));
+    w[a]   = t - double(idx[a]);
+  }
+  const long  s0 = stride[0], s1 = stride[1], s2 = stride[2];
+  const Node* n  = nodes + idx[0]*s0 + idx[1]*s1 + idx[2]*s2;
+  const double v0 = 1e0 - w[0], v1 = 1e0 - w[1], v2 = 1e0 - w[2];
+  double b[3];
+  for( int c = 0; c < 3; ++c )  {
+    double c00 = n[0].b[c]        * v0 + n[s0].b[c]        * w[0];
+    double c10 = n[s1].b[c]       * v0 + n[s1+s0].b[c]     * w[0];
+    double c01 = n[s2].b[c]       * v0 + n[s2+s0].b[c]     * w[0];
+    double c11 = n[s2+s1].b[c]    * v0 + n[s2+s1+s0].b[c]  * w[0];
+    double c0  = c00 * v1 + c10 * w[1];
+    double c1  = c01 * v1 + c11 * w[1];
+    b[c] = (c0 * v2 + c1 * w[2]) * field_unit * sgn[c];
+  }
+  if ( geometry == CYLINDRICAL )  {
+    // Rotate (Br, Bphi) to the azimuth of the position. On the axis only Bz survives.
+    double inv_r = r > 0e0 ? 1e0/r : 0e0;
+    double cos_phi = pos[0] * inv_r, sin_phi = pos[1] * inv_r;
+    field[0] += b[0] * cos_phi - b[1] * sin_phi;
+    field[1] += b[0] * sin_phi + b[1] * cos_phi;
+    field[2] += b[2];
+    return;
+  }
+  field[0] += b[0];
+  field[1] += b[1];
+  field[2] += b[2];
+}
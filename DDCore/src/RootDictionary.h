@@ -677,6 +677,11 @@ template class dd4hep::Handle<TNamed>;
 #pragma link C++ class dd4hep::Handle<dd4hep::SolenoidField>+;
 #pragma link C++ class dd4hep::DipoleField+;
 #pragma link C++ class dd4hep::Handle<dd4hep::DipoleField>+;
+#pragma link C++ class dd4hep::FieldMapField+;
+#pragma link C++ class dd4hep::Handle<dd4hep::FieldMapField>+;
+// The node data is not persistent: map the grid file again after reading
+#pragma read sourceClass="dd4hep::FieldMapField" targetClass="dd4hep::FieldMapField" version="[1-]" \
+  source="" target="mapping" code="{ newObj->remap(); }"
 
 #pragma link C++ class dd4hep::IDDescriptor+;
 #pragma link C++ class dd4hep::IDDescriptorObject+;
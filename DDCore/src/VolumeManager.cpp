@@ -22,15 +22,31 @@
 
 // C/C++ includes
 #include <set>
+#include <memory>
+#include <algorithm>
 #include <cmath>
 #include <sstream>
 #include <iomanip>
+#include <mutex>
 
 using namespace dd4hep;
 using namespace dd4hep::detail;
 
 DD4HEP_INSTANTIATE_HANDLE_NAMED(VolumeManagerObject);
 
+namespace {
+  /// Lock serializing the lookups of volume managers populated on demand
+  std::recursive_mutex s_lazyLock;
+
+  /// Lock the access to a volume manager while subdetectors are pending (LAZY flag)
+  /** Once all subdetectors are populated the volume manager is read-only: no lock is taken. */
+  std::unique_lock<std::recursive_mutex> lazy_lock(const VolumeManagerObject& o)  {
+    if ( o.top && o.top->lazy.load(std::memory_order_acquire) )
+      return std::unique_lock<std::recursive_mutex>(s_lazyLock);
+    return std::unique_lock<std::recursive_mutex>();
+  }
+}
+
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
@@ -71,25 +87,28 @@ namespace dd4hep {
       /// Populate the Volume manager
       void populate(DetElement e) {
         //const char* typ = 0;//::getenv("VOLMGR_NEW");
+        //printout(INFO, "VolumeManager", "++ Executing %s plugin manager version",typ ? "***NEW***" : "***OLD***");
+        for (const auto& i : e.children() )
+          populate(e, i.second);
+      }
+
+      /// Populate the Volume manager with one subdetector (daughter of the top level element)
+      void populate(DetElement e, DetElement de) {
         SensitiveDetector parent_sd;
         if ( e->flag&DetElement::Object::HAVE_SENSITIVE_DETECTOR )  {
           parent_sd = m_detDesc.sensitiveDetector(e.name());
         }
-        //printout(INFO, "VolumeManager", "++ Executing %s plugin manager version",typ ? "***NEW***" : "***OLD***");
-        for (const auto& i : e.children() )  {
-          DetElement de = i.second;
-          PlacedVolume pv = de.placement();
-          if (pv.isValid()) {
-            Chain chain;
-            Encoding coding(0, 0);
-            SensitiveDetector sd = parent_sd;
-            m_entries.clear();
-            scanPhysicalVolume(de, de, pv, coding, sd, chain);
-            continue;
-          }
-          printout(WARNING, "VolumeManager", "++ Detector element %s of type %s has no placement.", 
-                   de.name(), de.type().c_str());
+        PlacedVolume pv = de.placement();
+        if (pv.isValid()) {
+          Chain chain;
+          Encoding coding(0, 0);
+          SensitiveDetector sd = parent_sd;
+          m_entries.clear();
+          scanPhysicalVolume(de, de, pv, coding, sd, chain);
+          return;
         }
+        printout(WARNING, "VolumeManager", "++ Detector element %s of type %s has no placement.", 
+                 de.name(), de.type().c_str());
       }
       /// Scan a single physical volume and look for sensitive elements below
       size_t scanPhysicalVolume(DetElement& parent, DetElement e, PlacedVolume pv, 
@@ -300,6 +319,14 @@ namespace dd4hep {
   }       /* End namespace detail                */
 }         /* End namespace dd4hep                */
 
+/// Assign the content of a ROOT matrix
+void VolumeManagerTransform::set(const TGeoMatrix& matrix)   {
+  const Double_t* r = matrix.GetRotationMatrix();
+  const Double_t* t = matrix.GetTranslation();
+  std::copy(r, r+9, rotation);
+  std::copy(t, t+3, translation);
+}
+
 /// Default destructor
 VolumeManagerContext::~VolumeManagerContext() {
   if ( 0 == flag ) return;
@@ -342,6 +369,11 @@ Position VolumeManagerContext::localToElement(const Position& local)  const   {
 
 /// Transform local coordinates to the world coordinates
 Position VolumeManagerContext::localToWorld(const double local[3])  const   {
+  if ( worldTrafo )  {
+    double world[3];
+    worldTrafo->localToWorld(local, world);
+    return { world[0], world[1], world[2] };
+  }
   double elt[3];
   toElement().LocalToMaster(local, elt);
   return element.nominal().localToWorld(elt);
@@ -403,8 +435,44 @@ VolumeManager::VolumeManager(const Detector& description, const std::string& nam
     obj_ptr->id    = ro.isValid() ? ro.idSpec() : IDDescriptor();
     obj_ptr->top   = obj_ptr;
     obj_ptr->flags = flags;
-    p.populate(elt);
-    node_count = p.numNodes();
+    if ( (flags & LAZY) == LAZY )  {
+      /// Subdetectors identified by their "system" field are scanned on first access
+      obj_ptr->description = &description;
+      for (const auto& i : elt.children() )  {
+        DetElement   de = i.second;
+        PlacedVolume pv = de.placement();
+        SensitiveDetector sd = description.sensitiveDetector(de.name());
+        const BitFieldElement* fld = 0;
+        FieldID sys_id = 0;
+        if ( pv.isValid() && sd.isValid() && sd.readout().isValid() )  {
+          const auto& ids = pv.volIDs();
+          auto vit = ids.find("system");
+          if ( vit != ids.end() )  {
+            fld    = sd.readout().idSpec().field(vit->first);
+            sys_id = vit->second;
+          }
+        }
+        if ( fld )   // Not identifiable subdetectors are scanned immediately
+          obj_ptr->pending.emplace_back(Object::PendingSection{ de, fld, sys_id });
+        else
+          p.populate(elt, de);
+      }
+      node_count = p.numNodes();
+      obj_ptr->lazy = !obj_ptr->pending.empty();
+      if ( (flags & (FROZEN|WORLD_CACHE)) != 0 )  {
+        node_count += obj_ptr->populate();
+      }
+    }
+    else  {
+      p.populate(elt);
+      node_count = p.numNodes();
+    }
+    if ( (flags & FROZEN) == FROZEN )  {
+      freeze();
+    }
+    if ( (flags & WORLD_CACHE) == WORLD_CACHE )  {
+      cacheWorldTransformations();
+    }
   }
   printout(INFO, "VolumeManager", " - populating volume ids - done. %ld nodes.",node_count);
 }
@@ -479,6 +547,8 @@ VolumeManager VolumeManager::addSubdetector(DetElement det, Readout ro) {
 VolumeManager VolumeManager::subdetector(VolumeID id) const {
   if (isValid()) {
     const Object& o = _data();
+    auto lock = lazy_lock(o);
+    if ( lock.owns_lock() ) o.top->populate(id);
     /// Need to perform a linear search, because the "system" tag width may vary between subdetectors
     for (const auto& j : o.subdetectors )  {
       const Object& mo = j.second._data();
@@ -510,6 +580,10 @@ IDDescriptor VolumeManager::idSpec() const {
 bool VolumeManager::adoptPlacement(VolumeID sys_id, VolumeManagerContext* context) {
   std::stringstream err;
   Object&  o      = _data();
+  if ( o.top && o.top->index )  {
+    except("VolumeManager","dd4hep: Failed to add new physical volume to detector: %s "
+           "[Volume manager is frozen]", o.detector.name());
+  }
   VolumeID vid    = context->identifier;
   VolumeID mask   = context->mask;
   PlacedVolume pv = context->elementPlacement();
@@ -601,6 +675,78 @@ bool VolumeManager::adoptPlacement(VolumeManagerContext* context) {
   return false;
 }
 
+/// Populate all subdetector sections, which were deferred by the LAZY flag.
+std::size_t VolumeManager::populate()  {
+  if ( isValid() )  {
+    Object& o = _data();
+    auto lock = lazy_lock(o);
+    return o.top->populate();
+  }
+  except("VolumeManager","dd4hep: Failed to populate volume manager [Invalid Manager Handle]");
+  return 0;
+}
+
+/// Build the read-only flat lookup index. No placements may be added afterwards.
+std::size_t VolumeManager::freeze()  {
+  if ( isValid() )  {
+    Object& o = _data();
+    if ( o.top != ptr() )  {
+      except("VolumeManager","dd4hep: Only the top level volume manager may be frozen.");
+    }
+    auto lock = lazy_lock(o);
+    o.populate();
+    if ( !o.index )  {
+      std::unique_ptr<VolumeManagerIndex> idx(new VolumeManagerIndex());
+      idx->add(o);
+      if ( (o.flags & ONE) != ONE )  {
+        for (const auto& j : o.subdetectors )
+          idx->add(j.second._data());
+      }
+      o.index = idx.release();
+      printout(INFO, "VolumeManager", " - frozen lookup index: %ld placements in %ld sections.",
+               o.index->keys.size(), o.index->sections.size());
+    }
+    return o.index->keys.size();
+  }
+  except("VolumeManager","dd4hep: Failed to freeze volume manager [Invalid Manager Handle]");
+  return 0;
+}
+
+/// Check if the flat lookup index was built
+bool VolumeManager::isFrozen()  const  {
+  return isValid() && _data().index != 0;
+}
+
+/// Cache the composed volume-to-world transformation of all placements.
+std::size_t VolumeManager::cacheWorldTransformations()   {
+  if ( isValid() )  {
+    Object& o = _data();
+    if ( o.top != ptr() )  {
+      except("VolumeManager","dd4hep: Only the top level volume manager may cache world transformations.");
+    }
+    auto lock = lazy_lock(o);
+    o.populate();
+    std::size_t count = o.updateTransforms();
+    for (const auto& j : o.subdetectors )
+      count += j.second._data().updateTransforms();
+    printout(INFO, "VolumeManager", " - cached %ld volume-to-world transformations.", count);
+    return count;
+  }
+  except("VolumeManager","dd4hep: Failed to cache world transformations [Invalid Manager Handle]");
+  return 0;
+}
+
+/// Check if the volume-to-world transformations are cached
+bool VolumeManager::hasWorldCache()  const  {
+  if ( isValid() )  {
+    const Object& o = _data();
+    if ( !o.top->transforms.empty() ) return true;
+    for (const auto& j : o.top->subdetectors )
+      if ( !j.second._data().transforms.empty() ) return true;
+  }
+  return false;
+}
+
 /// Lookup the context, which belongs to a registered physical volume.
 VolumeManagerContext* VolumeManager::lookupContext(VolumeID volume_id) const {
   if (isValid()) {
@@ -611,7 +757,16 @@ VolumeManagerContext* VolumeManager::lookupContext(VolumeID volume_id) const {
     if ( !is_top && one_tree ) {
       return VolumeManager(o.top).lookupContext(volume_id);
     }
+    /// LAZY mode: scan the subdetector on first access
+    auto lock = lazy_lock(o);
+    if ( is_top && lock.owns_lock() ) o.top->populate(volume_id);
     VolumeID id = volume_id;
+    /// If the flat index was built, it replaces the map lookups
+    if ( o.index )  {
+      if ((c = o.index->search(id)) != 0)
+        return c;
+      except("VolumeManager","lookupContext: Failed to search Volume context %016llX [Unknown identifier]", (void*)volume_id);
+    }
     /// First look in our own volume cache if the entry is found.
     c = o.search(id);
     if (c)
@@ -645,6 +800,8 @@ PlacedVolume VolumeManager::lookupVolumePlacement(VolumeID volume_id) const {
 DetElement VolumeManager::lookupDetector(VolumeID volume_id) const {
   if (isValid()) {
     const Object& o = _data();
+    auto lock = lazy_lock(o);
+    if ( lock.owns_lock() ) o.top->populate(volume_id);
     VolumeID      sys_id = 0;
     if ( o.system )   {
       sys_id = o.system->value(volume_id);
@@ -715,6 +872,8 @@ std::ostream& dd4hep::operator<<(std::ostream& os, const VolumeManager& mgr) {
 
 /// Default destructor
 VolumeManagerObject::~VolumeManagerObject() {
+  /// Cleanup lookup index (does not own the contexts)
+  detail::deletePtr(index);
   /// Cleanup volume tree
   destroyObjects(volumes);
   /// Cleanup dependent managers
@@ -732,6 +891,72 @@ void VolumeManagerObject::update(unsigned long tags, DetElement& det, void* para
   
   for(const auto& i : volumes )
     printout(DEBUG,"VolumeManager","+++ Alignment update %s",i.second->elementPlacement().name());
+
+  /// Refresh the cached world transformations if enabled
+  if ( DetElement::PLACEMENT_CHANGED == (tags&DetElement::PLACEMENT_CHANGED) )  {
+    if ( !transforms.empty() )
+      updateTransforms();
+    /// In 'ONE' mode all placements are registered with the top level manager
+    if ( top && top != this && (flags&VolumeManager::ONE) == VolumeManager::ONE && !top->transforms.empty() )
+      top->updateTransforms();
+  }
+}
+
+/// (Re-)compute the cached volume-to-world transformations of all placements
+std::size_t VolumeManagerObject::updateTransforms()   {
+  /// The block is allocated once: the contexts keep pointers to the entries
+  if ( transforms.size() != volumes.size() )  {
+    for(const auto& i : volumes ) i.second->worldTrafo = 0;
+    transforms.clear();
+    transforms.resize(volumes.size());
+  }
+  std::size_t count = 0;
+  for(const auto& i : volumes )  {
+    VolumeManagerContext*   ctxt = i.second;
+    VolumeManagerTransform& trafo = transforms[count++];
+    TGeoHMatrix world(ctxt->element.nominal().worldTransformation());
+    world.Multiply(&ctxt->toElement());
+    trafo.set(world);
+    ctxt->worldTrafo = &trafo;
+  }
+  return count;
+}
+
+/// Scan the pending subdetector containing the volume identifier. Unknown identifiers scan nothing
+std::size_t VolumeManagerObject::populate(VolumeID volume_id)   {
+  for( auto i = pending.begin(); i != pending.end(); ++i )  {
+    if ( i->system->value(volume_id) == i->sysID )  {
+      DetElement   de = i->detector;
+      VolumeManager mgr(this);
+      detail::VolumeManager_Populator p(*description, mgr);
+      pending.erase(i);
+      p.populate(detector, de);
+      printout(INFO, "VolumeManager", " - populated subdetector %s on demand: %ld nodes.",
+               de.name(), p.numNodes());
+      if ( pending.empty() )
+        lazy.store(false, std::memory_order_release);
+      return p.numNodes();
+    }
+  }
+  return 0;
+}
+
+/// Scan all pending subdetectors
+std::size_t VolumeManagerObject::populate()   {
+  std::size_t count = 0;
+  if ( !pending.empty() )  {
+    VolumeManager mgr(this);
+    detail::VolumeManager_Populator p(*description, mgr);
+    std::vector<PendingSection> dets;
+    dets.swap(pending);
+    for( const auto& sec : dets )
+      p.populate(detector, sec.detector);
+    count = p.numNodes();
+    printout(INFO, "VolumeManager", " - populated %ld pending subdetectors on demand: %ld nodes.",
+             dets.size(), count);
+    lazy.store(false, std::memory_order_release);
+  }
+  return count;
 }
 
 /// Search the locally cached volumes for a matching ID
@@ -740,3 +965,33 @@ VolumeManagerContext* VolumeManagerObject::search(const VolumeID& vol_id) const
   return (i == volumes.end()) ? 0 : (*i).second;
 }
 
+
+/// Add all placements of a volume manager as a new section
+void VolumeManagerIndex::add(const VolumeManagerObject& manager)   {
+  Section sec;
+  sec.mask  = manager.detMask;
+  sec.begin = keys.size();
+  keys.reserve(keys.size() + manager.volumes.size());
+  contexts.reserve(contexts.size() + manager.volumes.size());
+  /// The map is ordered by the volume identifier: the section is already sorted
+  for ( const auto& v : manager.volumes )  {
+    keys.emplace_back(v.first);
+    contexts.emplace_back(v.second);
+  }
+  sec.end = keys.size();
+  if ( sec.end > sec.begin )  {
+    sections.emplace_back(sec);
+  }
+}
+
+/// Search the index for a matching ID
+VolumeManagerContext* VolumeManagerIndex::search(VolumeID vol_id) const   {
+  const VolumeID* k = keys.data();
+  for ( const auto& sec : sections )  {
+    VolumeID key = vol_id&sec.mask;
+    const VolumeID* i = std::lower_bound(k + sec.begin, k + sec.end, key);
+    if ( i != k + sec.end && *i == key )
+      return contexts[i - k];
+  }
+  return 0;
+}
@@ -37,6 +37,7 @@
 
 #include <XML/DocumentHandler.h>
 #include <XML/Utilities.h>
+#include "GeometryBuildCache.h"
 
 // Root/TGeo include files
 #include <TGeoManager.h>
@@ -49,6 +50,7 @@
 #include <filesystem>
 #include <iostream>
 #include <climits>
+#include <memory>
 #include <set>
 
 using namespace dd4hep;
@@ -281,6 +283,48 @@ static Ref_t create_MultipoleField(Detector& description, xml_h e) {
 }
 DECLARE_XMLELEMENT(MultipoleMagnet,create_MultipoleField)
 
+/** Gridded magnetic field map from a binary file.
+ *
+ *  <field name="Map" type="FieldMap" file="field.bin" lunit="mm" funit="tesla">
+ *    <symmetry axis="z" x="-1" y="-1" z="1"/>
+ *  </field>
+ *
+ *  Relative file names are resolved with respect to the xml document.
+ *  The symmetry entries fold the named axis. The attributes x,y,z are the
+ *  parities of the three stored components (Br,Bphi,Bz for cylindrical grids).
+ */
+static Ref_t create_FieldMap(Detector& /* description */, xml_h e) {
+  xml_dim_t       c(e);
+  CartesianField  obj;
+  FieldMapField*  ptr   = new FieldMapField();
+  double          lunit = c.hasAttr(_U(lunit)) ? c.attr<double>(_U(lunit)) : dd4hep::mm;
+  double          funit = c.hasAttr(_U(funit)) ? c.attr<double>(_U(funit)) : dd4hep::tesla;
+  std::string     fname = c.attr<std::string>(_U(file));
+  std::error_code ec;
+
+  for (xml_coll_t coll(c, _Unicode(symmetry)); coll; ++coll) {
+    xml_dim_t   sym  = coll;
+    std::string axis = sym.attr<std::string>(_U(axis));
+    int         idx  = axis == "x" ? 0 : axis == "y" ? 1 : axis == "z" ? 2 : -1;
+    if ( idx < 0 )  {
+      except("Compact","++ FieldMap %s: Invalid symmetry axis: '%s'",
+             c.nameStr().c_str(), axis.c_str());
+    }
+    ptr->fold |= (1 << idx);
+    ptr->parity[idx][0] = sym.x(1e0);
+    ptr->parity[idx][1] = sym.y(1e0);
+    ptr->parity[idx][2] = sym.z(1e0);
+  }
+  if ( !std::filesystem::exists(fname, ec) )  {
+    fname = xml::DocumentHandler::system_path(e, fname);
+  }
+  ptr->load(fname, lunit, funit);
+  ptr->field_type = CartesianField::MAGNETIC;
+  obj.assign(ptr, c.nameStr(), c.typeStr());
+  return obj;
+}
+DECLARE_XMLELEMENT(FieldMap,create_FieldMap)
+
 static long load_Compact(Detector& description, xml_h element) {
   Converter<Compact>converter(description);
   converter(element);
@@ -1703,7 +1747,9 @@ template <> void Converter<DetElementInclude>::operator()(xml_h element) const {
 /// Main compact conversion entry point
 template <> void Converter<Compact>::operator()(xml_h element) const {
   static int num_calls = 0;
-  std::string close_option;
+  static const char* env_cache = ::getenv("DD4HEP_GEOMETRY_CACHE");
+  std::unique_ptr<detail::GeometryBuildCache> cache;
+  std::string close_option, cache_dir(env_cache ? env_cache : "");
   char text[32];
 
   ++num_calls;
@@ -1729,6 +1775,8 @@ template <> void Converter<Compact>::operator()(xml_h element) const {
       build_reflections = steer.attr<bool>(_U(reflect));
     if ( steer.hasAttr(_U(option))  )
       close_option = steer.attr<std::string>(_U(option));
+    if ( steer.hasAttr(_Unicode(cache)) )
+      cache_dir = steer.attr<std::string>(_Unicode(cache));
 
     for (xml_coll_t clr(steer, _U(clear)); clr; ++clr) {
       std::string nam = clr.hasAttr(_U(name)) ? clr.attr<std::string>(_U(name)) : std::string();
@@ -1745,6 +1793,21 @@ template <> void Converter<Compact>::operator()(xml_h element) const {
     }
   }
 
+  /// A complete geometry built from scratch may be taken from the build cache
+  if ( num_calls == 1 && !cache_dir.empty() && open_geometry && close_document &&
+       description.state() == Detector::NOT_READY )   {
+    cache = std::make_unique<detail::GeometryBuildCache>(description, compact, cache_dir);
+    if ( cache->load() )   {
+      description.endDocument(close_geometry ? (close_option + "close").c_str() : close_option.c_str());
+      /// Plugins act on the geometry in memory: they are not cached
+      xml_coll_t(compact, _U(plugins)).for_each(_U(plugin),  Converter<Plugin>  (description));
+      xml_coll_t(compact, _U(plugins)).for_each(_U(include), Converter<XMLFile> (description));
+      xml_coll_t(compact, _U(plugins)).for_each(_U(xml),     Converter<XMLFile> (description));
+      --num_calls;
+      return;
+    }
+  }
+
   if ( s_debug.materials || s_debug.elements )   {
     printout(INFO,"Compact","+++ UNIT System:");
     printout(INFO,"Compact","+++ Density:    %8.3g  Units:%8.3g",
@@ -1821,6 +1884,9 @@ template <> void Converter<Compact>::operator()(xml_h element) const {
     ReflectionBuilder rb(description);
     rb.execute();
   }
+  if ( cache && description.state() == Detector::READY )   {
+    cache->save();
+  }
   /// Load plugin and process them as indicated
   xml_coll_t(compact, _U(plugins)).for_each(_U(plugin),  Converter<Plugin>  (description));
   xml_coll_t(compact, _U(plugins)).for_each(_U(include), Converter<XMLFile> (description));
@@ -28,6 +28,7 @@
 #include <TClass.h>
 #include <TColor.h>
 #include <TGeoBoolNode.h>
+#include <TGeoCompositeShape.h>
 #include <TGeoSystemOfUnits.h>
 
 // C/C++ include files
@@ -37,6 +38,11 @@
 #include <iomanip>
 #include <cfloat>
 #include <cfenv>
+#include <cmath>
+#include <cstring>
+#include <atomic>
+#include <thread>
+#include <algorithm>
 
 using namespace dd4hep;
 using DetectorChecksum = dd4hep::detail::DetectorChecksum;
@@ -1367,6 +1373,317 @@ void DetectorChecksum::dump_detelements()   const   {
   }
 }
 
+namespace {
+
+  /// Canonical binary record of one geometry object
+  /**
+   *  \author  agent
+   *  \version 1.0
+   *  \ingroup DD4HEP_CORE
+   */
+  class BinaryRecord  {
+    std::string bytes;
+    double      scale;
+  public:
+    /// Initializing constructor: the tag identifies the object type
+    BinaryRecord(double s, char tag) : scale(s)  {
+      bytes.reserve(256);
+      bytes += tag;
+    }
+    /// Add integer value as 8 byte little-endian word
+    BinaryRecord& integer(int64_t value)  {
+      uint64_t v = uint64_t(value);
+      for( int i = 0; i < 8; ++i, v >>= 8 )
+        bytes += char(v & 0xFF);
+      return *this;
+    }
+    /// Add hash code of a constituent
+    BinaryRecord& hash(uint64_t value)  {
+      return integer(int64_t(value));
+    }
+    /// Add floating point value rounded to a fixed point number
+    BinaryRecord& real(double value)  {
+      double fixed = value * scale;
+      if ( std::isfinite(fixed) && std::fabs(fixed) < 9e18 )  {
+        bytes += 'D';
+        return integer(std::llround(fixed));
+      }
+      /// Not representable with fixed precision: take the bit pattern
+      uint64_t bits = 0;
+      std::memcpy(&bits, &value, sizeof(bits));
+      bytes += 'B';
+      return hash(bits);
+    }
+    /// Add a set of floating point values
+    BinaryRecord& reals(const std::vector<double>& values)  {
+      integer(values.size());
+      for( double v : values ) real(v);
+      return *this;
+    }
+    /// Add string value
+    BinaryRecord& text(const std::string& value)  {
+      integer(value.length());
+      bytes += value;
+      return *this;
+    }
+    /// Hash code of the record
+    uint64_t checksum()  const  {
+      return detail::hash64(bytes.data(), bytes.length());
+    }
+  };
+
+  /// Object name without the pointer suffix added by some factories
+  std::string binary_ref_name(const std::string& nam)  {
+    std::size_t idx = nam.find("_0x");
+    return idx == std::string::npos ? nam : nam.substr(0, idx);
+  }
+}
+
+/// Initializing constructor
+detail::DetectorChecksumBinary::DetectorChecksumBinary(Detector& description)
+  : m_detDesc(description)
+{
+}
+
+/// Apply the properties
+void detail::DetectorChecksumBinary::configure()   {
+  m_scale = std::pow(10e0, precision);
+  if ( num_threads < 1 ) num_threads = 1;
+}
+
+/// Hash code of the detector header
+detail::DetectorChecksumBinary::hash_t detail::DetectorChecksumBinary::hashHeader()  const  {
+  BinaryRecord rec(m_scale, 'H');
+  Header hdr = m_detDesc.header();
+  if ( hdr.isValid() )  {
+    rec.text(hdr.name()).text(hdr.author()).text(hdr.version()).text(hdr.url()).text(hdr.comment());
+  }
+  return rec.checksum();
+}
+
+/// Hash code of a chemical element
+detail::DetectorChecksumBinary::hash_t
+detail::DetectorChecksumBinary::hashElement(const TGeoElement* element, Cache& cache)  const  {
+  auto it = cache.find(element);
+  if ( it != cache.end() ) return it->second;
+  BinaryRecord rec(m_scale, 'E');
+  rec.text(element->GetName()).integer(element->Z()).integer(element->N()).real(element->A());
+  return cache.emplace(element, rec.checksum()).first->second;
+}
+
+/// Hash code of a material
+detail::DetectorChecksumBinary::hash_t
+detail::DetectorChecksumBinary::hashMaterial(Material material, Cache& cache)  const  {
+  if ( !material.isValid() ) return 0;
+  auto it = cache.find(material.ptr());
+  if ( it != cache.end() ) return it->second;
+  const TGeoMaterial* mat = material->GetMaterial();
+  BinaryRecord rec(m_scale, 'M');
+  rec.text(binary_ref_name(mat->GetName()))
+    .real(mat->GetDensity()).real(mat->GetTemperature()).real(mat->GetPressure())
+    .integer(mat->GetState());
+  if ( mat->IsMixture() )  {
+    /// Composition in a canonical order: sorted by element name
+    const TGeoMixture* mix = static_cast<const TGeoMixture*>(mat);
+    std::vector<std::pair<std::string, std::pair<hash_t, double> > > composition;
+    for( int i = 0, n = mix->GetNelements(); i < n; ++i )  {
+      const TGeoElement* elt = mix->GetElement(i);
+      composition.emplace_back(elt->GetName(), std::make_pair(hashElement(elt, cache), mix->GetWmixt()[i]));
+    }
+    std::sort(composition.begin(), composition.end());
+    rec.integer(composition.size());
+    for( const auto& c : composition )
+      rec.hash(c.second.first).real(c.second.second);
+  }
+  else if ( mat->GetElement() )  {
+    rec.integer(1).hash(hashElement(mat->GetElement(), cache));
+  }
+  return cache.emplace(material.ptr(), rec.checksum()).first->second;
+}
+
+/// Hash code of a solid. Boolean solids are hashed recursively
+detail::DetectorChecksumBinary::hash_t
+detail::DetectorChecksumBinary::hashSolid(const TGeoShape* shape, Cache& cache)  const  {
+  if ( !shape ) return 0;
+  auto it = cache.find(shape);
+  if ( it != cache.end() ) return it->second;
+  BinaryRecord rec(m_scale, 'S');
+  rec.text(binary_ref_name(shape->GetName())).text(get_shape_tag(shape));
+  if ( shape->IsA() == TGeoCompositeShape::Class() )   {
+    const TGeoBoolNode* boolean = static_cast<const TGeoCompositeShape*>(shape)->GetBoolNode();
+    rec.integer(boolean->GetBooleanOperator())
+      .hash(hashSolid(boolean->GetLeftShape(),  cache))
+      .hash(hashMatrix(boolean->GetLeftMatrix()))
+      .hash(hashSolid(boolean->GetRightShape(), cache))
+      .hash(hashMatrix(boolean->GetRightMatrix()));
+  }
+  else if ( shape->IsA() != TGeoTessellated::Class() || hash_meshes )   {
+    rec.reals(get_shape_dimensions(const_cast<TGeoShape*>(shape)));
+  }
+  return cache.emplace(shape, rec.checksum()).first->second;
+}
+
+/// Hash code of a transformation matrix
+detail::DetectorChecksumBinary::hash_t
+detail::DetectorChecksumBinary::hashMatrix(const TGeoMatrix* matrix)  const  {
+  BinaryRecord rec(m_scale, 'T');
+  if ( matrix )  {
+    const Double_t* t = matrix->GetTranslation();
+    const Double_t* r = matrix->GetRotationMatrix();
+    for( int i = 0; i < 3; ++i ) rec.real(t[i]);
+    for( int i = 0; i < 9; ++i ) rec.real(r[i]);
+  }
+  return rec.checksum();
+}
+
+/// Hash code of a logical volume including all daughter placements
+detail::DetectorChecksumBinary::hash_t
+detail::DetectorChecksumBinary::hashVolume(Volume volume, Cache& cache)  const  {
+  auto it = cache.find(volume.ptr());
+  if ( it != cache.end() ) return it->second;
+  bool assembly = volume->IsAssembly();
+  BinaryRecord rec(m_scale, assembly ? 'A' : 'V');
+  rec.text(binary_ref_name(volume.name())).hash(hashSolid(volume->GetShape(), cache));
+  if ( !assembly )  {
+    rec.hash(hashMaterial(volume.material(), cache));
+  }
+  if ( volume.data() )  {
+    Region            reg = volume.region();
+    LimitSet          lim = volume.limitSet();
+    VisAttr           vis = volume.visAttributes();
+    SensitiveDetector sd  = volume.sensitiveDetector();
+    rec.text(reg.isValid() ? reg.name() : "")
+      .text(lim.isValid() ? lim.name() : "")
+      .text(vis.isValid() ? vis.name() : "")
+      .text(sd.isValid()  ? sd.name()  : "");
+  }
+  const TObjArray* dau = volume->GetNodes();
+  Int_t num_dau = dau ? dau->GetEntries() : 0;
+  rec.integer(num_dau);
+  for( Int_t i = 0; i < num_dau; ++i )
+    rec.hash(hashPlacement(reinterpret_cast<TGeoNode*>(dau->At(i)), cache));
+  return cache.emplace(volume.ptr(), rec.checksum()).first->second;
+}
+
+/// Hash code of a volume placement
+detail::DetectorChecksumBinary::hash_t
+detail::DetectorChecksumBinary::hashPlacement(PlacedVolume placement, Cache& cache)  const  {
+  if ( !placement.isValid() ) return 0;
+  auto it = cache.find(placement.ptr());
+  if ( it != cache.end() ) return it->second;
+  BinaryRecord rec(m_scale, 'P');
+  rec.text(binary_ref_name(placement.name()))
+    .hash(hashVolume(placement.volume(), cache))
+    .hash(hashMatrix(placement->GetMatrix()));
+  if ( placement.data() )  {
+    const auto& ids = placement.volIDs();
+    rec.integer(ids.size());
+    for( const auto& id : ids )
+      rec.text(id.first).integer(id.second);
+  }
+  return cache.emplace(placement.ptr(), rec.checksum()).first->second;
+}
+
+/// Hash code of the readout of a sensitive detector
+detail::DetectorChecksumBinary::hash_t
+detail::DetectorChecksumBinary::hashReadout(SensitiveDetector sensitive, Cache& cache)  const  {
+  if ( !sensitive.isValid() ) return 0;
+  auto it = cache.find(sensitive.ptr());
+  if ( it != cache.end() ) return it->second;
+  using param_t = DDSegmentation::SegmentationParameter;
+  BinaryRecord rec(m_scale, 'R');
+  rec.text(sensitive.name()).text(sensitive.type())
+    .real(sensitive.energyCutoff()).integer(sensitive.combineHits());
+  Readout ro = sensitive.readout();
+  if ( ro.isValid() )  {
+    IDDescriptor id_spec = ro.idSpec();
+    Segmentation seg     = ro.segmentation();
+    rec.text(ro.name()).text(id_spec.isValid() ? id_spec.fieldDescription() : "");
+    if ( seg.isValid() )  {
+      rec.text(seg.type());
+      for( const auto* p : seg.parameters() )  {
+        rec.text(p->name());
+        if ( p->unitType() == param_t::LengthUnit || p->unitType() == param_t::AngleUnit )
+          rec.real(_toDouble(p->value()));
+        else
+          rec.text(p->value());
+      }
+    }
+  }
+  return cache.emplace(sensitive.ptr(), rec.checksum()).first->second;
+}
+
+/// Hash code of a DetElement subtree
+detail::DetectorChecksumBinary::hash_t
+detail::DetectorChecksumBinary::hashDetElement(DetElement detector, Cache& cache)  const  {
+  auto it = cache.find(detector.ptr());
+  if ( it != cache.end() ) return it->second;
+  BinaryRecord rec(m_scale, 'D');
+  rec.text(detector.name()).integer(detector.id()).text(detector.type())
+    .integer(detector.typeFlag())
+    .hash(hashPlacement(detector.placement(), cache));
+  if ( hash_readout )  {
+    rec.hash(hashReadout(m_detDesc.sensitiveDetector(detector.name()), cache));
+  }
+  /// Children are ordered by name
+  const auto& children = detector.children();
+  rec.integer(children.size());
+  for( const auto& c : children )
+    rec.hash(hashDetElement(c.second, cache));
+  return cache.emplace(detector.ptr(), rec.checksum()).first->second;
+}
+
+/// Hash independent DetElement subtrees in parallel. The worker caches are merged into 'cache'
+std::vector<detail::DetectorChecksumBinary::Result>
+detail::DetectorChecksumBinary::hashSubtrees(const std::vector<DetElement>& detectors, Cache& cache)  const  {
+  std::vector<Result> results(detectors.size());
+  std::size_t num_workers = std::min(std::size_t(num_threads), detectors.size());
+  if ( num_workers <= 1 )  {
+    for( std::size_t i = 0; i < detectors.size(); ++i )
+      results[i] = { detectors[i], hashDetElement(detectors[i], cache) };
+    return results;
+  }
+  /// The geometry is only read: workers share nothing but the index of the next subtree.
+  /// Class()/IsA() and the TGeo shape accessors use ROOT internals, which must be thread safe
+  ROOT::EnableThreadSafety();
+  std::atomic<std::size_t>  next { 0 };
+  std::vector<Cache>        caches(num_workers);
+  std::vector<std::thread>  workers;
+  std::vector<std::exception_ptr> errors(num_workers);
+  for( std::size_t w = 0; w < num_workers; ++w )  {
+    workers.emplace_back([this, w, &next, &detectors, &results, &caches, &errors]()  {
+      try  {
+        for( std::size_t i = next++; i < detectors.size(); i = next++ )
+          results[i] = { detectors[i], hashDetElement(detectors[i], caches[w]) };
+      }
+      catch(...)  {
+        errors[w] = std::current_exception();
+      }
+    });
+  }
+  for( auto& w : workers ) w.join();
+  for( auto& e : errors )  {
+    if ( e ) std::rethrow_exception(e);
+  }
+  for( auto& c : caches )
+    cache.insert(c.begin(), c.end());
+  return results;
+}
+
+/// Full checksum of the detector description: subdetectors are hashed in parallel
+detail::DetectorChecksumBinary::hash_t
+detail::DetectorChecksumBinary::checksum(std::vector<Result>& subdetectors, Cache& cache)  const  {
+  DetElement world = m_detDesc.world();
+  std::vector<DetElement> detectors;
+  for( const auto& c : world.children() )
+    detectors.emplace_back(c.second);
+  subdetectors = hashSubtrees(detectors, cache);
+  /// The world tree re-uses the cached subdetector hashes
+  BinaryRecord rec(m_scale, 'W');
+  rec.hash(hashHeader()).hash(hashDetElement(world, cache));
+  return rec.checksum();
+}
+
 static long create_checksum(Detector& description, int argc, char** argv) {
   std::vector<std::string> detectors;
   int precision = 6, newline = 1, level = 1, meshes = 0, readout = 0, debug = 0;
@@ -1375,6 +1692,7 @@ static long create_checksum(Detector& description, int argc, char** argv) {
   int dump_iddesc = 0, dump_segmentations = 0, dump_pos = 0;
   int dump_rot = 0;
   int have_hash_strings = 0, reorder = 0, write_files = 0;
+  int binary = 0, threads = 1, compare_threads = 0;
   std::string len_unit, ang_unit, ene_unit, dens_unit, atom_unit;
 
   for(int i = 0; i < argc && argv[i]; ++i)  {
@@ -1430,6 +1748,12 @@ static long create_checksum(Detector& description, int argc, char** argv) {
       reorder = 1;
     else if ( 0 == ::strncmp("-keep_hashes",argv[i],8) )
       have_hash_strings = 1;
+    else if ( 0 == ::strncmp("-binary",argv[i],4) )
+      binary = 1;
+    else if ( 0 == ::strncmp("-threads",argv[i],5) && (i+1)<argc )
+      threads = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-compare_threads",argv[i],10) && (i+1)<argc )
+      compare_threads = ::atol(argv[++i]);
     else  {
       std::cout <<
         "Usage: -plugin DD4hepDetectorChecksum -arg [-arg]                             \n\n"
@@ -1444,6 +1768,12 @@ static long create_checksum(Detector& description, int argc, char** argv) {
         "                            Useful for debugging and -dump_<x> options.         \n"
         "     -precsision <digits>   Set floating point precision after comma            \n"
         "                            for the checsum calculation.                        \n"
+        "     -binary                hash canonical binary records (Merkle tree).        \n"
+        "                            Hash codes differ from the default text mode.       \n"
+        "     -threads <number>      Number of threads hashing subdetectors in parallel  \n"
+        "                            (binary mode only). Default: 1                      \n"
+        "     -compare_threads <n>   Recompute the binary checksum with n threads and    \n"
+        "                            fail if the results differ.                         \n"
         "                                                                                \n"
         "   Debugging: Dump individual hash codes (debug>=1)                             \n"
         "   Debugging: and the hashed string (debug>2)                                   \n"
@@ -1475,6 +1805,55 @@ static long create_checksum(Detector& description, int argc, char** argv) {
       ::exit(EINVAL);
     }
   }
+  if ( binary )   {
+    typedef detail::DetectorChecksumBinary::hash_t hash_t;
+    std::vector<DetElement> subtrees;
+    for (const auto& det : detectors )
+      subtrees.emplace_back(detail::tools::findElement(description, det));
+    /// Compute the binary checksum with a given number of threads
+    auto compute = [&](int num_threads, std::vector<detail::DetectorChecksumBinary::Result>& results,
+                       std::size_t& num_objects)   {
+      detail::DetectorChecksumBinary bin(description);
+      detail::DetectorChecksumBinary::Cache cache;
+      bin.precision    = precision;
+      bin.hash_meshes  = meshes;
+      bin.hash_readout = readout;
+      bin.num_threads  = num_threads;
+      bin.configure();
+      hash_t checksum = 0;
+      if ( !subtrees.empty() )
+        results = bin.hashSubtrees(subtrees, cache);
+      else
+        checksum = bin.checksum(results, cache);
+      num_objects = cache.size();
+      return checksum;
+    };
+    std::vector<detail::DetectorChecksumBinary::Result> results;
+    std::size_t num_objects = 0;
+    hash_t checksum = compute(threads, results, num_objects);
+    for ( const auto& r : results )
+      printout(ALWAYS,"DetectorChecksum","+++ Binary checksum for %s 0x%016lx",
+               r.detector.path().c_str(), r.hash);
+    if ( detectors.empty() )
+      printout(ALWAYS,"DetectorChecksum","+++ Binary checksum for %s 0x%016lx  (%ld objects, %d threads)",
+               description.world().path().c_str(), checksum, num_objects, threads);
+    if ( compare_threads > 0 )   {
+      std::vector<detail::DetectorChecksumBinary::Result> ref_results;
+      std::size_t ref_objects = 0;
+      hash_t ref_checksum = compute(compare_threads, ref_results, ref_objects);
+      bool identical = ref_checksum == checksum && ref_results.size() == results.size();
+      for ( std::size_t i = 0; identical && i < results.size(); ++i )
+        identical = ref_results[i].detector == results[i].detector && ref_results[i].hash == results[i].hash;
+      if ( !identical )  {
+        except("DetectorChecksum","+++ Binary checksum with %d threads 0x%016lx differs from %d threads 0x%016lx",
+               compare_threads, ref_checksum, threads, checksum);
+      }
+      printout(ALWAYS,"DetectorChecksum","+++ Binary checksum identical with %d and %d threads: 0x%016lx",
+               threads, compare_threads, checksum);
+    }
+    return 1;
+  }
+
   DetectorChecksum wr(description);
   DetElement de = description.world();
   wr.precision = precision;
@@ -20,6 +20,8 @@
 
 /// C/C++ include files
 #include <sstream>
+#include <unordered_map>
+#include <vector>
 
 /// Forward declarations
 
@@ -232,6 +234,81 @@ namespace dd4hep {
       void dump_sensitives()   const;
 
     };
+    /// Checksum engine hashing canonical binary records of the geometry objects
+    /**
+     *  Every object is serialized to a canonical binary record: integers as 8 byte
+     *  little-endian words, strings with their length and floating point values
+     *  rounded to fixed point numbers with 'precision' digits after the comma
+     *  (in DD4hep units). Composite objects only record the hash codes of their
+     *  constituents (Merkle tree): the hash of a DetElement covers the hashes of its
+     *  placement, its readout and its children.
+     *
+     *  Independent subdetector trees are hashed concurrently. Each worker owns a
+     *  private cache of the hash codes of shared objects; the caches are merged
+     *  once all subtrees are done. The result does not depend on the number of threads.
+     *
+     *  The hash codes differ from the codes of the text based DetectorChecksum.
+     *
+     *  \author  agent
+     *  \version 1.0
+     *  \ingroup DD4HEP_CORE
+     */
+    class DetectorChecksumBinary  {
+    public:
+      using hash_t = uint64_t;
+      /// Cache of the hash codes of shared objects (materials, solids, volumes, ...)
+      using Cache  = std::unordered_map<const void*, hash_t>;
+      /// Hash code of one DetElement subtree
+      struct Result  {
+        DetElement  detector;
+        hash_t      hash { 0 };
+      };
+
+      /// Reference to detector description
+      Detector&   m_detDesc;
+      /// Scale factor to convert floating point values to fixed point numbers
+      double      m_scale       { 1e6 };
+      /// Property: Number of digits after the comma retained
+      int         precision     { 6 };
+      /// Property: Include the tessellated solids' facets
+      int         hash_meshes   { 0 };
+      /// Property: Include the readout (sensitive detector, id descriptor, segmentation)
+      int         hash_readout  { 0 };
+      /// Property: Number of worker threads used to hash independent subtrees
+      int         num_threads   { 1 };
+
+    public:
+      /// Initializing constructor
+      DetectorChecksumBinary(Detector& description);
+      /// Default destructor
+      ~DetectorChecksumBinary() = default;
+      /// Apply the properties
+      void configure();
+
+      /// Hash code of the detector header
+      hash_t hashHeader()  const;
+      /// Hash code of a chemical element
+      hash_t hashElement(const TGeoElement* element, Cache& cache)  const;
+      /// Hash code of a material
+      hash_t hashMaterial(Material material, Cache& cache)  const;
+      /// Hash code of a solid. Boolean solids are hashed recursively
+      hash_t hashSolid(const TGeoShape* solid, Cache& cache)  const;
+      /// Hash code of a transformation matrix
+      hash_t hashMatrix(const TGeoMatrix* matrix)  const;
+      /// Hash code of a logical volume including all daughter placements
+      hash_t hashVolume(Volume volume, Cache& cache)  const;
+      /// Hash code of a volume placement
+      hash_t hashPlacement(PlacedVolume placement, Cache& cache)  const;
+      /// Hash code of the readout of a sensitive detector
+      hash_t hashReadout(SensitiveDetector sensitive, Cache& cache)  const;
+      /// Hash code of a DetElement subtree
+      hash_t hashDetElement(DetElement detector, Cache& cache)  const;
+
+      /// Hash independent DetElement subtrees in parallel. The worker caches are merged into 'cache'
+      std::vector<Result> hashSubtrees(const std::vector<DetElement>& detectors, Cache& cache)  const;
+      /// Full checksum of the detector description: subdetectors are hashed in parallel
+      hash_t checksum(std::vector<Result>& subdetectors, Cache& cache)  const;
+    };
   }    // End namespace xml
 }      // End namespace dd4hep
 #endif // DDCORE_SRC_PLUGINS_DETECTORCHECKSUM_H
@@ -0,0 +1,180 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : agent
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/Detector.h>
+#include <DD4hep/Factories.h>
+#include <DD4hep/Printout.h>
+#include <DD4hep/FieldTypes.h>
+#include <DD4hep/DD4hepUnits.h>
+
+// C/C++ include files
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <cerrno>
+#include <iostream>
+
+using namespace dd4hep;
+
+/// Sample the magnetic field of the detector description on a regular grid and write a field map
+/**
+ *  Factory: DD4hep_FieldMapWriter
+ *
+ *  Usage: geoPluginRun -input <compact.xml> -plugin DD4hep_FieldMapWriter -output <file>
+ *                      [-cylindrical] -start <x> <y> <z> -step <dx> <dy> <dz> -nodes <nx> <ny> <nz>
+ *
+ *  For cylindrical grids the axes are (r,z): the field is sampled at (r,0,z)
+ *  and stored as (Br,Bphi,Bz). Lengths are stored in mm, the field in tesla.
+ *
+ *  \author  agent
+ *  \version 1.0
+ */
+static long write_field_map(Detector& description, int argc, char** argv)  {
+  std::string output;
+  int         geometry = FieldMapField::CARTESIAN;
+  double      start[3] = { 0e0, 0e0, 0e0 }, step[3] = { 1e0, 1e0, 1e0 };
+  unsigned    nodes[3] = { 0, 0, 0 };
+  for(int i = 0; i < argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-output",argv[i],4) && i+1 < argc )
+      output = argv[++i];
+    else if ( 0 == ::strncmp("-cylindrical",argv[i],4) )
+      geometry = FieldMapField::CYLINDRICAL;
+    else if ( 0 == ::strncmp("-start",argv[i],4) && i+3 < argc )  {
+      for( int j = 0; j < 3; ++j ) start[j] = _toDouble(argv[++i]);
+    }
+    else if ( 0 == ::strncmp("-step",argv[i],4) && i+3 < argc )  {
+      for( int j = 0; j < 3; ++j ) step[j] = _toDouble(argv[++i]);
+    }
+    else if ( 0 == ::strncmp("-nodes",argv[i],4) && i+3 < argc )  {
+      for( int j = 0; j < 3; ++j ) nodes[j] = _toUInt(argv[++i]);
+    }
+    else  {
+      output.clear();
+      break;
+    }
+  }
+  if ( geometry == FieldMapField::CYLINDRICAL ) nodes[2] = 1;
+  if ( output.empty() || nodes[0] == 0 || nodes[1] == 0 || nodes[2] == 0 )  {
+    std::cout <<
+      "Usage: -plugin DD4hep_FieldMapWriter  -arg [-arg]                              \n\n"
+      "     Sample the magnetic field on a regular grid and write a binary field map.  \n\n"
+      "     -output <file>         Output file name.                                   \n"
+      "     -cylindrical           Grid axes are (r,z). Default: cartesian (x,y,z).    \n"
+      "     -start  <x> <y> <z>    Position of the first node.                         \n"
+      "     -step   <x> <y> <z>    Node distance.                                      \n"
+      "     -nodes  <x> <y> <z>    Number of nodes per axis.                           \n"
+      "     Arguments given: " << arguments(argc,argv) << std::endl << std::flush;
+    ::exit(EINVAL);
+  }
+  OverlayedField    field = description.field();
+  std::vector<float> values;
+  double            first[3], dist[3];
+  values.reserve(3*std::size_t(nodes[0])*nodes[1]*nodes[2]);
+  for( unsigned k = 0; k < nodes[2]; ++k )  {
+    for( unsigned j = 0; j < nodes[1]; ++j )  {
+      for( unsigned i = 0; i < nodes[0]; ++i )  {
+        double b[3] = { 0e0, 0e0, 0e0 };
+        double pos[3] = { start[0] + i*step[0], start[1] + j*step[1], start[2] + k*step[2] };
+        if ( geometry == FieldMapField::CYLINDRICAL )  {
+          pos[2] = pos[1];
+          pos[1] = 0e0;
+        }
+        field.magneticField(pos, b);
+        values.emplace_back(float(b[0]/dd4hep::tesla));
+        values.emplace_back(float(b[1]/dd4hep::tesla));
+        values.emplace_back(float(b[2]/dd4hep::tesla));
+      }
+    }
+  }
+  for( int j = 0; j < 3; ++j )  {
+    first[j] = start[j]/dd4hep::mm;
+    dist[j]  = step[j]/dd4hep::mm;
+  }
+  FieldMapField::write(output, geometry, nodes, first, dist, values);
+  printout(ALWAYS,"FieldMapWriter","+++ Wrote %s field map %s with %u x %u x %u nodes.",
+           geometry == FieldMapField::CYLINDRICAL ? "cylindrical" : "cartesian",
+           output.c_str(), nodes[0], nodes[1], nodes[2]);
+  return 1;
+}
+DECLARE_APPLY(DD4hep_FieldMapWriter,write_field_map)
+
+/// Micro-benchmark of the magnetic field evaluation
+/**
+ *  Factory: DD4hep_FieldBenchmark
+ *
+ *  Usage: geoPluginRun -input <compact.xml> -plugin DD4hep_FieldBenchmark
+ *                      [-points <n>] [-turns <n>] [-range <x> <y> <z>]
+ *
+ *  Random points are uniformly distributed in the box [-range,range].
+ *  The rates of the overlayed field and of each magnetic field component are printed.
+ *
+ *  \author  agent
+ *  \version 1.0
+ */
+static long field_benchmark(Detector& description, int argc, char** argv)  {
+  std::size_t npoints = 100000, turns = 10;
+  double      range[3] = { 1e0*dd4hep::m, 1e0*dd4hep::m, 1e0*dd4hep::m };
+  for(int i = 0; i < argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-points",argv[i],4) && i+1 < argc )
+      npoints = std::stoul(argv[++i]);
+    else if ( 0 == ::strncmp("-turns",argv[i],4) && i+1 < argc )
+      turns = std::stoul(argv[++i]);
+    else if ( 0 == ::strncmp("-range",argv[i],4) && i+3 < argc )  {
+      for( int j = 0; j < 3; ++j ) range[j] = _toDouble(argv[++i]);
+    }
+    else  {
+      std::cout <<
+        "Usage: -plugin DD4hep_FieldBenchmark  -arg [-arg]                              \n\n"
+        "     Measure magnetic field evaluations per second.                           \n\n"
+        "     -points <number>      Number of random points. Default: 100000            \n"
+        "     -turns  <number>      Number of loops over all points. Default: 10        \n"
+        "     -range  <x> <y> <z>   Half-length of the box containing the points.       \n"
+        "     Arguments given: " << arguments(argc,argv) << std::endl << std::flush;
+      ::exit(EINVAL);
+    }
+  }
+  OverlayedField field = description.field();
+  if ( !field.isValid() )  {
+    except("FieldBenchmark","+++ The detector description has no field.");
+  }
+  std::mt19937_64 gen(12345);
+  std::uniform_real_distribution<double> flat(-1e0, 1e0);
+  std::vector<double> points(3*npoints);
+  for( std::size_t i = 0; i < npoints; ++i )  {
+    for( int j = 0; j < 3; ++j )
+      points[3*i+j] = range[j] * flat(gen);
+  }
+  auto bench = [&](const char* tag, auto&& eval)  {
+    double sum = 0e0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for( std::size_t t = 0; t < turns; ++t )  {
+      for( std::size_t i = 0; i < npoints; ++i )  {
+        double b[3] = { 0e0, 0e0, 0e0 };
+        eval(&points[3*i], b);
+        sum += b[0] + b[1] + b[2];
+      }
+    }
+    std::chrono::duration<double> secs = std::chrono::high_resolution_clock::now() - start;
+    printout(ALWAYS,"FieldBenchmark","+++ %-32s %12.0f evaluations/sec  [checksum: %g tesla]",
+             tag, double(npoints*turns)/secs.count(), sum/dd4hep::tesla/double(turns));
+  };
+  printout(ALWAYS,"FieldBenchmark","+++ %ld points, %ld turns.", npoints, turns);
+  bench("Overlayed magnetic field", [&field](const double* p, double* b) { field.magneticField(p, b); });
+  for( CartesianField c : field.data<OverlayedField::Object>()->magnetic_components )  {
+    std::string tag = c.name() + std::string(" [") + c.type() + "]";
+    bench(tag.c_str(), [&c](const double* p, double* b) { c.value(p, b); });
+  }
+  return 1;
+}
+DECLARE_APPLY(DD4hep_FieldBenchmark,field_benchmark)
@@ -0,0 +1,367 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : agent
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/Plugins.h>
+#include <DD4hep/Printout.h>
+#include <DD4hep/FieldTypes.h>
+#include <DD4hep/DetectorData.h>
+#include <DD4hep/DD4hepRootPersistency.h>
+#include <DD4hep/detail/ObjectsInterna.h>
+#include <DD4hep/detail/DetectorInterna.h>
+#include <Parsers/Primitives.h>
+#include <XML/DocumentHandler.h>
+#include "GeometryBuildCache.h"
+
+// ROOT include files
+#include <TClass.h>
+#include <RVersion.h>
+
+// C/C++ include files
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#if defined(__APPLE__)
+#include <mach-o/dyld.h>
+#else
+#include <link.h>
+#endif
+
+using namespace dd4hep;
+using GeometryBuildCache = dd4hep::detail::GeometryBuildCache;
+
+namespace {
+
+  /// Strip the protocol of a file URI
+  std::string file_name(const std::string& uri)   {
+    if ( uri.compare(0, 7, "file://") == 0 ) return uri.substr(7);
+    if ( uri.compare(0, 5, "file:")   == 0 ) return uri.substr(5);
+    return uri;
+  }
+
+  /// Substitute environment variables '${NAME}' by their values
+  std::string substitute_environment(const std::string& value)   {
+    std::string result;
+    std::size_t start = 0;
+    for( std::size_t idx = value.find("${"); idx != std::string::npos; idx = value.find("${", start) )  {
+      std::size_t end = value.find('}', idx);
+      if ( end == std::string::npos ) break;
+      const char* env = ::getenv(value.substr(idx+2, end-idx-2).c_str());
+      result += value.substr(start, idx-start);
+      result += env ? std::string(env) : value.substr(idx, end-idx+1);
+      start = end + 1;
+    }
+    return result + value.substr(start);
+  }
+
+  /// Full path and content hash of a regular file
+  bool file_hash(const std::string& path, std::string& record)   {
+    struct stat st;
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if ( fd < 0 ) return false;
+    if ( ::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) )  {
+      ::close(fd);
+      return false;
+    }
+    unsigned long long hash = detail::hash64(path);
+    if ( st.st_size > 0 )  {
+      void* ptr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if ( ptr == MAP_FAILED )  {
+        ::close(fd);
+        return false;
+      }
+      hash = detail::update_hash64(hash, ptr, st.st_size);
+      ::munmap(ptr, st.st_size);
+    }
+    ::close(fd);
+    char text[32];
+    ::snprintf(text, sizeof(text), "%016llx", hash);
+    record += "library " + path + " " + text + "\n";
+    return true;
+  }
+
+  /// Full path of all shared libraries loaded into the process
+  std::vector<std::string> loaded_libraries()   {
+    std::vector<std::string> libraries;
+#if defined(__APPLE__)
+    for( uint32_t i = 0, n = ::_dyld_image_count(); i < n; ++i )  {
+      const char* nam = ::_dyld_get_image_name(i);
+      if ( nam && nam[0] ) libraries.emplace_back(nam);
+    }
+#else
+    ::dl_iterate_phdr([](dl_phdr_info* info, std::size_t, void* arg)  {
+        /// The main program has no name
+        if ( info->dlpi_name && info->dlpi_name[0] )
+          ((std::vector<std::string>*)arg)->emplace_back(info->dlpi_name);
+        return 0;
+      }, &libraries);
+#endif
+    std::sort(libraries.begin(), libraries.end());
+    libraries.erase(std::unique(libraries.begin(), libraries.end()), libraries.end());
+    return libraries;
+  }
+
+  /// Collect the type attributes of all elements with a given tag
+  void element_types(const std::string& content, const std::string& tag, std::set<std::string>& types)   {
+    const std::string start = "<" + tag;
+    for( std::size_t idx = content.find(start); idx != std::string::npos; idx = content.find(start, idx+1) )  {
+      std::size_t end = content.find('>', idx);
+      if ( end == std::string::npos ) break;
+      if ( !::isspace((unsigned char)content[idx+start.length()]) ) continue;
+      std::string elt = content.substr(idx, end-idx);
+      for( std::size_t pos = elt.find("type"); pos != std::string::npos; pos = elt.find("type", pos+4) )  {
+        if ( ::isalnum((unsigned char)elt[pos-1]) || elt[pos-1] == '_' ) continue;
+        std::size_t val = elt.find_first_not_of(" \t\r\n", pos+4);
+        if ( val == std::string::npos || elt[val] != '=' ) continue;
+        val = elt.find_first_not_of(" \t\r\n", val+1);
+        if ( val == std::string::npos || (elt[val] != '"' && elt[val] != '\'') ) continue;
+        std::size_t last = elt.find(elt[val], val+1);
+        if ( last != std::string::npos ) types.insert(elt.substr(val+1, last-val-1));
+        break;
+      }
+    }
+  }
+
+  /// First object of the detector description, which is not reproduced by DD4hepRootPersistency
+  /** Extensions are not persistent. Field objects need a ROOT dictionary. */
+  std::string not_persistent(Detector& description)   {
+    DetectorData* data = dynamic_cast<DetectorData*>(&description);
+    if ( data && !data->m_extensions.extensions.empty() )
+      return "detector extension " + typeName(typeid(*data->m_extensions.extensions.begin()->second));
+    for( const auto& f : description.fields() )  {
+      CartesianField field(f.second);
+      const auto* obj = field.ptr();
+      TClass* cl = obj ? TClass::GetClass(typeid(*obj), kTRUE, kTRUE) : nullptr;
+      if ( !cl || !cl->HasDictionary() )
+        return "field " + f.first + " of type " + (obj ? typeName(typeid(*obj)) : std::string("<invalid>"));
+    }
+    for( const auto& s : description.sensitiveDetectors() )  {
+      SensitiveDetector sd(s.second);
+      if ( !sd->extensions.empty() )
+        return "sensitive detector " + s.first + " extension " + typeName(typeid(*sd->extensions.begin()->second));
+    }
+    std::vector<DetElement> stack { description.world() };
+    while( !stack.empty() )   {
+      DetElement de = stack.back();
+      stack.pop_back();
+      if ( !de->extensions.empty() )
+        return "detector element " + de.path() + " extension " + typeName(typeid(*de->extensions.begin()->second));
+      for( const auto& c : de.children() )
+        stack.emplace_back(c.second);
+    }
+    return std::string();
+  }
+
+  /// Compact elements with side effects outside the persistent detector description
+  /** Returns the name of the first such element of the top level compact document */
+  std::string side_effects(xml::Handle_t compact)   {
+    static const std::pair<const char*, const char*> elements[] = {
+      { "includes",   "xml"     },
+      { "properties", "plugin"  },
+      { "materials",  "plugin"  },
+      { "define",     "include" }
+    };
+    for( const auto& e : elements )  {
+      for( xml::Collection_t c(compact, e.first); c; ++c )  {
+        if ( xml::Collection_t(c, e.second) )
+          return std::string("<") + e.first + "><" + e.second + ">";
+      }
+    }
+    if ( xml::Collection_t(compact, "std_conditions") )
+      return "<std_conditions>";
+    return std::string();
+  }
+
+  /// Register all constants of the detector description with the expression evaluator
+  void restore_dictionary(Detector& description)   {
+    std::vector<Constant> pending;
+    for( const auto& c : description.constants() )
+      pending.emplace_back(c.second);
+    /// Constants may refer to each other: iterate until all dependencies are resolved
+    while( !pending.empty() )   {
+      std::vector<Constant> failed;
+      for( Constant c : pending )  {
+        try  {
+          _toDictionary(c.name(), c->GetTitle(), c.dataType());
+        }
+        catch(const std::exception&)  {
+          failed.emplace_back(c);
+        }
+      }
+      if ( failed.size() == pending.size() )  {
+        for( Constant c : failed )
+          printout(WARNING, "GeometryCache", "+++ Failed to restore constant %s = %s",
+                   c.name(), c->GetTitle());
+        break;
+      }
+      pending = std::move(failed);
+    }
+  }
+}
+
+/// Initializing constructor: computes the cache key of the compact description
+GeometryBuildCache::GeometryBuildCache(Detector& description, xml::Handle_t compact, const std::string& directory)
+  : m_detDesc(description)
+{
+  struct stat st;
+  if ( ::stat(directory.c_str(), &st) != 0 || !S_ISDIR(st.st_mode) )   {
+    printout(WARNING, "GeometryCache", "+++ Cache directory %s does not exist. Geometry cache disabled.",
+             directory.c_str());
+    return;
+  }
+  std::stringstream str;
+  str << "ROOT "  << ROOT_VERSION_CODE << " build type " << int(description.buildType()) << "\n";
+  for( const auto& c : description.constants() )  {
+    Constant cons = c.second;
+    str << "constant " << cons.name() << "=" << cons->GetTitle() << "\n";
+  }
+  m_record = str.str();
+  std::string top = file_name(xml::DocumentHandler::system_path(compact));
+  std::string tag = side_effects(compact);
+  if ( !tag.empty() )   {
+    printout(INFO, "GeometryCache", "+++ Compact description %s uses %s. Geometry cache disabled.",
+             top.c_str(), tag.c_str());
+    return;
+  }
+  if ( !addFile(top, true) )   {
+    printout(INFO, "GeometryCache", "+++ Compact description %s is no file. Geometry cache disabled.",
+             top.c_str());
+    return;
+  }
+  if ( !m_sideEffects.empty() )   {
+    printout(INFO, "GeometryCache", "+++ Included file %s has plugins or xml includes. Geometry cache disabled.",
+             m_sideEffects.c_str());
+    return;
+  }
+  addLibraries();
+  char key[32];
+  ::snprintf(key, sizeof(key), "%016llx", detail::hash64(m_record));
+  m_artifact = directory + "/Geometry_" + key + ".root";
+  printout(DEBUG, "GeometryCache", "+++ Cache key of %s [%ld files]: %s",
+           top.c_str(), m_files.size(), key);
+}
+
+/// Add the content of a file and (recursively) of all referenced files
+bool GeometryBuildCache::addFile(const std::string& path, bool top)   {
+  if ( !m_files.insert(path).second ) return true;
+  std::ifstream in(path, std::ios::binary);
+  if ( !in.good() ) return false;
+  std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  char hash[32];
+  ::snprintf(hash, sizeof(hash), "%016llx", detail::hash64(content));
+  m_record += "file " + path + " " + hash + "\n";
+
+  std::string ext = path.substr(path.rfind('.') == std::string::npos ? path.length() : path.rfind('.'));
+  if ( ext != ".xml" && ext != ".gdml" ) return true;
+
+  /// Plugins and xml files of included documents are not replayed on a cache hit
+  if ( !top && m_sideEffects.empty() &&
+       (content.find("<plugin") != std::string::npos || content.find("<xml") != std::string::npos ||
+        content.find("<std_conditions") != std::string::npos) )   {
+    m_sideEffects = path;
+  }
+
+  /// Factories of the detector constructors and fields used in the file
+  element_types(content, "detector", m_detectorTypes);
+  element_types(content, "field",    m_fieldTypes);
+
+  /// Environment variables used in the file
+  for( std::size_t idx = content.find("${"); idx != std::string::npos; idx = content.find("${", idx+2) )  {
+    std::size_t end = content.find('}', idx);
+    if ( end == std::string::npos ) break;
+    std::string nam = content.substr(idx+2, end-idx-2);
+    const char* env = ::getenv(nam.c_str());
+    m_record += "env " + nam + "=" + (env ? env : "") + "\n";
+  }
+  /// Referenced files: paths are relative to the referencing file
+  std::string dir = path.substr(0, path.rfind('/') == std::string::npos ? 0 : path.rfind('/')+1);
+  for( std::size_t idx = content.find("ref"); idx != std::string::npos; idx = content.find("ref", idx+3) )  {
+    std::size_t pos = content.find_first_not_of(" \t\r\n", idx+3);
+    if ( idx > 0 && (::isalnum((unsigned char)content[idx-1]) || content[idx-1] == '_') ) continue;
+    if ( pos == std::string::npos || content[pos] != '=' ) continue;
+    pos = content.find_first_not_of(" \t\r\n", pos+1);
+    if ( pos == std::string::npos || (content[pos] != '"' && content[pos] != '\'') ) continue;
+    std::size_t end = content.find(content[pos], pos+1);
+    if ( end == std::string::npos ) break;
+    std::string ref = file_name(substitute_environment(content.substr(pos+1, end-pos-1)));
+    if ( !ref.empty() && ref[0] != '/' ) ref = dir + ref;
+    struct stat st;
+    if ( ::stat(ref.c_str(), &st) == 0 && S_ISREG(st.st_mode) )
+      addFile(ref);
+  }
+  return true;
+}
+
+/// Add the versions of all shared libraries loaded to build the geometry
+void GeometryBuildCache::addLibraries()   {
+  /// Looking up the factories loads the libraries of the detector constructors and fields
+  for( const auto& typ : m_detectorTypes )
+    PluginService::getCreator(typ, typeid(NamedObject*(Detector*, xml::Handle_t*, Ref_t*)));
+  for( const auto& typ : m_fieldTypes )
+    PluginService::getCreator(typ, typeid(NamedObject*(Detector*, xml::Handle_t*)));
+  for( const auto& lib : loaded_libraries() )
+    file_hash(lib, m_record);
+}
+
+/// Load the geometry from the cache. Returns false if the geometry must be built
+bool GeometryBuildCache::load()   {
+  struct stat st;
+  if ( !enabled() || ::stat(m_artifact.c_str(), &st) != 0 )
+    return false;
+  try  {
+    if ( 1 == DD4hepRootPersistency::load(m_detDesc, m_artifact.c_str(), "Geometry") )  {
+      restore_dictionary(m_detDesc);
+      printout(INFO, "GeometryCache", "+++ Loaded geometry from cache: %s", m_artifact.c_str());
+      return true;
+    }
+  }
+  catch(const std::exception& e)   {
+    printout(WARNING, "GeometryCache", "+++ Exception while loading %s: %s", m_artifact.c_str(), e.what());
+  }
+  printout(WARNING, "GeometryCache", "+++ Failed to load %s. The geometry is rebuilt.", m_artifact.c_str());
+  return false;
+}
+
+/// Save the built geometry to the cache
+bool GeometryBuildCache::save()   {
+  if ( !enabled() ) return false;
+  std::string obj = not_persistent(m_detDesc);
+  if ( !obj.empty() )   {
+    printout(INFO, "GeometryCache", "+++ The %s is not persistent. Geometry cache disabled.", obj.c_str());
+    return false;
+  }
+  /// Concurrent jobs may fill the cache: the artifact only appears once complete
+  std::string temp = m_artifact + "." + std::to_string(::getpid()) + ".tmp";
+  try  {
+    if ( DD4hepRootPersistency::save(m_detDesc, temp.c_str(), "Geometry") > 0 &&
+         0 == ::rename(temp.c_str(), m_artifact.c_str()) )   {
+      printout(INFO, "GeometryCache", "+++ Saved geometry to cache: %s", m_artifact.c_str());
+      return true;
+    }
+  }
+  catch(const std::exception& e)   {
+    printout(WARNING, "GeometryCache", "+++ Exception while saving %s: %s", m_artifact.c_str(), e.what());
+  }
+  ::unlink(temp.c_str());
+  printout(WARNING, "GeometryCache", "+++ Failed to save geometry to cache: %s", m_artifact.c_str());
+  return false;
+}
@@ -0,0 +1,100 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : agent
+//
+//==========================================================================
+#ifndef DDCORE_SRC_PLUGINS_GEOMETRYBUILDCACHE_H
+#define DDCORE_SRC_PLUGINS_GEOMETRYBUILDCACHE_H
+
+/// Framework include files
+#include <DD4hep/Detector.h>
+#include <XML/XMLElements.h>
+
+/// C/C++ include files
+#include <set>
+#include <string>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for implementation details of the AIDA detector description toolkit
+  namespace detail {
+
+    /// Persistent cache of detector descriptions built from compact files
+    /**
+     *  The cache key is a hash of all ingredients of the build:
+     *  - the content of the compact file and of all files it references
+     *    (recursively, '<... ref="file"/>' attributes),
+     *  - the values of all environment variables used in these files,
+     *  - the constants defined before the compact file is processed,
+     *  - the build type and the ROOT version,
+     *  - full path and content of all shared libraries loaded into the
+     *    process once the libraries of the detector constructors and
+     *    fields used by the description are loaded.
+     *
+     *  On a cache hit only the top level <plugins> are executed again. Compact
+     *  descriptions with other elements acting outside the persistent detector
+     *  description are not cached: <includes><xml>, <properties><plugin>,
+     *  <materials><plugin>, <define><include>, <std_conditions> and
+     *  included documents with plugins or xml includes.
+     *
+     *  The geometry is stored with DD4hepRootPersistency as
+     *  <directory>/Geometry_<key>.root. Geometries with objects, which are
+     *  not persistent (extensions of the detector description, of detector
+     *  elements and of sensitive detectors, fields without ROOT dictionary)
+     *  are not saved. Any failure to load a cached geometry results in a
+     *  full rebuild.
+     *
+     *  \author  agent
+     *  \version 1.0
+     *  \ingroup DD4HEP_CORE
+     */
+    class GeometryBuildCache  {
+    public:
+      using hash_t = uint64_t;
+
+    protected:
+      /// Reference to detector description
+      Detector&             m_detDesc;
+      /// Name of the cache artifact. Empty if the cache is disabled
+      std::string           m_artifact;
+      /// Canonical record of all build ingredients
+      std::string           m_record;
+      /// Files already added to the record
+      std::set<std::string> m_files;
+      /// First included file with side effects, which are not replayed on a cache hit
+      std::string           m_sideEffects;
+      /// Detector constructor factories used by the description
+      std::set<std::string> m_detectorTypes;
+      /// Field factories used by the description
+      std::set<std::string> m_fieldTypes;
+
+      /// Add the content of a file and (recursively) of all referenced files
+      bool addFile(const std::string& path, bool top = false);
+      /// Add the versions of all shared libraries loaded to build the geometry
+      void addLibraries();
+
+    public:
+      /// Initializing constructor: computes the cache key of the compact description
+      GeometryBuildCache(Detector& description, xml::Handle_t compact, const std::string& directory);
+      /// Default destructor
+      ~GeometryBuildCache() = default;
+      /// Check if the geometry may be cached
+      bool enabled()  const                 {  return !m_artifact.empty();  }
+      /// Access the name of the cache artifact
+      const std::string& artifact()  const  {  return m_artifact;           }
+      /// Load the geometry from the cache. Returns false if the geometry must be built
+      bool load();
+      /// Save the built geometry to the cache
+      bool save();
+    };
+  }    // End namespace detail
+}      // End namespace dd4hep
+#endif // DDCORE_SRC_PLUGINS_GEOMETRYBUILDCACHE_H
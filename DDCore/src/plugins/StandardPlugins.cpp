@@ -798,16 +798,26 @@ DECLARE_APPLY(DD4hep_XMLProcessor,process_xml_doc)
 /**
  *  Factory: DD4hep_VolumeManager
  *
+ *  Optional arguments: -freeze       Build the read-only flat lookup index after populating
+ *                      -world-cache  Cache the composed volume-to-world transformations
+ *
  *  \author  M.Frank
  *  \version 1.0
  *  \date    01/04/2014
  */
-static long load_volmgr(Detector& description, int, char**) {
+static long load_volmgr(Detector& description, int argc, char** argv) {
   printout(INFO,"DD4hepVolumeManager","**** running plugin DD4hepVolumeManager ! " );
   try {
     DetectorImp* imp = dynamic_cast<DetectorImp*>(&description);
     if ( imp )  {
+      bool freeze = false, world_cache = false;
+      for(int i = 0; i < argc && argv[i]; ++i)  {
+        if ( 0 == ::strncmp("-freeze",argv[i],4) ) freeze = true;
+        else if ( 0 == ::strncmp("-world-cache",argv[i],4) ) world_cache = true;
+      }
       imp->imp_loadVolumeManager();
+      if ( freeze ) description.volumeManager().freeze();
+      if ( world_cache ) description.volumeManager().cacheWorldTransformations();
       printout(INFO,"VolumeManager","+++ Volume manager populated and loaded.");
       return 1;
     }
@@ -836,21 +846,26 @@ DECLARE_APPLY(DD4hepVolumeManager,load_volmgr)
 static long dump_geometry2root(Detector& description, int argc, char** argv) {
   if ( argc > 0 )   {
     std::string output;
+    int layout = DD4hepRootPersistency::FULL;
     for(int i = 0; i < argc && argv[i]; ++i)  {
       if ( 0 == ::strncmp("-output",argv[i],4) )
         output = argv[++i];
+      else if ( 0 == ::strcmp("-volmgr-on-demand",argv[i]) )
+        layout = DD4hepRootPersistency::VOLMGR_ON_DEMAND;
     }
     if ( output.empty() )   {
       std::cout <<
         "Usage: -plugin DD4hep_Geometry2ROOT -arg [-arg]                             \n\n"
         "     Output DD4hep detector description object to a ROOT file.              \n\n"
         "     -output <string>         Output file name.                               \n"
+        "     -volmgr-on-demand        Do not save the volume manager. After loading   \n"
+        "                              its sections are populated on first access.     \n"
         "\tArguments given: " << arguments(argc,argv) << std::endl << std::flush;
       ::exit(EINVAL);
     }
     printout(INFO,"Geometry2ROOT","+++ Dump geometry to root file:%s",output.c_str());
     //description.manager().Export(output.c_str()+1);
-    if ( DD4hepRootPersistency::save(description,output.c_str(),"Geometry") > 1 )  {
+    if ( DD4hepRootPersistency::save(description,output.c_str(),"Geometry",layout) > 1 )  {
       return 1;
     }
   }
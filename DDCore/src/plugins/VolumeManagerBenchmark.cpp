@@ -0,0 +1,117 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : agent
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/Detector.h>
+#include <DD4hep/Factories.h>
+#include <DD4hep/Printout.h>
+#include <DD4hep/VolumeManager.h>
+#include <DD4hep/detail/VolumeManagerInterna.h>
+
+// C/C++ include files
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+#include <random>
+#include <cerrno>
+#include <iostream>
+
+using namespace dd4hep;
+
+namespace  {
+
+  /// Time a lookup function over the list of identifiers
+  template <typename FUNC>
+  double time_lookups(const std::vector<VolumeID>& ids, std::size_t turns, std::size_t& found, FUNC func)  {
+    auto start = std::chrono::high_resolution_clock::now();
+    found = 0;
+    for( std::size_t t = 0; t < turns; ++t )  {
+      for( VolumeID id : ids )  {
+        if ( func(id) ) ++found;
+      }
+    }
+    std::chrono::duration<double> secs = std::chrono::high_resolution_clock::now() - start;
+    return secs.count();
+  }
+}
+
+/// Micro-benchmark of the volume manager lookup: map based lookup versus frozen flat index
+/**
+ *  Factory: DD4hep_VolumeManagerBenchmark
+ *
+ *  Usage: geoPluginRun -input <compact.xml> -plugin DD4hep_VolumeManagerBenchmark [-turns <n>]
+ *
+ *  The volume manager of the detector description is populated by the standard
+ *  plugin. The lookups are first timed with the map based lookup, then the
+ *  manager is frozen and the same lookups are timed with the flat index.
+ *  Both measurements use VolumeManager::lookupContext.
+ *
+ *  \author  agent
+ *  \version 1.0
+ */
+static long volume_manager_benchmark(Detector& description, int argc, char** argv)  {
+  std::size_t turns = 10;
+  for(int i = 0; i < argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-turns",argv[i],4) )
+      turns = std::stoul(argv[++i]);
+    else   {
+      std::cout <<
+        "Usage: -plugin DD4hep_VolumeManagerBenchmark  -arg [-arg]                      \n\n"
+        "     Measure volume manager lookups per second.                              \n\n"
+        "     -turns   <number>   Number of loops over all registered volume ids.       \n"
+        "     -help               Print this help.                                      \n"
+        "     Arguments given: " << arguments(argc,argv) << std::endl << std::flush;
+      ::exit(EINVAL);
+    }
+  }
+  VolumeManager mgr = VolumeManager::getVolumeManager(description);
+  if ( mgr.isFrozen() )  {
+    except("VolumeManagerBenchmark","+++ The volume manager is already frozen. "
+           "The map based lookup cannot be measured.");
+  }
+  const detail::VolumeManagerObject& o = *mgr.data<detail::VolumeManagerObject>();
+  std::vector<VolumeID> ids;
+  for( const auto& v : o.volumes ) ids.emplace_back(v.first);
+  for( const auto& s : o.subdetectors )  {
+    for( const auto& v : s.second.data<detail::VolumeManagerObject>()->volumes )
+      ids.emplace_back(v.first);
+  }
+  if ( ids.empty() )  {
+    except("VolumeManagerBenchmark","+++ The volume manager has no registered placements.");
+  }
+  /// Random access pattern as seen from hits of many subdetectors
+  std::shuffle(ids.begin(), ids.end(), std::mt19937_64(12345));
+
+  auto lookup = [&mgr](VolumeID id) { return mgr.lookupContext(id); };
+  std::vector<VolumeManagerContext*> found_by_map;
+  found_by_map.reserve(ids.size());
+  for( VolumeID id : ids ) found_by_map.emplace_back(lookup(id));
+  std::size_t found_map = 0, found_idx = 0;
+  double t_map = time_lookups(ids, turns, found_map, lookup);
+
+  std::size_t num_indexed = mgr.freeze();
+  std::size_t mismatch = 0;
+  for( std::size_t i = 0; i < ids.size(); ++i )  {
+    if ( lookup(ids[i]) != found_by_map[i] ) ++mismatch;
+  }
+  double t_idx = time_lookups(ids, turns, found_idx, lookup);
+  double num   = double(ids.size()*turns);
+  printout(ALWAYS,"VolumeManagerBenchmark","+++ %ld placements, %ld indexed in %ld sections. %ld turns. Mismatches: %ld",
+           ids.size(), num_indexed, o.index->sections.size(), turns, mismatch);
+  printout(ALWAYS,"VolumeManagerBenchmark","+++ std::map lookup:  %12.0f lookups/sec  [%ld found]",
+           num/t_map, found_map);
+  printout(ALWAYS,"VolumeManagerBenchmark","+++ Flat index:       %12.0f lookups/sec  [%ld found]  speedup: %.2f",
+           num/t_idx, found_idx, t_map/t_idx);
+  return mismatch == 0 ? 1 : 0;
+}
+DECLARE_APPLY(DD4hep_VolumeManagerBenchmark,volume_manager_benchmark)
@@ -33,8 +33,8 @@ CartesianGridUV::CartesianGridUV(const std::string& cellEncoding) :
         registerParameter("grid_size_v", "Cell size in V",   _gridSizeV, 1., SegmentationParameter::LengthUnit);
         registerParameter("offset_u",    "Cell offset in U", _offsetU,   0., SegmentationParameter::LengthUnit, true);
         registerParameter("offset_v",    "Cell offset in V", _offsetV,   0., SegmentationParameter::LengthUnit, true);
-        registerIdentifier("identifier_u", "Cell ID identifier for U", _uId, "u");
-        registerIdentifier("identifier_v", "Cell ID identifier for V", _vId, "v");
+        registerIdentifier("identifier_u", "Cell ID identifier for U", _uId, "u", _uField);
+        registerIdentifier("identifier_v", "Cell ID identifier for V", _vId, "v", _vField);
         registerParameter("grid_angle", "Angle of U measurement axis in X,Y frame", _gridAngle, 0., SegmentationParameter::AngleUnit);
 };
 
@@ -51,8 +51,8 @@ CartesianGridUV::CartesianGridUV(const BitFieldCoder* decode) :
         registerParameter("grid_size_v", "Cell size in V",   _gridSizeV, 1., SegmentationParameter::LengthUnit);
         registerParameter("offset_u",    "Cell offset in U", _offsetU,   0., SegmentationParameter::LengthUnit, true);
         registerParameter("offset_v",    "Cell offset in V", _offsetV,   0., SegmentationParameter::LengthUnit, true);
-        registerIdentifier("identifier_u", "Cell ID identifier for U", _uId, "u");
-        registerIdentifier("identifier_v", "Cell ID identifier for V", _vId, "v");
+        registerIdentifier("identifier_u", "Cell ID identifier for U", _uId, "u", _uField);
+        registerIdentifier("identifier_v", "Cell ID identifier for V", _vId, "v", _vField);
         registerParameter("grid_angle", "Angle of U measurement axis in X,Y frame", _gridAngle, 0., SegmentationParameter::AngleUnit);
 };
 
@@ -64,8 +64,8 @@ CartesianGridUV::~CartesianGridUV() {
 /// determine the position based on the cell ID
 Vector3D CartesianGridUV::position(const CellID& cID) const {
         Vector3D cellPosition;
-        cellPosition.X = binToPosition( _decoder->get(cID,_uId ), _gridSizeU, _offsetU);
-        cellPosition.Y = binToPosition( _decoder->get(cID,_vId ), _gridSizeV, _offsetV);
+        cellPosition.X = binToPosition( field(_uField,_uId).value(cID), _gridSizeU, _offsetU);
+        cellPosition.Y = binToPosition( field(_vField,_vId).value(cID), _gridSizeV, _offsetV);
         cellPosition = RotationZ(-_gridAngle)*cellPosition;
         return cellPosition;
 }
@@ -76,8 +76,8 @@ CellID CartesianGridUV::cellID(const Vector3D& localPosition,
                                const VolumeID& vID) const {
         CellID cID = vID;
         const Vector3D& localUV = RotationZ(_gridAngle)*localPosition;
-        _decoder->set( cID,_uId, positionToBin(localUV.X, _gridSizeU, _offsetU) );
-        _decoder->set( cID,_vId, positionToBin(localUV.Y, _gridSizeV, _offsetV) );
+        field(_uField,_uId).set(cID, positionToBin(localUV.X, _gridSizeU, _offsetU) );
+        field(_vField,_vId).set(cID, positionToBin(localUV.Y, _gridSizeV, _offsetV) );
         return cID;
 }
 
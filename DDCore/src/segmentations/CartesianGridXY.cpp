@@ -31,8 +31,8 @@ CartesianGridXY::CartesianGridXY(const std::string& cellEncoding) :
         registerParameter("grid_size_y", "Cell size in Y",   _gridSizeY, 1., SegmentationParameter::LengthUnit);
         registerParameter("offset_x",    "Cell offset in X", _offsetX,   0., SegmentationParameter::LengthUnit, true);
         registerParameter("offset_y",    "Cell offset in Y", _offsetY,   0., SegmentationParameter::LengthUnit, true);
-        registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x");
-        registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y");
+        registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x", _xField);
+        registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y", _yField);
 }
 
 /// Default constructor used by derived classes passing an existing decoder
@@ -48,8 +48,8 @@ CartesianGridXY::CartesianGridXY(const BitFieldCoder* decode) :
         registerParameter("grid_size_y", "Cell size in Y",   _gridSizeY, 1., SegmentationParameter::LengthUnit);
         registerParameter("offset_x",    "Cell offset in X", _offsetX,   0., SegmentationParameter::LengthUnit, true);
         registerParameter("offset_y",    "Cell offset in Y", _offsetY,   0., SegmentationParameter::LengthUnit, true);
-        registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x");
-        registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y");
+        registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x", _xField);
+        registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y", _yField);
 }
 
 /// destructor
@@ -60,8 +60,8 @@ CartesianGridXY::~CartesianGridXY() {
 /// determine the position based on the cell ID
 Vector3D CartesianGridXY::position(const CellID& cID) const {
         Vector3D cellPosition;
-        cellPosition.X = binToPosition( _decoder->get(cID,_xId ), _gridSizeX, _offsetX);
-        cellPosition.Y = binToPosition( _decoder->get(cID,_yId ), _gridSizeY, _offsetY);
+        cellPosition.X = binToPosition( field(_xField,_xId).value(cID), _gridSizeX, _offsetX);
+        cellPosition.Y = binToPosition( field(_yField,_yId).value(cID), _gridSizeY, _offsetY);
         return cellPosition;
 }
 
@@ -70,11 +70,36 @@ CellID CartesianGridXY::cellID(const Vector3D& localPosition,
                                const Vector3D& /* globalPosition */,
                                const VolumeID& vID) const {
   CellID cID = vID;
-        _decoder->set( cID,_xId, positionToBin(localPosition.X, _gridSizeX, _offsetX) );
-        _decoder->set( cID,_yId, positionToBin(localPosition.Y, _gridSizeY, _offsetY) );
+        field(_xField,_xId).set(cID, positionToBin(localPosition.X, _gridSizeX, _offsetX) );
+        field(_yField,_yId).set(cID, positionToBin(localPosition.Y, _gridSizeY, _offsetY) );
         return cID;
 }
 
+/// determine the local positions of n cell IDs (batch version, SoA layout)
+void CartesianGridXY::positions(std::size_t n, const CellID* cIDs, double* x, double* y, double* z) const {
+  const BatchField fx(field(_xField,_xId)), fy(field(_yField,_yId));
+  for ( std::size_t i = 0; i < n; ++i )  {
+    x[i] = fx.value(cIDs[i]) * _gridSizeX + _offsetX;
+    y[i] = fy.value(cIDs[i]) * _gridSizeY + _offsetY;
+    z[i] = 0e0;
+  }
+}
+
+/// determine n cell IDs from the local positions (batch version, SoA layout)
+void CartesianGridXY::cellIDs(std::size_t n, const double* lx, const double* ly, const double* /* lz */,
+                              const double* /* gx */, const double* /* gy */, const double* /* gz */,
+                              const VolumeID* vIDs, CellID* cIDs) const {
+  const BatchField fx(field(_xField,_xId)), fy(field(_yField,_yId));
+  positionToBin(0e0, _gridSizeX, 0e0);   // Throws for invalid cell sizes
+  positionToBin(0e0, _gridSizeY, 0e0);
+  for ( std::size_t i = 0; i < n; ++i )  {
+    CellID cID = vIDs[i];
+    fx.set(cID, positionToBinUnchecked(lx[i], _gridSizeX, _offsetX));
+    fy.set(cID, positionToBinUnchecked(ly[i], _gridSizeY, _offsetY));
+    cIDs[i] = cID;
+  }
+}
+
   std::vector<double> CartesianGridXY::cellDimensions(const CellID& /* cellID */) const {
   return {_gridSizeX, _gridSizeY};
 }
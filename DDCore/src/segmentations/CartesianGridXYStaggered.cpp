@@ -36,10 +36,11 @@ CartesianGridXYStaggered::CartesianGridXYStaggered(const std::string& cellEncodi
                     _staggerX, 0,        SegmentationParameter::NoUnit, true);
         registerParameter("stagger_y", "Option to stagger the layers in y (ie, add grid_size_y/2 to offset_y for odd layers)",
                     _staggerY, 0, SegmentationParameter::NoUnit, true);
-        registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x");
-        registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y");
+        registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x", _xField);
+        registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y", _yField);
         registerParameter("stagger_keyword", "Volume ID identifier used for determining which volumes to stagger",
                     _staggerKeyword, (std::string)"layer", SegmentationParameter::NoUnit, true);
+        registerField(_staggerKeyword, _staggerField);
 }
 
 /// Default constructor used by derived classes passing an existing decoder
@@ -59,10 +60,11 @@ CartesianGridXYStaggered::CartesianGridXYStaggered(const BitFieldCoder* decode)
                     _staggerX, 0,        SegmentationParameter::NoUnit, true);
         registerParameter("stagger_y", "Option to stagger the layers in y (ie, add grid_size_y/2 to offset_y for odd layers)",
                     _staggerY, 0,        SegmentationParameter::NoUnit, true);
-        registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x");
-        registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y");
+        registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x", _xField);
+        registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y", _yField);
         registerParameter("stagger_keyword", "Volume ID identifier used for determining which volumes to stagger",
                     _staggerKeyword, (std::string)"layer", SegmentationParameter::NoUnit, true);
+        registerField(_staggerKeyword, _staggerField);
 }
 
 /// destructor
@@ -74,12 +76,12 @@ CartesianGridXYStaggered::~CartesianGridXYStaggered() {
 Vector3D CartesianGridXYStaggered::position(const CellID& cID) const {
         Vector3D cellPosition;
         if (_staggerX || _staggerY){
-                int layer= _decoder->get(cID,_staggerKeyword);
-                cellPosition.X = binToPosition( _decoder->get(cID,_xId ), _gridSizeX, _offsetX+_staggerX*_gridSizeX*(layer%2)/2.);
-                cellPosition.Y = binToPosition( _decoder->get(cID,_yId ), _gridSizeY, _offsetY+_staggerY*_gridSizeY*(layer%2)/2.);
+                int layer= field(_staggerField,_staggerKeyword).value(cID);
+                cellPosition.X = binToPosition( field(_xField,_xId).value(cID), _gridSizeX, _offsetX+_staggerX*_gridSizeX*(layer%2)/2.);
+                cellPosition.Y = binToPosition( field(_yField,_yId).value(cID), _gridSizeY, _offsetY+_staggerY*_gridSizeY*(layer%2)/2.);
         } else {
-                cellPosition.X = binToPosition( _decoder->get(cID,_xId ), _gridSizeX, _offsetX);
-                cellPosition.Y = binToPosition( _decoder->get(cID,_yId ), _gridSizeY, _offsetY);
+                cellPosition.X = binToPosition( field(_xField,_xId).value(cID), _gridSizeX, _offsetX);
+                cellPosition.Y = binToPosition( field(_yField,_yId).value(cID), _gridSizeY, _offsetY);
         }
         return cellPosition;
 }
@@ -90,12 +92,12 @@ CellID CartesianGridXYStaggered::cellID(const Vector3D& localPosition,
                                         const VolumeID& vID) const {
   CellID cID = vID ;
         if (_staggerX || _staggerY){
-                int layer= _decoder->get(cID,_staggerKeyword);
-                _decoder->set( cID,_xId, positionToBin(localPosition.X, _gridSizeX, _offsetX+_staggerX*_gridSizeX*(layer%2)/2) );
-                _decoder->set( cID,_yId, positionToBin(localPosition.Y, _gridSizeY, _offsetY+_staggerY*_gridSizeY*(layer%2)/2) );
+                int layer= field(_staggerField,_staggerKeyword).value(cID);
+                field(_xField,_xId).set(cID, positionToBin(localPosition.X, _gridSizeX, _offsetX+_staggerX*_gridSizeX*(layer%2)/2) );
+                field(_yField,_yId).set(cID, positionToBin(localPosition.Y, _gridSizeY, _offsetY+_staggerY*_gridSizeY*(layer%2)/2) );
         } else {
-                _decoder->set( cID,_xId, positionToBin(localPosition.X, _gridSizeX, _offsetX));
-                _decoder->set( cID,_yId, positionToBin(localPosition.Y, _gridSizeY, _offsetY));
+                field(_xField,_xId).set(cID, positionToBin(localPosition.X, _gridSizeX, _offsetX));
+                field(_yField,_yId).set(cID, positionToBin(localPosition.Y, _gridSizeY, _offsetY));
         }
         return cID ;
 }
@@ -28,7 +28,7 @@ CartesianGridXYZ::CartesianGridXYZ(const std::string& cellEncoding) :
 	// register all necessary parameters
 	registerParameter("grid_size_z", "Cell size in Z", _gridSizeZ, 1., SegmentationParameter::LengthUnit);
 	registerParameter("offset_z", "Cell offset in Z", _offsetZ, 0., SegmentationParameter::LengthUnit, true);
-	registerIdentifier("identifier_z", "Cell ID identifier for Z", _zId, "z");
+	registerIdentifier("identifier_z", "Cell ID identifier for Z", _zId, "z", _zField);
 }
 
 /// Default constructor used by derived classes passing an existing decoder
@@ -41,7 +41,7 @@ CartesianGridXYZ::CartesianGridXYZ(const BitFieldCoder* decode) :
 	// register all necessary parameters
 	registerParameter("grid_size_z", "Cell size in Z", _gridSizeZ, 1., SegmentationParameter::LengthUnit);
 	registerParameter("offset_z", "Cell offset in Z", _offsetZ, 0., SegmentationParameter::LengthUnit, true);
-	registerIdentifier("identifier_z", "Cell ID identifier for Z", _zId, "z");
+	registerIdentifier("identifier_z", "Cell ID identifier for Z", _zId, "z", _zField);
 }
 
 /// destructor
@@ -52,21 +52,48 @@ CartesianGridXYZ::~CartesianGridXYZ() {
 /// determine the position based on the cell ID
 Vector3D CartesianGridXYZ::position(const CellID& cID) const {
 	Vector3D cellPosition;
-	cellPosition.X = binToPosition( _decoder->get(cID,_xId ), _gridSizeX, _offsetX);
-	cellPosition.Y = binToPosition( _decoder->get(cID,_yId ), _gridSizeY, _offsetY);
-	cellPosition.Z = binToPosition( _decoder->get(cID,_zId ), _gridSizeZ, _offsetZ);
+	cellPosition.X = binToPosition( field(_xField,_xId).value(cID), _gridSizeX, _offsetX);
+	cellPosition.Y = binToPosition( field(_yField,_yId).value(cID), _gridSizeY, _offsetY);
+	cellPosition.Z = binToPosition( field(_zField,_zId).value(cID), _gridSizeZ, _offsetZ);
 	return cellPosition;
 }
 
 /// determine the cell ID based on the position
   CellID CartesianGridXYZ::cellID(const Vector3D& localPosition, const Vector3D& /* globalPosition */, const VolumeID& vID) const {
         CellID cID = vID ;
-	_decoder->set( cID,_xId, positionToBin(localPosition.X, _gridSizeX, _offsetX) );
-	_decoder->set( cID,_yId, positionToBin(localPosition.Y, _gridSizeY, _offsetY) );
-	_decoder->set( cID,_zId, positionToBin(localPosition.Z, _gridSizeZ, _offsetZ) );
+	field(_xField,_xId).set(cID, positionToBin(localPosition.X, _gridSizeX, _offsetX) );
+	field(_yField,_yId).set(cID, positionToBin(localPosition.Y, _gridSizeY, _offsetY) );
+	field(_zField,_zId).set(cID, positionToBin(localPosition.Z, _gridSizeZ, _offsetZ) );
 	return cID ;
 }
 
+/// determine the local positions of n cell IDs (batch version, SoA layout)
+void CartesianGridXYZ::positions(std::size_t n, const CellID* cIDs, double* x, double* y, double* z) const {
+  const BatchField fx(field(_xField,_xId)), fy(field(_yField,_yId)), fz(field(_zField,_zId));
+  for ( std::size_t i = 0; i < n; ++i )  {
+    x[i] = fx.value(cIDs[i]) * _gridSizeX + _offsetX;
+    y[i] = fy.value(cIDs[i]) * _gridSizeY + _offsetY;
+    z[i] = fz.value(cIDs[i]) * _gridSizeZ + _offsetZ;
+  }
+}
+
+/// determine n cell IDs from the local positions (batch version, SoA layout)
+void CartesianGridXYZ::cellIDs(std::size_t n, const double* lx, const double* ly, const double* lz,
+                               const double* /* gx */, const double* /* gy */, const double* /* gz */,
+                               const VolumeID* vIDs, CellID* cIDs) const {
+  const BatchField fx(field(_xField,_xId)), fy(field(_yField,_yId)), fz(field(_zField,_zId));
+  positionToBin(0e0, _gridSizeX, 0e0);   // Throws for invalid cell sizes
+  positionToBin(0e0, _gridSizeY, 0e0);
+  positionToBin(0e0, _gridSizeZ, 0e0);
+  for ( std::size_t i = 0; i < n; ++i )  {
+    CellID cID = vIDs[i];
+    fx.set(cID, positionToBinUnchecked(lx[i], _gridSizeX, _offsetX));
+    fy.set(cID, positionToBinUnchecked(ly[i], _gridSizeY, _offsetY));
+    fz.set(cID, positionToBinUnchecked(lz[i], _gridSizeZ, _offsetZ));
+    cIDs[i] = cID;
+  }
+}
+
 std::vector<double> CartesianGridXYZ::cellDimensions(const CellID&) const {
   return {_gridSizeX, _gridSizeY, _gridSizeZ};
 }
@@ -33,8 +33,8 @@ CartesianGridXZ::CartesianGridXZ(const std::string& cellEncoding) :
         registerParameter("grid_size_z", "Cell size in Z", _gridSizeZ, 1., SegmentationParameter::LengthUnit);
         registerParameter("offset_x", "Cell offset in X", _offsetX, 0., SegmentationParameter::LengthUnit, true);
         registerParameter("offset_z", "Cell offset in Z", _offsetZ, 0., SegmentationParameter::LengthUnit, true);
-        registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x");
-        registerIdentifier("identifier_z", "Cell ID identifier for Z", _zId, "z");
+        registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x", _xField);
+        registerIdentifier("identifier_z", "Cell ID identifier for Z", _zId, "z", _zField);
 }
 
 /// Default constructor used by derived classes passing an existing decoder
@@ -49,8 +49,8 @@ CartesianGridXZ::CartesianGridXZ(const BitFieldCoder* decode) :
         registerParameter("grid_size_z", "Cell size in Z", _gridSizeZ, 1., SegmentationParameter::LengthUnit);
         registerParameter("offset_x", "Cell offset in X", _offsetX, 0., SegmentationParameter::LengthUnit, true);
         registerParameter("offset_z", "Cell offset in Z", _offsetZ, 0., SegmentationParameter::LengthUnit, true);
-        registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x");
-        registerIdentifier("identifier_z", "Cell ID identifier for Z", _zId, "z");
+        registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x", _xField);
+        registerIdentifier("identifier_z", "Cell ID identifier for Z", _zId, "z", _zField);
 }
 
 /// destructor
@@ -62,19 +62,44 @@ CartesianGridXZ::~CartesianGridXZ() {
 Vector3D CartesianGridXZ::position(const CellID& cID) const {
         vector<double> localPosition(3);
         Vector3D cellPosition;
-        cellPosition.X = binToPosition( _decoder->get(cID,_xId ), _gridSizeX, _offsetX);
-        cellPosition.Z = binToPosition( _decoder->get(cID,_zId ), _gridSizeZ, _offsetZ);
+        cellPosition.X = binToPosition( field(_xField,_xId).value(cID), _gridSizeX, _offsetX);
+        cellPosition.Z = binToPosition( field(_zField,_zId).value(cID), _gridSizeZ, _offsetZ);
         return cellPosition;
 }
 
 /// determine the cell ID based on the position
   CellID CartesianGridXZ::cellID(const Vector3D& localPosition, const Vector3D& /* globalPosition */, const VolumeID& vID) const {
         CellID cID = vID ;
-        _decoder->set( cID,_xId, positionToBin(localPosition.X, _gridSizeX, _offsetX) );
-        _decoder->set( cID,_zId, positionToBin(localPosition.Z, _gridSizeZ, _offsetZ) );
+        field(_xField,_xId).set(cID, positionToBin(localPosition.X, _gridSizeX, _offsetX) );
+        field(_zField,_zId).set(cID, positionToBin(localPosition.Z, _gridSizeZ, _offsetZ) );
         return cID ;
 }
 
+/// determine the local positions of n cell IDs (batch version, SoA layout)
+void CartesianGridXZ::positions(std::size_t n, const CellID* cIDs, double* x, double* y, double* z) const {
+  const BatchField fx(field(_xField,_xId)), fz(field(_zField,_zId));
+  for ( std::size_t i = 0; i < n; ++i )  {
+    x[i] = fx.value(cIDs[i]) * _gridSizeX + _offsetX;
+    y[i] = 0e0;
+    z[i] = fz.value(cIDs[i]) * _gridSizeZ + _offsetZ;
+  }
+}
+
+/// determine n cell IDs from the local positions (batch version, SoA layout)
+void CartesianGridXZ::cellIDs(std::size_t n, const double* lx, const double* /* ly */, const double* lz,
+                              const double* /* gx */, const double* /* gy */, const double* /* gz */,
+                              const VolumeID* vIDs, CellID* cIDs) const {
+  const BatchField fx(field(_xField,_xId)), fz(field(_zField,_zId));
+  positionToBin(0e0, _gridSizeX, 0e0);   // Throws for invalid cell sizes
+  positionToBin(0e0, _gridSizeZ, 0e0);
+  for ( std::size_t i = 0; i < n; ++i )  {
+    CellID cID = vIDs[i];
+    fx.set(cID, positionToBinUnchecked(lx[i], _gridSizeX, _offsetX));
+    fz.set(cID, positionToBinUnchecked(lz[i], _gridSizeZ, _offsetZ));
+    cIDs[i] = cID;
+  }
+}
+
 std::vector<double> CartesianGridXZ::cellDimensions(const CellID&) const {
   return {_gridSizeX, _gridSizeZ};
 }
@@ -29,7 +29,7 @@ CartesianStripY::CartesianStripY(const std::string& cellEncoding) : CartesianStr
     // register all necessary parameters
     registerParameter("strip_size_x", "Cell size in Y", _stripSizeY, 1., SegmentationParameter::LengthUnit);
     registerParameter("offset_x", "Cell offset in Y", _offsetY, 0., SegmentationParameter::LengthUnit, true);
-    registerIdentifier("identifier_x", "Cell ID identifier for Y", _xId, "strip");
+    registerIdentifier("identifier_x", "Cell ID identifier for Y", _xId, "strip", _xField);
 }
 
 /// Default constructor used by derived classes passing an existing decoder
@@ -41,7 +41,7 @@ CartesianStripY::CartesianStripY(const BitFieldCoder* decode) : CartesianStrip(d
     // register all necessary parameters
     registerParameter("strip_size_x", "Cell size in Y", _stripSizeY, 1., SegmentationParameter::LengthUnit);
     registerParameter("offset_x", "Cell offset in Y", _offsetY, 0., SegmentationParameter::LengthUnit, true);
-    registerIdentifier("identifier_x", "Cell ID identifier for Y", _xId, "strip");
+    registerIdentifier("identifier_x", "Cell ID identifier for Y", _xId, "strip", _xField);
 }
 
 /// destructor
@@ -50,7 +50,7 @@ CartesianStripY::~CartesianStripY() {}
 /// determine the position based on the cell ID
 Vector3D CartesianStripY::position(const CellID& cID) const {
     Vector3D cellPosition;
-    cellPosition.Y = binToPosition(_decoder->get(cID, _xId), _stripSizeY, _offsetY);
+    cellPosition.Y = binToPosition(field(_xField,_xId).value(cID), _stripSizeY, _offsetY);
     return cellPosition;
 }
 
@@ -58,7 +58,7 @@ Vector3D CartesianStripY::position(const CellID& cID) const {
 CellID CartesianStripY::cellID(const Vector3D& localPosition, const Vector3D& /* globalPosition */,
                                const VolumeID& vID) const {
     CellID cID = vID;
-    _decoder->set(cID, _xId, positionToBin(localPosition.Y, _stripSizeY, _offsetY));
+    field(_xField,_xId).set(cID, positionToBin(localPosition.Y, _stripSizeY, _offsetY));
     return cID;
 }
 
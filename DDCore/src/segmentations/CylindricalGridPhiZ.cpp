@@ -36,8 +36,8 @@ CylindricalGridPhiZ::CylindricalGridPhiZ(const std::string& cellEncoding) :
         registerParameter("offset_phi", "Cell offset in phi", _offsetPhi,    0., SegmentationParameter::AngleUnit, true);
         registerParameter("offset_z",   "Cell offset in Z",   _offsetZ,      0., SegmentationParameter::LengthUnit, true);
         registerParameter("radius",     "Radius of Cylinder", _radius,       0., SegmentationParameter::LengthUnit);
-        registerIdentifier("identifier_phi", "Cell ID identifier for phi", _phiId, "phi");
-        registerIdentifier("identifier_z",   "Cell ID identifier for Z",   _zId,   "z");
+        registerIdentifier("identifier_phi", "Cell ID identifier for phi", _phiId, "phi", _phiField);
+        registerIdentifier("identifier_z",   "Cell ID identifier for Z",   _zId, "z", _zField);
 }
 
 /// Default constructor used by derived classes passing an existing decoder
@@ -53,8 +53,8 @@ CylindricalGridPhiZ::CylindricalGridPhiZ(const BitFieldCoder* decode) :
         registerParameter("offset_phi", "Cell offset in phi", _offsetPhi,    0., SegmentationParameter::AngleUnit, true);
         registerParameter("offset_z",   "Cell offset in Z",   _offsetZ,      0., SegmentationParameter::LengthUnit, true);
         registerParameter("radius",     "Radius of Cylinder", _radius,       0., SegmentationParameter::LengthUnit);
-        registerIdentifier("identifier_phi", "Cell ID identifier for phi", _phiId, "phi");
-        registerIdentifier("identifier_z",   "Cell ID identifier for Z",   _zId,   "z");
+        registerIdentifier("identifier_phi", "Cell ID identifier for phi", _phiId, "phi", _phiField);
+        registerIdentifier("identifier_z",   "Cell ID identifier for Z",   _zId, "z", _zField);
 }
 
 /// destructor
@@ -65,8 +65,7 @@ CylindricalGridPhiZ::~CylindricalGridPhiZ() {
 /// Set the underlying decoder and assign isSigned attribute to phi identifier
 void CylindricalGridPhiZ::setDecoder(const BitFieldCoder* newDecoder) {
   this->Segmentation::setDecoder(newDecoder);
-  const BitFieldElement* m_phi = &((*_decoder)[_phiId]);
-  _phiIsSigned = m_phi->isSigned();
+  _phiIsSigned = field(_phiField,_phiId).isSigned();
 }
 
 /// determine the position based on the cell ID
@@ -74,9 +73,9 @@ Vector3D CylindricalGridPhiZ::position(const CellID& cID) const {
         vector<double> localPosition(3);
         Vector3D cellPosition;
         double phi =
-          binToPosition( _decoder->get(cID,_phiId ), _gridSizePhi, _offsetPhi);
+          binToPosition( field(_phiField,_phiId).value(cID), _gridSizePhi, _offsetPhi);
         cellPosition.Z =
-          binToPosition( _decoder->get(cID,_zId ),   _gridSizeZ,   _offsetZ);
+          binToPosition( field(_zField,_zId).value(cID),   _gridSizeZ,   _offsetZ);
         const double &R = _radius;
         cellPosition.X = R*cos(phi); cellPosition.Y = R*sin(phi);
 
@@ -91,12 +90,42 @@ Vector3D CylindricalGridPhiZ::position(const CellID& cID) const {
           phi += 2*M_PI;
         }
         CellID cID = vID ;
-        _decoder->set( cID,_phiId, positionToBin(phi, _gridSizePhi, _offsetPhi) );
-        _decoder->set( cID,_zId,   positionToBin(Z,   _gridSizeZ,   _offsetZ) );
+        field(_phiField,_phiId).set(cID, positionToBin(phi, _gridSizePhi, _offsetPhi) );
+        field(_zField,_zId).set(cID, positionToBin(Z,   _gridSizeZ,   _offsetZ) );
 
         return cID ;
 }
 
+/// determine the local positions of n cell IDs (batch version, SoA layout)
+void CylindricalGridPhiZ::positions(std::size_t n, const CellID* cIDs, double* x, double* y, double* z) const {
+  const BatchField fphi(field(_phiField,_phiId)), fz(field(_zField,_zId));
+  for ( std::size_t i = 0; i < n; ++i )  {
+    double phi = fphi.value(cIDs[i]) * _gridSizePhi + _offsetPhi;
+    x[i] = _radius * cos(phi);
+    y[i] = _radius * sin(phi);
+    z[i] = fz.value(cIDs[i]) * _gridSizeZ + _offsetZ;
+  }
+}
+
+/// determine n cell IDs from the local positions (batch version, SoA layout)
+void CylindricalGridPhiZ::cellIDs(std::size_t n, const double* lx, const double* ly, const double* lz,
+                                  const double* /* gx */, const double* /* gy */, const double* /* gz */,
+                                  const VolumeID* vIDs, CellID* cIDs) const {
+  const BatchField fphi(field(_phiField,_phiId)), fz(field(_zField,_zId));
+  positionToBin(0e0, _gridSizePhi, 0e0);   // Throws for invalid cell sizes
+  positionToBin(0e0, _gridSizeZ,   0e0);
+  for ( std::size_t i = 0; i < n; ++i )  {
+    double phi = atan2(ly[i], lx[i]);
+    if (!_phiIsSigned && phi < _offsetPhi) {
+      phi += 2*M_PI;
+    }
+    CellID cID = vIDs[i];
+    fphi.set(cID, positionToBinUnchecked(phi,   _gridSizePhi, _offsetPhi));
+    fz.set(cID,   positionToBinUnchecked(lz[i], _gridSizeZ,   _offsetZ));
+    cIDs[i] = cID;
+  }
+}
+
 std::vector<double> CylindricalGridPhiZ::cellDimensions(const CellID&) const {
   return {_radius*_gridSizePhi, _gridSizeZ};
 }
@@ -25,8 +25,8 @@ GridPhiEta::GridPhiEta(const std::string& cellEncoding) :
   registerParameter("phi_bins", "Number of bins phi", m_phiBins, 1);
   registerParameter("offset_eta", "Angular offset in eta", m_offsetEta, 0., SegmentationParameter::AngleUnit, true);
   registerParameter("offset_phi", "Angular offset in phi", m_offsetPhi, 0., SegmentationParameter::AngleUnit, true);
-  registerIdentifier("identifier_eta", "Cell ID identifier for eta", m_etaID, "eta");
-  registerIdentifier("identifier_phi", "Cell ID identifier for phi", m_phiID, "phi");
+  registerIdentifier("identifier_eta", "Cell ID identifier for eta", m_etaID, "eta", m_etaField);
+  registerIdentifier("identifier_phi", "Cell ID identifier for phi", m_phiID, "phi", m_phiField);
 }
 
 GridPhiEta::GridPhiEta(const BitFieldCoder* aDecoder) :
@@ -40,8 +40,8 @@ GridPhiEta::GridPhiEta(const BitFieldCoder* aDecoder) :
   registerParameter("phi_bins", "Number of bins phi", m_phiBins, 1);
   registerParameter("offset_eta", "Angular offset in eta", m_offsetEta, 0., SegmentationParameter::AngleUnit, true);
   registerParameter("offset_phi", "Angular offset in phi", m_offsetPhi, 0., SegmentationParameter::AngleUnit, true);
-  registerIdentifier("identifier_eta", "Cell ID identifier for eta", m_etaID, "eta");
-  registerIdentifier("identifier_phi", "Cell ID identifier for phi", m_phiID, "phi");
+  registerIdentifier("identifier_eta", "Cell ID identifier for eta", m_etaID, "eta", m_etaField);
+  registerIdentifier("identifier_phi", "Cell ID identifier for phi", m_phiID, "phi", m_phiField);
 }
 
 Vector3D GridPhiEta::position(const CellID& cID) const {
@@ -52,17 +52,17 @@ CellID GridPhiEta::cellID(const Vector3D& /* localPosition */, const Vector3D& g
   double lEta = Util::etaFromXYZ(globalPosition);
   double lPhi = Util::phiFromXYZ(globalPosition);
   CellID cID = vID ;
-  _decoder->set( cID, m_etaID, positionToBin(lEta, m_gridSizeEta, m_offsetEta) );
-  _decoder->set( cID, m_phiID, positionToBin(lPhi, 2 * M_PI / (double) m_phiBins, m_offsetPhi) );
+  field(m_etaField,m_etaID).set(cID, positionToBin(lEta, m_gridSizeEta, m_offsetEta) );
+  field(m_phiField,m_phiID).set(cID, positionToBin(lPhi, 2 * M_PI / (double) m_phiBins, m_offsetPhi) );
   return cID;
 }
 
 double GridPhiEta::eta(const CellID& cID) const {
-  CellID etaValue = _decoder->get(cID, m_etaID);
+  CellID etaValue = field(m_etaField,m_etaID).value(cID);
   return binToPosition(etaValue, m_gridSizeEta, m_offsetEta);
 }
 double GridPhiEta::phi(const CellID& cID) const {
-  CellID phiValue = _decoder->get(cID, m_phiID);
+  CellID phiValue = field(m_phiField,m_phiID).value(cID);
   return binToPosition(phiValue, 2.*M_PI/(double)m_phiBins, m_offsetPhi);
 }
 }
@@ -23,7 +23,7 @@ GridRPhiEta::GridRPhiEta(const std::string& cellEncoding) :
   // register all necessary parameters (additional to those registered in GridPhiEta)
   registerParameter("grid_size_r", "Cell size in radial distance", m_gridSizeR, 1., SegmentationParameter::LengthUnit);
   registerParameter("offset_r", "Angular offset in radial distance", m_offsetR, 0., SegmentationParameter::LengthUnit, true);
-  registerIdentifier("identifier_r", "Cell ID identifier for R", m_rID, "r");
+  registerIdentifier("identifier_r", "Cell ID identifier for R", m_rID, "r", m_rField);
 }
 
 GridRPhiEta::GridRPhiEta(const BitFieldCoder* aDecoder) :
@@ -35,7 +35,7 @@ GridRPhiEta::GridRPhiEta(const BitFieldCoder* aDecoder) :
   // register all necessary parameters (additional to those registered in GridPhiEta)
   registerParameter("grid_size_r", "Cell size in radial distance", m_gridSizeR, 1., SegmentationParameter::LengthUnit);
   registerParameter("offset_r", "Angular offset in radial distance", m_offsetR, 0., SegmentationParameter::LengthUnit, true);
-  registerIdentifier("identifier_r", "Cell ID identifier for R", m_rID, "r");
+  registerIdentifier("identifier_r", "Cell ID identifier for R", m_rID, "r", m_rField);
 }
 
 Vector3D GridRPhiEta::position(const CellID& cID) const {
@@ -47,14 +47,14 @@ CellID GridRPhiEta::cellID(const Vector3D& /* localPosition */, const Vector3D&
   double lEta = Util::etaFromXYZ(globalPosition);
   double lPhi = Util::phiFromXYZ(globalPosition);
   CellID cID = vID ;
-  _decoder->set( cID, m_etaID, positionToBin(lEta, m_gridSizeEta, m_offsetEta) );
-  _decoder->set( cID, m_phiID, positionToBin(lPhi, 2 * M_PI / (double) m_phiBins, m_offsetPhi) );
-  _decoder->set( cID, m_rID  , positionToBin(lRadius, m_gridSizeR, m_offsetR) );
+  field(m_etaField,m_etaID).set(cID, positionToBin(lEta, m_gridSizeEta, m_offsetEta) );
+  field(m_phiField,m_phiID).set(cID, positionToBin(lPhi, 2 * M_PI / (double) m_phiBins, m_offsetPhi) );
+  field(m_rField,m_rID).set(cID, positionToBin(lRadius, m_gridSizeR, m_offsetR) );
   return cID;
 }
 
 double GridRPhiEta::r(const CellID& cID) const {
-  CellID rValue = _decoder->get(cID, m_rID);
+  CellID rValue = field(m_rField,m_rID).value(cID);
   return binToPosition(rValue, m_gridSizeR, m_offsetR);
 }
 }
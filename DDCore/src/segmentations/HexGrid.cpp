@@ -29,9 +29,10 @@ namespace dd4hep {
         registerParameter("side_length", "Cell size", _sideLength, 1., SegmentationParameter::LengthUnit);
         registerParameter("offset_x", "Cell offset in X", _offsetX, 0., SegmentationParameter::LengthUnit, true);
         registerParameter("offset_y", "Cell offset in Y", _offsetY, 0., SegmentationParameter::LengthUnit, true);
-        registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x");
-        registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y");
+        registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x", _xField);
+        registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y", _yField);
         registerParameter("stagger_keyword", "Volume ID identifier used for determining which volumes to stagger", _staggerKeyword, (std::string)"layer", SegmentationParameter::NoUnit, true);
+        registerField(_staggerKeyword, _staggerField);
     }
 
     /// Default constructor used by derived classes passing an existing decoder
@@ -45,9 +46,10 @@ namespace dd4hep {
         registerParameter("side_length", "Cell size", _sideLength, 1., SegmentationParameter::LengthUnit);
         registerParameter("offset_x", "Cell offset in X", _offsetX, 0., SegmentationParameter::LengthUnit, true);
         registerParameter("offset_y", "Cell offset in Y", _offsetY, 0., SegmentationParameter::LengthUnit, true);
-        registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x");
-        registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y");
+        registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x", _xField);
+        registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y", _yField);
         registerParameter("stagger_keyword", "Volume ID identifier used for determining which volumes to stagger", _staggerKeyword, (std::string)"layer", SegmentationParameter::NoUnit, true);
+        registerField(_staggerKeyword, _staggerField);
     
     }
 
@@ -58,11 +60,11 @@ namespace dd4hep {
     /// determine the position based on the cell ID
     Vector3D HexGrid::position(const CellID& cID) const {
         int layer=0;
-        if (_stagger) layer= _decoder->get(cID,_staggerKeyword);
+        if (_stagger) layer= field(_staggerField,_staggerKeyword).value(cID);
                 
         Vector3D cellPosition;
-        cellPosition.X = _decoder->get(cID,_xId )*1.5*_sideLength+_offsetX+_sideLength/2.;
-        cellPosition.Y = _decoder->get(cID,_yId )*std::sqrt(3)/2.*_sideLength+ _offsetY+_sideLength*std::sqrt(3)/2.;
+        cellPosition.X = field(_xField,_xId).value(cID)*1.5*_sideLength+_offsetX+_sideLength/2.;
+        cellPosition.Y = field(_yField,_yId).value(cID)*std::sqrt(3)/2.*_sideLength+ _offsetY+_sideLength*std::sqrt(3)/2.;
         if (_stagger==0)
           cellPosition.X+=_sideLength;
         else if (_stagger==1)
@@ -95,7 +97,7 @@ namespace dd4hep {
     CellID HexGrid::cellID(const Vector3D& localPosition, const Vector3D& /* globalPosition */, const VolumeID& vID) const {
         CellID cID = vID ;
         int layer=0;
-        if (_stagger) layer= _decoder->get(cID,_staggerKeyword);
+        if (_stagger) layer= field(_staggerField,_staggerKeyword).value(cID);
 
         double x=localPosition.X-_offsetX;
         double y=localPosition.Y-_offsetY;
@@ -127,8 +129,8 @@ namespace dd4hep {
         int iy=std::floor(y/(std::sqrt(3)*_sideLength/2.));
         iy-=(ix+iy)&1;
         
-        _decoder->set( cID,_xId, ix );
-        _decoder->set( cID,_yId, iy );
+        field(_xField,_xId).set(cID, ix );
+        field(_yField,_yId).set(cID, iy );
         return cID ;
     }
 
@@ -48,14 +48,16 @@ namespace dd4hep {
       _type = "MegatileLayerGridXY";
       _description = "Cartesian segmentation in the local XY-plane: megatiles, containing integer number of tiles/strips/cells";
 
-      registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "cellX");
-      registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "cellY");
+      registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "cellX", _xField);
+      registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "cellY", _yField);
 
       registerParameter("identifier_wafer", "Cell encoding identifier for wafer", _identifierWafer, std::string("wafer"),
                         SegmentationParameter::NoUnit, true);
+      registerField(_identifierWafer, _waferField);
 
       registerParameter("identifier_layer", "Cell encoding identifier for layer", _identifierLayer, std::string("layer"),
                         SegmentationParameter::NoUnit, true);
+      registerField(_identifierLayer, _layerField);
 
       registerParameter("identifier_module", "Cell encoding identifier for module", _identifierModule, std::string("module"),
                         SegmentationParameter::NoUnit, true);
@@ -72,10 +74,10 @@ namespace dd4hep {
     Vector3D MegatileLayerGridXY::position(const CellID& cID) const {
       // this is local position within the megatile
 
-      unsigned int layerIndex = _decoder->get(cID,_identifierLayer);
-      unsigned int waferIndex = _decoder->get(cID,_identifierWafer);
-      int cellIndexX = _decoder->get(cID,_xId);
-      int cellIndexY = _decoder->get(cID,_yId);
+      unsigned int layerIndex = field(_layerField,_identifierLayer).value(cID);
+      unsigned int waferIndex = field(_waferField,_identifierWafer).value(cID);
+      int cellIndexX = field(_xField,_xId).value(cID);
+      int cellIndexY = field(_yField,_yId).value(cID);
 
       // segmentation info for this megatile ("wafer")
       getSegInfo(layerIndex, waferIndex);
@@ -103,8 +105,8 @@ namespace dd4hep {
       // this is the local position within a megatile, local coordinates
 
       // get the layer, wafer, module indices from the volumeID
-      unsigned int layerIndex = _decoder->get(vID,_identifierLayer);
-      unsigned int waferIndex = _decoder->get(vID,_identifierWafer);
+      unsigned int layerIndex = field(_layerField,_identifierLayer).value(vID);
+      unsigned int waferIndex = field(_waferField,_identifierWafer).value(vID);
 
       // segmentation info for this megatile ("wafer")
       getSegInfo(layerIndex, waferIndex);
@@ -121,16 +123,16 @@ namespace dd4hep {
       int _cellIndexY = int ( localY / ( _currentSegInfo.megaTileSizeY / _currentSegInfo.nCellsY ) );
 
       CellID cID = vID ;
-      _decoder->set(cID,_xId,_cellIndexX);
-      _decoder->set(cID,_yId,_cellIndexY);
+      field(_xField,_xId).set(cID, _cellIndexX);
+      field(_yField,_yId).set(cID, _cellIndexY);
 
       return cID;
     }
 
 
     std::vector<double> MegatileLayerGridXY::cellDimensions(const CellID& cID) const {
-      unsigned int layerIndex = _decoder->get(cID,_identifierLayer);
-      unsigned int waferIndex = _decoder->get(cID,_identifierWafer);
+      unsigned int layerIndex = field(_layerField,_identifierLayer).value(cID);
+      unsigned int waferIndex = field(_waferField,_identifierWafer).value(cID);
       return cellDimensions(layerIndex, waferIndex);
     }
 
@@ -103,6 +103,87 @@ namespace dd4hep {
       return subsegmentation(vID).cellID(localPosition, globalPosition, vID);
     }
 
+    /// Group the entries of a batch by sub-segmentation. Unknown identifiers throw
+    std::vector<std::vector<std::size_t> >
+    MultiSegmentation::group(std::size_t n, const CellID* cIDs)   const  {
+      std::vector<std::vector<std::size_t> > groups(m_segmentations.size());
+      if ( !m_discriminator )  {
+        subsegmentation(n > 0 ? cIDs[0] : 0);   // Throws
+      }
+      for( std::size_t i = 0; i < n; ++i )  {
+        long seg_id = m_discriminator->value(cIDs[i]);
+        std::size_t j = 0;
+        for( ; j < m_segmentations.size(); ++j )  {
+          const Entry& e = m_segmentations[j];
+          if ( e.key_min <= seg_id && e.key_max >= seg_id ) break;
+        }
+        if ( j == m_segmentations.size() )  {
+          subsegmentation(cIDs[i]);             // Throws
+        }
+        groups[j].emplace_back(i);
+      }
+      return groups;
+    }
+
+    /// determine the local positions of n cell IDs. Batches are grouped by the discriminator value
+    void MultiSegmentation::positions(std::size_t n, const CellID* cIDs, double* x, double* y, double* z) const {
+      auto groups = group(n, cIDs);
+      std::vector<CellID> ids;
+      std::vector<double> px, py, pz;
+      for( std::size_t j = 0; j < groups.size(); ++j )  {
+        const auto& g = groups[j];
+        if ( g.empty() ) continue;
+        ids.resize(g.size());
+        px.resize(g.size());
+        py.resize(g.size());
+        pz.resize(g.size());
+        for( std::size_t k = 0; k < g.size(); ++k )
+          ids[k] = cIDs[g[k]];
+        m_segmentations[j].segmentation->positions(g.size(), ids.data(), px.data(), py.data(), pz.data());
+        for( std::size_t k = 0; k < g.size(); ++k )  {
+          x[g[k]] = px[k];
+          y[g[k]] = py[k];
+          z[g[k]] = pz[k];
+        }
+      }
+    }
+
+    /// determine n cell IDs from the local positions. Batches are grouped by the discriminator value
+    void MultiSegmentation::cellIDs(std::size_t n, const double* lx, const double* ly, const double* lz,
+                                    const double* gx, const double* gy, const double* gz,
+                                    const VolumeID* vIDs, CellID* cIDs) const {
+      auto groups = group(n, vIDs);
+      std::vector<VolumeID> vids;
+      std::vector<CellID>   ids;
+      std::vector<double>   pos[6];
+      for( std::size_t j = 0; j < groups.size(); ++j )  {
+        const auto& g = groups[j];
+        if ( g.empty() ) continue;
+        vids.resize(g.size());
+        ids.resize(g.size());
+        for( auto& p : pos ) p.resize(g.size());
+        for( std::size_t k = 0; k < g.size(); ++k )  {
+          std::size_t i = g[k];
+          vids[k]   = vIDs[i];
+          pos[0][k] = lx[i];
+          pos[1][k] = ly[i];
+          pos[2][k] = lz[i];
+          if ( gx )  {
+            pos[3][k] = gx[i];
+            pos[4][k] = gy[i];
+            pos[5][k] = gz[i];
+          }
+        }
+        m_segmentations[j].segmentation->cellIDs(g.size(), pos[0].data(), pos[1].data(), pos[2].data(),
+                                                 gx ? pos[3].data() : nullptr,
+                                                 gx ? pos[4].data() : nullptr,
+                                                 gx ? pos[5].data() : nullptr,
+                                                 vids.data(), ids.data());
+        for( std::size_t k = 0; k < g.size(); ++k )
+          cIDs[g[k]] = ids[k];
+      }
+    }
+
     std::vector<double> MultiSegmentation::cellDimensions(const CellID& cID) const {
       return subsegmentation(cID).cellDimensions(cID);
     }
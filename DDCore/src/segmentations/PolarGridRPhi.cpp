@@ -32,8 +32,8 @@ PolarGridRPhi::PolarGridRPhi(const std::string& cellEncoding) :
 	registerParameter("grid_size_phi", "Cell size in Phi", _gridSizePhi, 1., SegmentationParameter::AngleUnit);
 	registerParameter("offset_r", "Cell offset in R", _offsetR, 0., SegmentationParameter::LengthUnit, true);
 	registerParameter("offset_phi", "Cell offset in Phi", _offsetPhi, 0., SegmentationParameter::AngleUnit, true);
-	registerIdentifier("identifier_r", "Cell ID identifier for R", _rId, "r");
-	registerIdentifier("identifier_phi", "Cell ID identifier for Phi", _phiId, "phi");
+	registerIdentifier("identifier_r", "Cell ID identifier for R", _rId, "r", _rField);
+	registerIdentifier("identifier_phi", "Cell ID identifier for Phi", _phiId, "phi", _phiField);
 }
 
 
@@ -48,8 +48,8 @@ PolarGridRPhi::PolarGridRPhi(const BitFieldCoder* decode) : PolarGrid(decode) {
 	registerParameter("grid_size_phi", "Cell size in Phi", _gridSizePhi, 1., SegmentationParameter::AngleUnit);
 	registerParameter("offset_r", "Cell offset in R", _offsetR, 0., SegmentationParameter::LengthUnit, true);
 	registerParameter("offset_phi", "Cell offset in Phi", _offsetPhi, 0., SegmentationParameter::AngleUnit, true);
-	registerIdentifier("identifier_r", "Cell ID identifier for R", _rId, "r");
-	registerIdentifier("identifier_phi", "Cell ID identifier for Phi", _phiId, "phi");
+	registerIdentifier("identifier_r", "Cell ID identifier for R", _rId, "r", _rField);
+	registerIdentifier("identifier_phi", "Cell ID identifier for Phi", _phiId, "phi", _phiField);
 }
 
 /// destructor
@@ -60,8 +60,8 @@ PolarGridRPhi::~PolarGridRPhi() {
 /// determine the position based on the cell ID
 Vector3D PolarGridRPhi::position(const CellID& cID) const {
 	Vector3D cellPosition;
-	double R =   binToPosition(_decoder->get(cID,_rId),   _gridSizeR,   _offsetR);
-	double phi = binToPosition(_decoder->get(cID,_phiId), _gridSizePhi, _offsetPhi);
+	double R =   binToPosition(field(_rField,_rId).value(cID),   _gridSizeR,   _offsetR);
+	double phi = binToPosition(field(_phiField,_phiId).value(cID), _gridSizePhi, _offsetPhi);
 	
 	cellPosition.X = R * cos(phi);
 	cellPosition.Y = R * sin(phi);
@@ -74,13 +74,42 @@ Vector3D PolarGridRPhi::position(const CellID& cID) const {
 	double phi = atan2(localPosition.Y,localPosition.X);
 	double R = sqrt( localPosition.X * localPosition.X + localPosition.Y * localPosition.Y );
 	CellID cID = vID ;
-	_decoder->set(cID,_rId  , positionToBin(R, _gridSizeR, _offsetR));
-	_decoder->set(cID,_phiId, positionToBin(phi, _gridSizePhi, _offsetPhi));
+	field(_rField,_rId).set(cID, positionToBin(R, _gridSizeR, _offsetR));
+	field(_phiField,_phiId).set(cID, positionToBin(phi, _gridSizePhi, _offsetPhi));
 	return cID;
 }
 
+/// determine the local positions of n cell IDs (batch version, SoA layout)
+void PolarGridRPhi::positions(std::size_t n, const CellID* cIDs, double* x, double* y, double* z) const {
+  const BatchField fr(field(_rField,_rId)), fphi(field(_phiField,_phiId));
+  for ( std::size_t i = 0; i < n; ++i )  {
+    double R   = fr.value(cIDs[i])   * _gridSizeR   + _offsetR;
+    double phi = fphi.value(cIDs[i]) * _gridSizePhi + _offsetPhi;
+    x[i] = R * cos(phi);
+    y[i] = R * sin(phi);
+    z[i] = 0e0;
+  }
+}
+
+/// determine n cell IDs from the local positions (batch version, SoA layout)
+void PolarGridRPhi::cellIDs(std::size_t n, const double* lx, const double* ly, const double* /* lz */,
+                            const double* /* gx */, const double* /* gy */, const double* /* gz */,
+                            const VolumeID* vIDs, CellID* cIDs) const {
+  const BatchField fr(field(_rField,_rId)), fphi(field(_phiField,_phiId));
+  positionToBin(0e0, _gridSizeR,   0e0);   // Throws for invalid cell sizes
+  positionToBin(0e0, _gridSizePhi, 0e0);
+  for ( std::size_t i = 0; i < n; ++i )  {
+    double phi = atan2(ly[i], lx[i]);
+    double R   = sqrt(lx[i] * lx[i] + ly[i] * ly[i]);
+    CellID cID = vIDs[i];
+    fr.set(cID,   positionToBinUnchecked(R,   _gridSizeR,   _offsetR));
+    fphi.set(cID, positionToBinUnchecked(phi, _gridSizePhi, _offsetPhi));
+    cIDs[i] = cID;
+  }
+}
+
 std::vector<double> PolarGridRPhi::cellDimensions(const CellID& cID) const {
-  const double rPhiSize = binToPosition(_decoder->get(cID,_rId), _gridSizeR, _offsetR)*_gridSizePhi;
+  const double rPhiSize = binToPosition(field(_rField,_rId).value(cID), _gridSizeR, _offsetR)*_gridSizePhi;
   return {_gridSizeR, rPhiSize};
 }
 
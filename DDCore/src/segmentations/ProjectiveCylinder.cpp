@@ -39,8 +39,8 @@ ProjectiveCylinder::ProjectiveCylinder(const std::string& cellEncoding) :
         registerParameter("phi_bins", "Number of bins phi", _phiBins, 1);
         registerParameter("offset_theta", "Angular offset in theta", _offsetTheta, 0., SegmentationParameter::AngleUnit, true);
         registerParameter("offset_phi", "Angular offset in phi", _offsetPhi, 0., SegmentationParameter::AngleUnit, true);
-        registerIdentifier("identifier_theta", "Cell ID identifier for theta", _thetaID, "theta");
-        registerIdentifier("identifier_phi", "Cell ID identifier for phi", _phiID, "phi");
+        registerIdentifier("identifier_theta", "Cell ID identifier for theta", _thetaID, "theta", _thetaField);
+        registerIdentifier("identifier_phi", "Cell ID identifier for phi", _phiID, "phi", _phiField);
 }
 
 
@@ -55,8 +55,8 @@ ProjectiveCylinder::ProjectiveCylinder(const BitFieldCoder* decode) :        Cyl
         registerParameter("phi_bins", "Number of bins phi", _phiBins, 1);
         registerParameter("offset_theta", "Angular offset in theta", _offsetTheta, 0., SegmentationParameter::AngleUnit, true);
         registerParameter("offset_phi", "Angular offset in phi", _offsetPhi, 0., SegmentationParameter::AngleUnit, true);
-        registerIdentifier("identifier_theta", "Cell ID identifier for theta", _thetaID, "theta");
-        registerIdentifier("identifier_phi", "Cell ID identifier for phi", _phiID, "phi");
+        registerIdentifier("identifier_theta", "Cell ID identifier for theta", _thetaID, "theta", _thetaField);
+        registerIdentifier("identifier_phi", "Cell ID identifier for phi", _phiID, "phi", _phiField);
 }
 
 /// destructor
@@ -74,19 +74,19 @@ CellID ProjectiveCylinder::cellID(const Vector3D& /* localPosition */, const Vec
         CellID cID = vID ;
         double lTheta = thetaFromXYZ(globalPosition);
         double lPhi = phiFromXYZ(globalPosition);
-        _decoder->set(cID,_thetaID, positionToBin(lTheta, M_PI / (double) _thetaBins, _offsetTheta));
-        _decoder->set(cID,_phiID  , positionToBin(lPhi, 2 * M_PI / (double) _phiBins, _offsetPhi));
+        field(_thetaField,_thetaID).set(cID, positionToBin(lTheta, M_PI / (double) _thetaBins, _offsetTheta));
+        field(_phiField,_phiID).set(cID, positionToBin(lPhi, 2 * M_PI / (double) _phiBins, _offsetPhi));
         return cID;
 }
 
 /// determine the polar angle theta based on the cell ID
 double ProjectiveCylinder::theta(const CellID& cID) const {
-        CellID thetaIndex = _decoder->get(cID,_thetaID);
+        CellID thetaIndex = field(_thetaField,_thetaID).value(cID);
         return M_PI * ((double) thetaIndex + 0.5) / (double) _thetaBins;
 }
 /// determine the azimuthal angle phi based on the cell ID
 double ProjectiveCylinder::phi(const CellID& cID) const {
-        CellID phiIndex = _decoder->get(cID,_phiID);
+        CellID phiIndex = field(_phiField,_phiID).value(cID);
         return 2. * M_PI * ((double) phiIndex + 0.5) / (double) _phiBins;
 }
 
@@ -35,6 +35,23 @@ namespace dd4hep {
     using std::stringstream;
     using std::vector;
 
+    /// String parameter holding a field name: changing the value re-resolves the bit field elements
+    class Segmentation::IdentifierParameter : public TypedSegmentationParameter<std::string>  {
+    public:
+      /// Reference to the segmentation owning the parameter
+      Segmentation* segmentation;
+      /// Initializing constructor
+      IdentifierParameter(Segmentation* seg, const std::string& nam, const std::string& desc, std::string& val,
+                          const std::string& defaultVal, UnitType unitTyp, bool isOpt)
+        : TypedSegmentationParameter<std::string>(nam, desc, val, defaultVal, unitTyp, isOpt), segmentation(seg)  {
+      }
+      /// Set the parameter value in string representation and re-resolve the bit field elements
+      virtual void setValue(const std::string& val) override  {
+        this->TypedSegmentationParameter<std::string>::setValue(val);
+        segmentation->resolveIdentifiers();
+      }
+    };
+
     /// Default constructor used by derived classes passing the encoding string
     Segmentation::Segmentation(const std::string& cellEncoding) :
       _name("Segmentation"), _type("Segmentation"), _decoder(new BitFieldCoder(cellEncoding)), _ownsDecoder(true) {
@@ -62,8 +79,31 @@ namespace dd4hep {
       throw std::runtime_error("This segmentation type:"+_type+" does not support sub-segmentations.");
     }
 
+    /// Batch version of position(): determine the local positions of n cell IDs (SoA layout)
+    void Segmentation::positions(std::size_t n, const CellID* cIDs, double* x, double* y, double* z) const {
+      for ( std::size_t i = 0; i < n; ++i )  {
+        Vector3D p = position(cIDs[i]);
+        x[i] = p.X;
+        y[i] = p.Y;
+        z[i] = p.Z;
+      }
+    }
+
+    /// Batch version of cellID(): determine n cell IDs from local and global positions (SoA layout)
+    void Segmentation::cellIDs(std::size_t n, const double* lx, const double* ly, const double* lz,
+                               const double* gx, const double* gy, const double* gz,
+                               const VolumeID* vIDs, CellID* cIDs) const {
+      for ( std::size_t i = 0; i < n; ++i )  {
+        Vector3D local(lx[i], ly[i], lz[i]);
+        cIDs[i] = gx ? cellID(local, Vector3D(gx[i], gy[i], gz[i]), vIDs[i]) : cellID(local, local, vIDs[i]);
+      }
+    }
+
     /// Determine the volume ID from the full cell ID by removing all local fields
     VolumeID Segmentation::volumeID(const CellID& cID) const {
+      if ( _identifiersResolved )  {
+        return cID & ~_identifierMask;
+      }
       map<std::string, StringParameter>::const_iterator it;
       VolumeID vID = cID ;
       for (it = _indexIdentifiers.begin(); it != _indexIdentifiers.end(); ++it) {
@@ -98,12 +138,14 @@ namespace dd4hep {
 
     /// Set the underlying decoder
     void Segmentation::setDecoder(const BitFieldCoder* newDecoder) {
-      if ( _decoder == newDecoder )
-        return; //self assignment
-      else if (_ownsDecoder)
-        delete _decoder;
-      _decoder = newDecoder;
-      _ownsDecoder = false;
+      if ( _decoder != newDecoder )  {
+        if (_ownsDecoder)
+          delete _decoder;
+        _decoder = newDecoder;
+        _ownsDecoder = false;
+      }
+      // Identifiers may have been changed since the last call: always re-resolve
+      resolveIdentifiers();
     }
 
     /// Access to parameter by name
@@ -129,16 +171,63 @@ namespace dd4hep {
     void Segmentation::setParameters(const Parameters& pars) {
       for ( const auto* p : pars )
         parameter(p->name())->value() = p->value();
+      resolveIdentifiers();
     }
 
     /// Add a cell identifier to this segmentation. Used by derived classes to define their required identifiers
     void Segmentation::registerIdentifier(const std::string& idName, const std::string& idDescription, std::string& identifier,
                                           const std::string& defaultValue) {
       StringParameter idParameter =
-        new TypedSegmentationParameter<std::string>(idName, idDescription, identifier, defaultValue,
-                                                    SegmentationParameter::NoUnit, true);
+        new IdentifierParameter(this, idName, idDescription, identifier, defaultValue,
+                                SegmentationParameter::NoUnit, true);
       _parameters[idName]       = idParameter;
       _indexIdentifiers[idName] = idParameter;
+      resolveIdentifiers();
+    }
+
+    /// Add a cell identifier and bind the bit field element resolved whenever the decoder or the identifier changes
+    void Segmentation::registerIdentifier(const std::string& idName, const std::string& idDescription, std::string& identifier,
+                                          const std::string& defaultValue, const BitFieldElement*& field) {
+      registerIdentifier(idName, idDescription, identifier, defaultValue);
+      registerField(identifier, field);
+    }
+
+    /// Bind a bit field element to a field name of the decoder. Resolved together with the identifiers
+    void Segmentation::registerField(std::string& identifier, const BitFieldElement*& field) {
+      // A plain string parameter holding the field name must notify changes: replace it
+      for ( auto& p : _parameters )  {
+        StringParameter str = dynamic_cast<StringParameter>(p.second);
+        if ( str && &str->typedValue() == &identifier && !dynamic_cast<IdentifierParameter*>(str) )  {
+          std::string value = identifier;
+          p.second = new IdentifierParameter(this, str->name(), str->description(), identifier,
+                                             str->typedDefaultValue(), str->unitType(), str->isOptional());
+          delete str;
+          identifier = value;
+          break;
+        }
+      }
+      _identifierFields.emplace_back(&identifier, &field);
+      resolveIdentifiers();
+    }
+
+    /// Resolve the bit field elements of all registered cell identifiers and bound fields
+    void Segmentation::resolveIdentifiers() {
+      auto find_field = [this](const std::string& identifier) -> const BitFieldElement*  {
+        if ( _decoder )  {
+          for ( const auto& f : _decoder->fields() )
+            if ( f.name() == identifier ) return &f;
+        }
+        return 0;
+      };
+      _identifierMask = 0;
+      _identifiersResolved = (_decoder != 0);
+      for ( const auto& it : _indexIdentifiers )  {
+        const BitFieldElement* f = find_field(it.second->typedValue());
+        if ( f ) _identifierMask |= f->mask();
+        else     _identifiersResolved = false;
+      }
+      for ( auto& it : _identifierFields )
+        *it.second = find_field(*it.first);
     }
 
     /// Helper method to convert a bin number to a 1D position
@@ -39,9 +39,9 @@ TiledLayerGridXY::TiledLayerGridXY(const std::string& cellEncoding) :
         registerParameter("grid_size_y", "Cell size in Y", _gridSizeY, 1., SegmentationParameter::LengthUnit);
         registerParameter("offset_x", "Cell offset in X", _offsetX, 0., SegmentationParameter::LengthUnit, true);
         registerParameter("offset_y", "Cell offset in Y", _offsetY, 0., SegmentationParameter::LengthUnit, true);
-        registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x");
-        registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y");
-        registerIdentifier("identifier_layer", "Cell encoding identifier for layer", _identifierLayer, "layer");
+        registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x", _xField);
+        registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y", _yField);
+        registerIdentifier("identifier_layer", "Cell encoding identifier for layer", _identifierLayer, "layer", _layerField);
         registerParameter("layer_offsetX", "List of layer x offset", _layerOffsetX, std::vector<double>(),
                         SegmentationParameter::NoUnit, true);
         registerParameter("layer_offsetY", "List of layer y offset", _layerOffsetY, std::vector<double>(),
@@ -61,9 +61,9 @@ TiledLayerGridXY::TiledLayerGridXY(const BitFieldCoder* decode) : CartesianGrid(
         registerParameter("grid_size_y", "Cell size in Y", _gridSizeY, 1., SegmentationParameter::LengthUnit);
         registerParameter("offset_x", "Cell offset in X", _offsetX, 0., SegmentationParameter::LengthUnit, true);
         registerParameter("offset_y", "Cell offset in Y", _offsetY, 0., SegmentationParameter::LengthUnit, true);
-        registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x");
-        registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y");
-        registerIdentifier("identifier_layer", "Cell encoding identifier for layer", _identifierLayer, "layer");
+        registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x", _xField);
+        registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y", _yField);
+        registerIdentifier("identifier_layer", "Cell encoding identifier for layer", _identifierLayer, "layer", _layerField);
         registerParameter("layer_offsetX", "List of layer x offset", _layerOffsetX, std::vector<double>(),
                         SegmentationParameter::NoUnit, true);
         registerParameter("layer_offsetY", "List of layer y offset", _layerOffsetY, std::vector<double>(),
@@ -81,10 +81,10 @@ Vector3D TiledLayerGridXY::position(const CellID& cID) const {
         Vector3D cellPosition;
 
         // AHcal: _layerIndex is [1,48], _layerOffsetX is [0,47]
-        _layerIndex = _decoder->get(cID,_identifierLayer);
+        _layerIndex = field(_layerField,_identifierLayer).value(cID);
 
         if ( _layerOffsetX.size() != 0 && _layerIndex <=_layerOffsetX.size() ) {
-          cellPosition.X = binToPosition(_decoder->get(cID,_xId), _gridSizeX, _layerOffsetX[_layerIndex - 1]*_gridSizeX/2.);
+          cellPosition.X = binToPosition(field(_xField,_xId).value(cID), _gridSizeX, _layerOffsetX[_layerIndex - 1]*_gridSizeX/2.);
           // check the integer cell boundary in x,
           if ( ( _layerDimX.size() != 0 && _layerIndex <= _layerDimX.size() )
                &&( _fractCellSizeXPerLayer.size() != 0 && _layerIndex <=  _fractCellSizeXPerLayer.size() )
@@ -96,9 +96,9 @@ Vector3D TiledLayerGridXY::position(const CellID& cID) const {
                 *(_layerDimX.at(_layerIndex - 1) - _fractCellSizeXPerLayer.at(_layerIndex - 1)/2.0) ;
             }
         } else {
-          cellPosition.X = binToPosition(_decoder->get(cID,_xId), _gridSizeX, _offsetX);
+          cellPosition.X = binToPosition(field(_xField,_xId).value(cID), _gridSizeX, _offsetX);
         }
-        cellPosition.Y = binToPosition(_decoder->get(cID,_yId), _gridSizeY, _offsetY);
+        cellPosition.Y = binToPosition(field(_yField,_yId).value(cID), _gridSizeY, _offsetY);
         return cellPosition;
 }
 
@@ -108,14 +108,14 @@ Vector3D TiledLayerGridXY::position(const CellID& cID) const {
         unsigned int _layerIndex;
 
         // AHcal: _layerIndex is [1,48], _layerOffsetX is [0,47]
-        _layerIndex = _decoder->get(cID,_identifierLayer);
+        _layerIndex = field(_layerField,_identifierLayer).value(cID);
 
         if ( _layerOffsetX.size() != 0 && _layerIndex <=_layerOffsetX.size() ) {
-          _decoder->set(cID,_xId,positionToBin(localPosition.X, _gridSizeX, _layerOffsetX[_layerIndex - 1]*_gridSizeX/2.));
+          field(_xField,_xId).set(cID, positionToBin(localPosition.X, _gridSizeX, _layerOffsetX[_layerIndex - 1]*_gridSizeX/2.));
         } else {
-          _decoder->set(cID,_xId,positionToBin(localPosition.X, _gridSizeX, _offsetX));
+          field(_xField,_xId).set(cID, positionToBin(localPosition.X, _gridSizeX, _offsetX));
         }
-        _decoder->set(cID,_yId, positionToBin(localPosition.Y, _gridSizeY, _offsetY));
+        field(_yField,_yId).set(cID, positionToBin(localPosition.Y, _gridSizeY, _offsetY));
         return cID;
 }
 
@@ -38,10 +38,11 @@ TiledLayerSegmentation::TiledLayerSegmentation(const std::string& cellEncoding)
 	// register all necessary parameters
 	registerParameter("grid_size_x", "Default cell size in X", _gridSizeX, 1., SegmentationParameter::LengthUnit);
 	registerParameter("grid_size_y", "Default cell size in Y", _gridSizeY, 1., SegmentationParameter::LengthUnit);
-	registerIdentifier("identifier_x", "Cell encoding identifier for X", _identifierX, "x");
-	registerIdentifier("identifier_y", "Cell encoding identifier for Y", _identifierY, "y");
+	registerIdentifier("identifier_x", "Cell encoding identifier for X", _identifierX, "x", _xField);
+	registerIdentifier("identifier_y", "Cell encoding identifier for Y", _identifierY, "y", _yField);
 	registerParameter("identifier_layer", "Cell encoding identifier for layer", _identifierLayer, std::string("layer"),
 			SegmentationParameter::NoUnit, true);
+	registerField(_identifierLayer, _layerField);
 	registerParameter("layer_identifiers", "List of valid layer identifiers", _layerIndices, vector<int>(),
 			SegmentationParameter::NoUnit, true);
 	registerParameter("x_dimensions", "List of layer x dimensions", _layerDimensionsX, vector<double>(),
@@ -59,10 +60,11 @@ TiledLayerSegmentation::TiledLayerSegmentation(const BitFieldCoder* decode) :	Se
 	// register all necessary parameters
 	registerParameter("grid_size_x", "Default cell size in X", _gridSizeX, 1., SegmentationParameter::LengthUnit);
 	registerParameter("grid_size_y", "Default cell size in Y", _gridSizeY, 1., SegmentationParameter::LengthUnit);
-	registerIdentifier("identifier_x", "Cell encoding identifier for X", _identifierX, "x");
-	registerIdentifier("identifier_y", "Cell encoding identifier for Y", _identifierY, "y");
+	registerIdentifier("identifier_x", "Cell encoding identifier for X", _identifierX, "x", _xField);
+	registerIdentifier("identifier_y", "Cell encoding identifier for Y", _identifierY, "y", _yField);
 	registerParameter("identifier_layer", "Cell encoding identifier for layer", _identifierLayer, std::string("layer"),
 			SegmentationParameter::NoUnit, true);
+	registerField(_identifierLayer, _layerField);
 	registerParameter("layer_identifiers", "List of valid layer identifiers", _layerIndices, vector<int>(),
 			SegmentationParameter::NoUnit, true);
 	registerParameter("x_dimensions", "List of layer x dimensions", _layerDimensionsX, vector<double>(),
@@ -126,28 +128,28 @@ TiledLayerSegmentation::LayerDimensions TiledLayerSegmentation::layerDimensions(
 
 /// determine the position based on the cell ID
 Vector3D TiledLayerSegmentation::position(const CellID& cID) const {
-	int layerIndex = _decoder->get(cID,_identifierLayer);
+	int layerIndex = field(_layerField,_identifierLayer).value(cID);
 	double cellSizeX = layerGridSizeX(layerIndex);
 	double cellSizeY = layerGridSizeY(layerIndex);
 	LayerDimensions dimensions = layerDimensions(layerIndex);
 	double offsetX = calculateOffset(cellSizeX, dimensions.x);
 	double offsetY = calculateOffset(cellSizeY, dimensions.y);
-	double localX = binToPosition(_decoder->get(cID,_identifierX), cellSizeX, offsetX);
-	double localY = binToPosition(_decoder->get(cID,_identifierY), cellSizeY, offsetY);
+	double localX = binToPosition(field(_xField,_identifierX).value(cID), cellSizeX, offsetX);
+	double localY = binToPosition(field(_yField,_identifierY).value(cID), cellSizeY, offsetY);
 	return Vector3D(localX, localY, 0.);
 }
 /// determine the cell ID based on the position
   CellID TiledLayerSegmentation::cellID(const Vector3D& localPosition, const Vector3D& /* globalPosition */,
 		const VolumeID& vID) const {
 	CellID cID = vID ;
-	int layerIndex = _decoder->get(cID,_identifierLayer);
+	int layerIndex = field(_layerField,_identifierLayer).value(cID);
 	double cellSizeX = layerGridSizeX(layerIndex);
 	double cellSizeY = layerGridSizeY(layerIndex);
 	LayerDimensions dimensions = layerDimensions(layerIndex);
 	double offsetX = calculateOffset(cellSizeX, dimensions.x);
 	double offsetY = calculateOffset(cellSizeY, dimensions.y);
-	_decoder->set(cID,_identifierX, positionToBin(localPosition.x(), cellSizeX, offsetX));
-	_decoder->set(cID,_identifierY, positionToBin(localPosition.y(), cellSizeY, offsetY));
+	field(_xField,_identifierX).set(cID, positionToBin(localPosition.x(), cellSizeX, offsetX));
+	field(_yField,_identifierY).set(cID, positionToBin(localPosition.y(), cellSizeY, offsetY));
 	return cID;
 }
 
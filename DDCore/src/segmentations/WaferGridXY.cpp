@@ -32,12 +32,14 @@ WaferGridXY::WaferGridXY(const std::string& cellEncoding) :
         registerParameter("grid_size_y", "Cell size in Y", _gridSizeY, 1., SegmentationParameter::LengthUnit);
         registerParameter("offset_x", "Cell offset in X", _offsetX, 0., SegmentationParameter::LengthUnit, true);
         registerParameter("offset_y", "Cell offset in Y", _offsetY, 0., SegmentationParameter::LengthUnit, true);
-        registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x");
-        registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y");
+        registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x", _xField);
+        registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y", _yField);
         registerParameter("identifier_groupMGWafer", "Cell encoding identifier for Magic Wafer group", _identifierMGWaferGroup, std::string("layer"),
                         SegmentationParameter::NoUnit, true);
+        registerField(_identifierMGWaferGroup, _groupMGWaferField);
         registerParameter("identifier_wafer", "Cell encoding identifier for wafer", _identifierWafer, std::string("wafer"),
                         SegmentationParameter::NoUnit, true);
+        registerField(_identifierWafer, _waferField);
 }
 
 /// Default constructor used by derived classes passing an existing decoder
@@ -51,12 +53,14 @@ WaferGridXY::WaferGridXY(const BitFieldCoder* decode) :        CartesianGrid(dec
         registerParameter("grid_size_y", "Cell size in Y", _gridSizeY, 1., SegmentationParameter::LengthUnit);
         registerParameter("offset_x", "Cell offset in X", _offsetX, 0., SegmentationParameter::LengthUnit, true);
         registerParameter("offset_y", "Cell offset in Y", _offsetY, 0., SegmentationParameter::LengthUnit, true);
-        registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x");
-        registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y");
+        registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x", _xField);
+        registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y", _yField);
         registerParameter("identifier_groupMGWafer", "Cell encoding identifier for Magic Wafer group", _identifierMGWaferGroup, std::string("layer"),
                         SegmentationParameter::NoUnit, true);
+        registerField(_identifierMGWaferGroup, _groupMGWaferField);
         registerParameter("identifier_wafer", "Cell encoding identifier for wafer", _identifierWafer, std::string("wafer"),
                         SegmentationParameter::NoUnit, true);
+        registerField(_identifierWafer, _waferField);
 }
 
 /// destructor
@@ -70,25 +74,25 @@ Vector3D WaferGridXY::position(const CellID& cID) const {
         unsigned int _waferIndex;
         Vector3D cellPosition;
 
-        _groupMGWaferIndex = _decoder->get(cID,_identifierMGWaferGroup);
-        _waferIndex = _decoder->get(cID,_identifierWafer);
+        _groupMGWaferIndex = field(_groupMGWaferField,_identifierMGWaferGroup).value(cID);
+        _waferIndex = field(_waferField,_identifierWafer).value(cID);
 
         if ( _waferOffsetX[_groupMGWaferIndex][_waferIndex] > 0 || _waferOffsetX[_groupMGWaferIndex][_waferIndex] < 0 )
           {
-            cellPosition.X = binToPosition(_decoder->get(cID,_xId), _gridSizeX, _offsetX+_waferOffsetX[_groupMGWaferIndex][_waferIndex]);
+            cellPosition.X = binToPosition(field(_xField,_xId).value(cID), _gridSizeX, _offsetX+_waferOffsetX[_groupMGWaferIndex][_waferIndex]);
           }
         else
           {
-            cellPosition.X = binToPosition(_decoder->get(cID,_xId), _gridSizeX, _offsetX);
+            cellPosition.X = binToPosition(field(_xField,_xId).value(cID), _gridSizeX, _offsetX);
           }
 
         if ( _waferOffsetY[_groupMGWaferIndex][_waferIndex] > 0 || _waferOffsetY[_groupMGWaferIndex][_waferIndex] < 0 )
           {
-            cellPosition.Y = binToPosition(_decoder->get(cID,_yId), _gridSizeY, _offsetY+_waferOffsetY[_groupMGWaferIndex][_waferIndex]);
+            cellPosition.Y = binToPosition(field(_yField,_yId).value(cID), _gridSizeY, _offsetY+_waferOffsetY[_groupMGWaferIndex][_waferIndex]);
           }
         else
           {
-            cellPosition.Y = binToPosition(_decoder->get(cID,_yId), _gridSizeY, _offsetY);
+            cellPosition.Y = binToPosition(field(_yField,_yId).value(cID), _gridSizeY, _offsetY);
           }
 
         return cellPosition;
@@ -101,25 +105,25 @@ Vector3D WaferGridXY::position(const CellID& cID) const {
 
         CellID cID = vID ;
 
-        _groupMGWaferIndex = _decoder->get(cID,_identifierMGWaferGroup);
-        _waferIndex = _decoder->get(cID,_identifierWafer);
+        _groupMGWaferIndex = field(_groupMGWaferField,_identifierMGWaferGroup).value(cID);
+        _waferIndex = field(_waferField,_identifierWafer).value(cID);
 
         if ( _waferOffsetX[_groupMGWaferIndex][_waferIndex] > 0 || _waferOffsetX[_groupMGWaferIndex][_waferIndex] < 0 )
           {
-            _decoder->set(cID,_xId, positionToBin(localPosition.X, _gridSizeX, _offsetX+_waferOffsetX[_groupMGWaferIndex][_waferIndex]));
+            field(_xField,_xId).set(cID, positionToBin(localPosition.X, _gridSizeX, _offsetX+_waferOffsetX[_groupMGWaferIndex][_waferIndex]));
           }
         else
           {
-            _decoder->set(cID,_xId, positionToBin(localPosition.X, _gridSizeX, _offsetX));
+            field(_xField,_xId).set(cID, positionToBin(localPosition.X, _gridSizeX, _offsetX));
           }
 
         if ( _waferOffsetY[_groupMGWaferIndex][_waferIndex] > 0 ||  _waferOffsetY[_groupMGWaferIndex][_waferIndex] < 0)
           {
-            _decoder->set(cID,_yId, positionToBin(localPosition.Y, _gridSizeY, _offsetY+_waferOffsetY[_groupMGWaferIndex][_waferIndex]));
+            field(_yField,_yId).set(cID, positionToBin(localPosition.Y, _gridSizeY, _offsetY+_waferOffsetY[_groupMGWaferIndex][_waferIndex]));
           }
         else
           {
-            _decoder->set(cID,_yId, positionToBin(localPosition.Y, _gridSizeY, _offsetY));
+            field(_yField,_yId).set(cID, positionToBin(localPosition.Y, _gridSizeY, _offsetY));
           }
 
         return cID;
@@ -60,6 +60,8 @@ namespace dd4hep {
       bool                           m_erase_combined;
       /// Property: Flag to indicate to merge 
       bool                           m_merge_deposits;
+      /// Property: Flag to combine deposits of identical cells in the (flat) output vector
+      bool                           m_combine_cells;
       /// Property: Flag to indicate to merge 
       bool                           m_merge_response;
       /// Property: Flag to indicate to merge 
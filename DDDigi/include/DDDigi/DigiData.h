@@ -589,6 +589,8 @@ namespace dd4hep {
 
     protected:
       container_t    data      { };
+      /// Flag set if the vector is ordered by cell and every cell occurs only once
+      bool           combined  { false };
 
     public: 
       /// Initializing constructor
@@ -619,6 +621,14 @@ namespace dd4hep {
       std::size_t insert(const DepositMapping& updates);
       /// Emplace entry
       void emplace(CellID cell, EnergyDeposit&& deposit);
+      /// Order the deposits by cell and combine deposits of identical cells (flat map mode)
+      /** After the call the vector behaves like a deposit mapping with unique keys
+       *  and contiguous storage. Lookups by cell use binary search until the next
+       *  modification. Returns the number of folded deposits.
+       */
+      std::size_t combine();
+      /// Check if the vector is ordered by cell with unique cells
+      bool        is_combined()  const    { return this->combined;           }
 
       /// Access container size
       std::size_t size()  const           { return this->data.size();        }
@@ -651,10 +661,20 @@ namespace dd4hep {
     /// Emplace entry
     inline void DepositVector::emplace(CellID cell, EnergyDeposit&& deposit)   {
       this->data.emplace_back(cell, std::move(deposit));
+      this->combined = false;
     }
 
     /// Energy deposit mapping definition for digitization
     /**
+     *  The container is deliberately kept as a std::multimap:
+     *  - processors erase entries while iterating and rely on stable iterators
+     *    and on data.find() (e.g. DigiDepositDropKilled),
+     *  - several deposits of the same cell may coexist (insert semantics),
+     *  - the ROOT dictionary streams the container as a multimap, hence a
+     *    different container would change the format of existing files.
+     *  The flat, contiguous alternative is DepositVector: DepositVector::combine()
+     *  orders the deposits by cell and folds identical cells. DigiContainerCombine
+     *  produces such output with the property 'combine_cells'.
      *
      *  \author  M.Frank
      *  \version 1.0
@@ -687,6 +707,9 @@ namespace dd4hep {
       /// Disable copy assignment
       DepositMapping& operator=(const DepositMapping& copy) = default;      
 
+      /** Bulk merges: the updates are processed in cell order, hence the map is
+       *  traversed once with insertion hints instead of one tree search per deposit.
+       */
       /// Merge new deposit map onto existing map (not thread safe!)
       std::size_t merge(DepositMapping&& updates);
       /// Merge new deposit map onto existing map (not thread safe!)
@@ -116,6 +116,10 @@ public:
         used_keys_insert(keys[j]);
       }
     }
+    if ( combine->m_combine_cells )   {
+      std::size_t folded = out.combine();
+      combine->info(format, thr, nam.c_str(), key.mask(), folded, "folded cells");
+    }
     key.set_mask(combine->m_deposit_mask);
     outputs.emplace(std::move(key), std::move(out));
   }
@@ -248,6 +252,7 @@ DigiContainerCombine::DigiContainerCombine(const DigiKernel& krnl, const std::st
   declareProperty("output_name_flag", m_output_name_flag);
   declareProperty("erase_combined",   m_erase_combined  = false);
   declareProperty("merge_deposits",   m_merge_deposits  = true);
+  declareProperty("combine_cells",    m_combine_cells   = false);
   declareProperty("merge_response",   m_merge_response  = true);
   declareProperty("merge_history",    m_merge_history   = true);
   declareProperty("merge_particles",  m_merge_particles = false);
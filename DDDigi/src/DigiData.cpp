@@ -19,6 +19,7 @@
 #include <DDDigi/DigiData.h>
 
 // C/C++ include files
+#include <algorithm>
 #include <mutex>
 
 namespace   {
@@ -186,8 +187,9 @@ std::size_t DepositVector::merge(DepositVector&& updates)    {
   std::size_t newlen = std::max(2*data.size(), data.size()+updates.size());
   data.reserve(newlen);
   for( auto& c : updates )    {
-    data.emplace_back(c);
+    data.emplace_back(c.first, std::move(c.second));
   }
+  combined = combined && update_size == 0;
   return update_size;
 }
 
@@ -196,9 +198,10 @@ std::size_t DepositVector::merge(DepositMapping&& updates)    {
   std::size_t update_size = updates.size();
   std::size_t newlen = std::max(2*data.size(), data.size()+updates.size());
   data.reserve(newlen);
-  for( const auto& c : updates )    {
-    data.emplace_back(c);
+  for( auto& c : updates )    {
+    data.emplace_back(c.first, std::move(c.second));
   }
+  combined = combined && update_size == 0;
   return update_size;
 }
 
@@ -210,6 +213,7 @@ std::size_t DepositVector::insert(const DepositVector& updates)    {
   for( const auto& c : updates )    {
     data.emplace_back(c);
   }
+  combined = combined && update_size == 0;
   return update_size;
 }
 
@@ -221,14 +225,87 @@ std::size_t DepositVector::insert(const DepositMapping& updates)    {
   for( const auto& c : updates )    {
     data.emplace_back(c);
   }
+  combined = combined && update_size == 0;
   return update_size;
 }
 
+namespace  {
+  /// Order container entries by cell identifier. Entries of identical cells keep their order
+  template <typename ITER> std::vector<ITER> order_by_cell(ITER begin, ITER end)   {
+    std::vector<ITER> order;
+    order.reserve(std::distance(begin, end));
+    for( ITER i = begin; i != end; ++i )
+      order.emplace_back(i);
+    std::stable_sort(order.begin(), order.end(), [](const ITER& a, const ITER& b)  {
+      return a->first < b->first;
+    });
+    return order;
+  }
+
+  /// Bulk insertion of deposits ordered by cell into a deposit map
+  /**
+   *  The map is traversed once together with the ordered updates.
+   *  Each insertion is done with the exact position as hint, which avoids
+   *  a tree search per deposit. If the number of updates is small compared
+   *  to the size of the map, the position is located with a tree search.
+   *
+   *  fold = true:  Deposits of cells present are combined (merge semantics)
+   *  fold = false: Deposits are added behind existing ones (insert semantics)
+   */
+  template <typename ITER, typename ACCESS>
+  void bulk_insert(DepositMapping::container_t& data, ITER first, ITER last, bool fold, ACCESS deposit)  {
+    const bool walk = std::size_t(std::distance(first, last)) * 8 >= data.size();
+    auto hint = data.begin();
+    for( ; first != last; ++first )   {
+      CellID cell = (*first)->first;
+      if ( !walk && (hint == data.end() || hint->first < cell) )
+        hint = data.lower_bound(cell);
+      while( hint != data.end() && hint->first < cell )
+        ++hint;
+      if ( fold && hint != data.end() && hint->first == cell )   {
+        hint->second.update_deposit_weighted(deposit(*first));
+        continue;
+      }
+      while( !fold && hint != data.end() && hint->first == cell )
+        ++hint;
+      hint = data.emplace_hint(hint, cell, deposit(*first));
+    }
+  }
+}
+
+/// Order the deposits by cell and combine deposits of identical cells (flat map mode)
+std::size_t DepositVector::combine()   {
+  if ( combined ) return 0;
+  std::size_t folded = 0;
+  auto order = order_by_cell(data.begin(), data.end());
+  container_t sorted;
+  sorted.reserve(data.size());
+  for( auto i : order )   {
+    if ( !sorted.empty() && sorted.back().first == i->first )   {
+      sorted.back().second.update_deposit_weighted(std::move(i->second));
+      ++folded;
+      continue;
+    }
+    sorted.emplace_back(i->first, std::move(i->second));
+  }
+  data = std::move(sorted);
+  combined = true;
+  return folded;
+}
+
 /// Access energy deposit by key
 const EnergyDeposit& DepositVector::get(CellID cell)   const    {
-  for( const auto& c : data )    {
-    if ( c.first == cell )   {
-      return c.second;
+  if ( combined )   {
+    auto iter = std::lower_bound(data.begin(), data.end(), cell,
+                                 [](const value_type& v, CellID c) { return v.first < c; });
+    if ( iter != data.end() && iter->first == cell )
+      return iter->second;
+  }
+  else   {
+    for( const auto& c : data )    {
+      if ( c.first == cell )   {
+        return c.second;
+      }
     }
   }
   except("DepositVector","Failed to access deposit by CellID. UNKNOWN ID: %016X", cell);
@@ -248,48 +325,42 @@ void DepositVector::remove(iterator /* position */)   {
 /// Merge new deposit map onto existing map
 std::size_t DepositMapping::merge(DepositVector&& updates)    {
   std::size_t update_size = updates.size();
-  for( auto& dep : updates )    {
-    EnergyDeposit& depo = dep.second;
-    CellID cell = dep.first;
-    auto   iter = data.find(cell);
-    if ( iter == data.end() )
-      data.emplace(dep.first, std::move(depo));
-    else
-      iter->second.update_deposit_weighted(std::move(depo));
-  }
+  auto order = order_by_cell(updates.begin(), updates.end());
+  bulk_insert(data, order.begin(), order.end(), true,
+              [](DepositVector::iterator i) -> EnergyDeposit&& { return std::move(i->second); });
   return update_size;
 }
 
 /// Merge new deposit map onto existing map
 std::size_t DepositMapping::merge(DepositMapping&& updates)    {
   std::size_t update_size = updates.size();
-  for( auto& dep : updates )    {
-    const EnergyDeposit& depo = dep.second;
-    CellID cell = dep.first;
-    auto   iter = data.find(cell);
-    if ( iter == data.end() )
-      data.emplace(dep.first, std::move(depo));
-    else
-      iter->second.update_deposit_weighted(std::move(depo));
-  }
+  std::vector<iterator> order;
+  order.reserve(update_size);
+  for( auto i = updates.begin(); i != updates.end(); ++i )
+    order.emplace_back(i);
+  bulk_insert(data, order.begin(), order.end(), true,
+              [](iterator i) -> EnergyDeposit&& { return std::move(i->second); });
   return update_size;
 }
 
 /// Merge new deposit map onto existing map (keep inputs)
 std::size_t DepositMapping::insert(const DepositVector& updates)    {
   std::size_t update_size = updates.size();
-  for( const auto& c : updates )    {
-    data.emplace(c);
-  }
+  auto order = order_by_cell(updates.begin(), updates.end());
+  bulk_insert(data, order.begin(), order.end(), false,
+              [](DepositVector::const_iterator i) -> const EnergyDeposit& { return i->second; });
   return update_size;
 }
 
 /// Merge new deposit map onto existing map (keep inputs)
 std::size_t DepositMapping::insert(const DepositMapping& updates)    {
   std::size_t update_size = updates.size();
-  for( const auto& c : updates )    {
-    data.emplace(c);
-  }
+  std::vector<const_iterator> order;
+  order.reserve(update_size);
+  for( auto i = updates.begin(); i != updates.end(); ++i )
+    order.emplace_back(i);
+  bulk_insert(data, order.begin(), order.end(), false,
+              [](const_iterator i) -> const EnergyDeposit& { return i->second; });
   return update_size;
 }
 
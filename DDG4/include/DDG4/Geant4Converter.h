@@ -17,6 +17,13 @@
 #include <DD4hep/Printout.h>
 #include <DDG4/Geant4Mapping.h>
 
+// C/C++ include files
+#include <set>
+#include <vector>
+
+// Forward declarations
+class G4TessellatedSolid;
+
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
@@ -59,7 +66,22 @@ namespace dd4hep {
       bool       checkOverlaps = true;
       /// Property: Output level for debug printing
       PrintLevel outputLevel = INFO;
+      /// Property: Number of threads to close tessellated solids. 0 or 1: serial conversion
+      int        numThreads  = 0;
+
+    protected:
+      /// Flag to defer closing tessellated solids during the solid conversion
+      mutable bool m_deferClose = false;
+      /// Tessellated solids waiting to be closed
+      mutable std::vector<std::pair<const TGeoShape*, G4TessellatedSolid*> > m_openSolids;
+      /// Constituents of boolean and scaled shapes: closed immediately, since
+      /// Geant4 boolean solids cache the extent of their constituents
+      mutable std::set<const TGeoShape*> m_constituents;
 
+      /// Close the deferred tessellated solids (vertex merging, voxelization) in parallel
+      void closeSolids()  const;
+
+    public:
       /// Initializing Constructor
       Geant4Converter(const Detector& description);
 
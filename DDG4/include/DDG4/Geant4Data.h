@@ -287,6 +287,16 @@ namespace dd4hep {
         Hit(const Geant4HitData::Contribution& contrib, const Direction& mom, double deposit);
         /// Default destructor
         virtual ~Hit();
+        /// Geant4 required object allocator: in Geant4 worker threads hits are taken from a per-thread pool
+        void* operator new(std::size_t size);
+        /// Placement new (used e.g. by the ROOT dictionary)
+        void* operator new(std::size_t, void* ptr)  {  return ptr;  }
+        /// Geant4 required object destroyer: pooled hits are returned to the pool they were taken from
+        void operator delete(void* ptr, std::size_t size);
+        /// Placement delete
+        void operator delete(void*, void*)  {  }
+        /// Check if the hit (created with new) is taken from the pool of a Geant4 worker thread
+        static bool isPooled(const Hit* hit);
         /// Move assignment operator
         Hit& operator=(Hit&& c) = delete;
         /// Copy assignment operator
@@ -341,6 +351,16 @@ namespace dd4hep {
         Hit(const Position& cell_pos);
         /// Default destructor
         virtual ~Hit();
+        /// Geant4 required object allocator: in Geant4 worker threads hits are taken from a per-thread pool
+        void* operator new(std::size_t size);
+        /// Placement new (used e.g. by the ROOT dictionary)
+        void* operator new(std::size_t, void* ptr)  {  return ptr;  }
+        /// Geant4 required object destroyer: pooled hits are returned to the pool they were taken from
+        void operator delete(void* ptr, std::size_t size);
+        /// Placement delete
+        void operator delete(void*, void*)  {  }
+        /// Check if the hit (created with new) is taken from the pool of a Geant4 worker thread
+        static bool isPooled(const Hit* hit);
         /// Move assignment operator
         Hit& operator=(Hit&& c) = delete;
         /// Copy assignment operator
@@ -32,24 +32,98 @@ namespace dd4hep {
 
     /// Mediator class to allow Geant4 accessing magnetic fields defined in dd4hep
     /**
+     *  Optionally the field values are cached around the last evaluated point:
+     *
+     *  - If all magnetic components are unbounded constant fields, the field
+     *    value is computed once and returned without further evaluation.
+     *  - Otherwise, if a cache radius is set, the field and its gradient are
+     *    evaluated at a reference point and all queries within the radius
+     *    (maximum norm) are answered by the local linearisation.
+     *    Cells where the field change over the radius is below the tolerance
+     *    return the reference value directly. Cells where the estimated error
+     *    of the linearisation exceeds the tolerance are evaluated exactly.
+     *    The error is estimated from the second differences of the field at
+     *    the cell borders and from the deviation of the previous cell at the
+     *    new reference point.
+     *
+     *  The cache is not protected against concurrent access: in multi-threaded
+     *  mode every worker thread must own its instance as it is done by the
+     *  Geant4FieldTrackingConstruction.
+     *
      *  \author  M.Frank
      *  \version 1.0
      *  \ingroup DD4HEP_SIMULATION
      */
     class Geant4Field : public G4MagneticField {
+    public:
+      /// Cache configuration. All values in Geant4 units
+      struct CacheSetup  {
+        /// Validity radius of a cache cell. Caching is disabled if <= 0
+        double radius     { -1e0 };
+        /// Maximal tolerated absolute deviation of the cached field value. Checks are disabled if <= 0
+        double tolerance  { -1e0 };
+      };
+      /// Cache usage counters
+      struct CacheStatistics  {
+        /// Queries answered from the cache
+        unsigned long hits   { 0 };
+        /// Cache hits answered by the linearisation of the cell
+        unsigned long linear { 0 };
+        /// Cache cells computed
+        unsigned long cells  { 0 };
+        /// Queries evaluated exactly inside cells where the linearisation is insufficient
+        unsigned long exact  { 0 };
+      };
+
     protected:
+      /// Local state of the field cache in Geant4 units
+      struct Cache  {
+        enum Mode { INVALID = 0, CONSTANT = 1, LINEAR = 2, EXACT = 3 };
+        /// Reference point of the cell
+        double pos[3]       { 0e0, 0e0, 0e0 };
+        /// Field value at the reference point
+        double field[3]     { 0e0, 0e0, 0e0 };
+        /// Field gradient: grad[i][j] = dB_i/dx_j
+        double grad[3][3]   { };
+        /// Cell mode
+        int    mode         { INVALID };
+      };
+
       /// Reference to the detector description field
-      OverlayedField m_field;
+      OverlayedField          m_field;
+      /// Cache configuration
+      CacheSetup              m_setup;
+      /// Cache state of the current cell
+      mutable Cache           m_cache;
+      /// Cache usage counters
+      mutable CacheStatistics m_stat;
+      /// Field value if the field is constant everywhere
+      double                  m_constant[3] { 0e0, 0e0, 0e0 };
+      /// Flag set if the field is constant everywhere
+      bool                    m_isConstant  { false };
+
+      /// Evaluate the detector description field. Position and field in Geant4 units
+      void evaluate(const double pos[3], double* field)  const;
+      /// Compute a new cache cell around the given position and return the field value
+      void refresh(const double pos[3], double* field)  const;
 
     public:
       /// Constructor. The sensitive detector element is identified by the detector name
       Geant4Field(OverlayedField field) : m_field(field) {   }
+      /// Constructor with field cache
+      Geant4Field(OverlayedField field, const CacheSetup& setup);
       /// Standard destructor
       virtual ~Geant4Field() {    }
       /// Access field values at a given point
       virtual void GetFieldValue(const double pos[4], double *arr) const  override;
       /// Does field change energy ?
       virtual G4bool DoesFieldChangeEnergy() const  override;
+      /// Access the cache configuration
+      const CacheSetup& cacheSetup()  const      {  return m_setup;      }
+      /// Access the cache usage counters
+      const CacheStatistics& cacheStatistics()  const  {  return m_stat;  }
+      /// Check if the field was detected to be constant everywhere
+      bool isConstant()  const                   {  return m_isConstant; }
     };
 
   }    // End namespace sim
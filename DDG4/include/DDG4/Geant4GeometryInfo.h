@@ -104,6 +104,47 @@ namespace dd4hep {
         int      flags;
       };
 
+      /// Open-addressing hash table of the sensitive placement paths
+      /**
+       *  Read-only copy of g4Paths built once after the population of the
+       *  volume manager. The keys are the 64 bit hashes of the placement paths,
+       *  which are already well mixed: linear probing on the lower bits.
+       *
+       *  \author  agent
+       *  \version 1.0
+       *  \ingroup DD4HEP_SIMULATION
+       */
+      class PathTable  {
+      public:
+        struct Entry  {
+          uint64_t  key;
+          Placement placement;
+        };
+        /// Table slots. Empty slots have key == 0
+        std::vector<Entry> slots;
+        /// Index mask (table size is a power of 2)
+        uint64_t           mask     { 0 };
+        /// Placement of the (improbable) path with hash 0
+        Placement          zero     { 0, 0 };
+        /// Flag if the zero hash is present
+        bool               has_zero { false };
+      public:
+        /// Build the table from the path map
+        void build(const std::map<uint64_t, Placement>& paths);
+        /// Check if the table was built
+        bool empty()  const  {  return slots.empty() && !has_zero;  }
+        /// Lookup a path hash. Returns null if not present
+        const Placement* find(uint64_t key)  const  {
+          if ( key == 0 ) return has_zero ? &zero : nullptr;
+          if ( slots.empty() ) return nullptr;
+          for( uint64_t i = key & mask; ; i = (i + 1) & mask )  {
+            const Entry& e = slots[i];
+            if ( e.key == key ) return &e.placement;
+            if ( e.key == 0   ) return nullptr;
+          }
+        }
+      };
+
       class DebugInfo;
       TGeoManager*                         manager     { nullptr };
       DebugInfo*                           g4DebugInfo { nullptr };
@@ -132,6 +173,7 @@ namespace dd4hep {
       std::map<VisAttr,          G4VisAttributes*>             g4Vis;
       std::map<LimitSet,         G4UserLimits*>                g4Limits;
       std::map<uint64_t,         Placement>                    g4Paths;
+      PathTable                                                g4PathTable;
       std::map<SensitiveDetector,std::set<const TGeoVolume*> > sensitives;
       std::map<Region,           std::set<const TGeoVolume*> > regions;
       std::map<LimitSet,         std::set<const TGeoVolume*> > limits;
@@ -23,6 +23,8 @@
 #include <vector>
 #include <string>
 #include <climits>
+#include <functional>
+#include <unordered_map>
 #include <typeinfo>
 #include <stdexcept>
 
@@ -208,6 +210,26 @@ namespace dd4hep {
       /// Hit key map for fast random lookup
       typedef std::map<VolumeID, size_t>  Keys;
 
+      /// Key of the position map: the exact hit position
+      struct PositionKey  {
+        double x, y, z;
+        bool operator==(const PositionKey& k) const  {
+          return x == k.x && y == k.y && z == k.z;
+        }
+      };
+      /// Hash function of the position key. Equal positions (also +0 and -0) have equal hash values
+      struct PositionHash  {
+        size_t operator()(const PositionKey& k) const  {
+          std::hash<double> h;
+          size_t seed = h(k.x);
+          seed ^= h(k.y) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+          seed ^= h(k.z) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+          return seed;
+        }
+      };
+      /// Hit position map for fast random lookup of position-keyed hits
+      typedef std::unordered_map<PositionKey, size_t, PositionHash> Positions;
+
       /// Generic class template to compare/select hits in Geant4HitCollection objects
       /**
        *
@@ -247,6 +269,8 @@ namespace dd4hep {
       size_t                           m_lastHit;
       /// Hit key map for fast random lookup
       Keys                             m_keys;
+      /// Hit position map for fast random lookup
+      Positions                        m_positions;
       /// Optimization flags
       CollectionFlags                  m_flags;
       
@@ -346,6 +370,17 @@ namespace dd4hep {
         }
         throw std::runtime_error("Attempt to insert hit with same key to G4 hit-collection "+GetName());
       }
+      /// Add a new hit, which may be looked up by its position using findByPosition
+      template <typename TYPE, typename POS> void addByPosition(const POS& pos, TYPE* hit_pointer) {
+        m_lastHit = m_hits.size();
+        std::pair<Positions::iterator,bool> ret = m_positions.emplace(PositionKey{pos.X(),pos.Y(),pos.Z()},m_lastHit);
+        if ( ret.second )  {
+          Geant4HitWrapper w(m_manipulator->castHit(hit_pointer));
+          m_hits.emplace_back(w);
+          return;
+        }
+        throw std::runtime_error("Attempt to insert hit with same position to G4 hit-collection "+GetName());
+      }
       /// Find hits in a collection by comparison of attributes
       template <typename TYPE> TYPE* find(const Compare& cmp) {
         return (TYPE*) findHit(cmp);
@@ -358,6 +393,14 @@ namespace dd4hep {
         TYPE* obj = m_hits.at(m_lastHit);
         return obj;
       }
+      /// Find hits added with addByPosition by their position. Same result as PositionCompare in O(1)
+      template <typename TYPE, typename POS> TYPE* findByPosition(const POS& pos) {
+        Positions::const_iterator i=m_positions.find(PositionKey{pos.X(),pos.Y(),pos.Z()});
+        if ( i == m_positions.end() ) return 0;
+        m_lastHit = (*i).second;
+        TYPE* obj = m_hits.at(m_lastHit);
+        return obj;
+      }
       /// Release all hits from the Geant4 container and pass ownership to the caller
       template <typename TYPE> std::vector<TYPE*> releaseHits() {
         std::vector<TYPE*> vec;
@@ -366,6 +409,7 @@ namespace dd4hep {
         }
         m_lastHit = ULONG_MAX;
         m_keys.clear();
+        m_positions.clear();
         return vec;
       }
       /// Release all hits from the Geant4 container and pass ownership to the caller
@@ -17,12 +17,18 @@
 #include <DDG4/Geant4OutputAction.h>
 
 #include <atomic>
+#include <condition_variable>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 class TFile;
 class TTree;
 class TBranch;
+class TMemFile;
+class TFileMerger;
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -32,8 +38,123 @@ namespace dd4hep {
   /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
   namespace sim {
 
+    /// Event buffer of the buffered ROOT output
+    /**
+     *  The event data of one worker are filled into the trees of a private
+     *  in-memory file. Streaming and compression hence run concurrently in the
+     *  worker threads. The serialized file is then handed to the writer.
+     *
+     *  \author  agent
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4Output2ROOTBuffer  {
+    public:
+      using Buffer = std::vector<char>;
+    protected:
+      /// In-memory file holding the event trees
+      std::unique_ptr<TMemFile>          m_file;
+      /// Trees in the memory file (owned by m_file)
+      std::map<std::string, TTree*>      m_sections;
+      /// Branches in the event tree
+      std::map<std::string, TBranch*>    m_branches;
+      /// Reference to the event data tree (owned by m_file)
+      TTree* m_tree = nullptr;
+      /// Flag set once the event is committed
+      bool   m_committed = false;
+
+    public:
+      /// Initializing constructor
+      Geant4Output2ROOTBuffer(const std::string& name, const std::string& section);
+      /// Default destructor
+      ~Geant4Output2ROOTBuffer();
+      /// Check if the event was committed
+      bool committed()  const   {  return m_committed;  }
+      /// Create/access tree by name for non collection user data
+      TTree* section(const std::string& nam);
+      /// Fill single EVENT branch entry (Geant4 collection data)
+      int fill(const std::string& nam, const ComponentCast& type, void* ptr);
+      /// Commit data at end of filling procedure
+      void commit(int event_id);
+      /// Write the trees and return the content of the memory file. Closes the buffer.
+      Buffer serialize();
+    };
+
+    /// Background writer of the buffered ROOT output
+    /**
+     *  The serialized events of all workers are queued and merged by a single
+     *  thread into the output file. Events are written in the order of their
+     *  event ID: an event is held back until its predecessor arrived or until
+     *  more than 'window' events are pending. At close all events are written.
+     *
+     *  \author  agent
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4Output2ROOTWriter  {
+    public:
+      using Buffer = Geant4Output2ROOTBuffer::Buffer;
+    protected:
+      /// Name of the output file
+      std::string                       m_name;
+      /// Merger writing the output file
+      std::unique_ptr<TFileMerger>      m_merger;
+      /// Writer thread
+      std::thread                       m_thread;
+      /// Lock protecting the queue
+      std::mutex                        m_lock;
+      /// Condition to wake up the writer thread
+      std::condition_variable           m_cond;
+      /// Serialized events not yet seen by the writer thread
+      std::vector<std::pair<int,Buffer> > m_queue;
+      /// Events waiting for their predecessors (writer thread only)
+      std::map<int,Buffer>              m_pending;
+      /// Flag to close the writer once the queue is drained
+      std::once_flag                    m_closed;
+      /// Maximal number of events held back to restore the event order
+      std::size_t                       m_window;
+      /// Number of clients which did not yet release the writer
+      std::atomic<int>                  m_clients;
+      /// Next event ID to be written
+      int                               m_next   = 0;
+      /// Number of events written
+      long                              m_events = 0;
+      /// Flag to stop the writer thread
+      bool                              m_stop   = false;
+
+      /// Writer thread: merge queued events to the output file
+      void run();
+      /// Merge pending events to the output file
+      void merge(bool all);
+
+    public:
+      /// Initializing constructor: opens the output file and starts the writer thread
+      Geant4Output2ROOTWriter(const std::string& fname, int clients, std::size_t window);
+      /// Default destructor: flushes all events and closes the output file
+      ~Geant4Output2ROOTWriter();
+      /// Access the name of the output file
+      const std::string& name()  const   {  return m_name;    }
+      /// Number of events written
+      long numEvents()  const            {  return m_events;  }
+      /// Queue a serialized event. An empty buffer marks an event without output
+      void push(int event_id, Buffer&& buffer);
+      /// Release one client. The last client closes the output file
+      void release();
+      /// Check if the output file is closed and events are no longer accepted
+      bool closed();
+      /// Write all pending events and close the output file
+      void close();
+    };
+
     /// Class to output Geant4 event data to ROOT files
     /**
+     *  In multi-threaded mode the default is a single action instance shared
+     *  by all workers, where the access to the output file is serialized.
+     *  With the property 'Buffered' every worker owns an action instance
+     *  (create the action with shared=False), which serializes the event into
+     *  a Geant4Output2ROOTBuffer. A Geant4Output2ROOTWriter common to all
+     *  instances with the same output file writes the events in the background.
+     *
      *  \author  M.Frank
      *  \version 1.0
      *  \ingroup DD4HEP_SIMULATION
@@ -60,6 +181,12 @@ namespace dd4hep {
       bool m_handleMCTruth = true;
       /// Property: Flag to create a new output file for each run
       bool m_filesByRun = false;
+      /// Property: Flag to serialize events in the worker threads and write them in the background
+      bool m_buffered = false;
+      /// Property: Maximal number of events held back to restore the event order (0: 4 per thread)
+      int  m_reorderWindow = 0;
+      /// Writer of the buffered output
+      std::shared_ptr<Geant4Output2ROOTWriter> m_writer;
       /// Counter of worker endRun calls so that closeOutput fires only after all workers are done
       std::atomic<int> m_endRunCount { 0 };
       /// Static mutex to protect ROOT I/O operations in multi-threaded mode
@@ -84,6 +211,8 @@ namespace dd4hep {
       void beginRun(const G4Run* run)  override;
       /// Callback at end of run: write and close the output file while DDG4 is still alive
       void endRun(const G4Run* run)  override;
+      /// Geant4EventAction interface: End-of-event callback
+      void end(const G4Event* event)  override;
       /// Callback to store each Geant4 hit collection
       void saveCollection(OutputContext<G4Event>& ctxt, G4VHitsCollection* collection)  override;
       /// Callback to store the Geant4 event
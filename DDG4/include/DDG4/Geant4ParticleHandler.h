@@ -29,6 +29,12 @@
 #include <DDG4/Geant4GeneratorAction.h>
 #include <DDG4/Geant4MonteCarloTruth.h>
 
+// C/C++ include files
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
 // Forward declarations
 class G4Step;
 class G4Track;
@@ -88,6 +94,84 @@ namespace dd4hep {
     public:
       typedef std::vector<std::string> Processes;
 
+      /// Dense map with small non-negative keys like Geant4 track or particle identifiers
+      /**
+       *  Replaces std::map for the event dependent particle record: lookup,
+       *  insertion and removal are O(1). Like for std::map the entries are
+       *  iterated in ascending order of the keys. Values equal to EMPTY are absent.
+       *
+       *  \author  agent
+       *  \version 1.0
+       *  \ingroup DD4HEP_SIMULATION
+       */
+      template <typename T, T EMPTY> class DenseMap  {
+      public:
+        typedef std::pair<int,T> value_type;
+        /// Iterator over the entries present in the map in ascending order of the keys
+        class const_iterator  {
+          const std::vector<T>* m_data;
+          std::size_t           m_index;
+          void skip()  {
+            while( m_index < m_data->size() && (*m_data)[m_index] == EMPTY ) ++m_index;
+          }
+        public:
+          const_iterator(const std::vector<T>* d, std::size_t i) : m_data(d), m_index(i)  { skip(); }
+          value_type operator*() const        {  return value_type(int(m_index), (*m_data)[m_index]);  }
+          const_iterator& operator++()        {  ++m_index; skip(); return *this;                      }
+          bool operator==(const const_iterator& c) const  {  return m_index == c.m_index;              }
+          bool operator!=(const const_iterator& c) const  {  return m_index != c.m_index;              }
+        };
+      private:
+        std::vector<T> m_data;
+        std::size_t    m_size { 0 };
+      public:
+        const_iterator begin() const     {  return const_iterator(&m_data, 0);              }
+        const_iterator end()   const     {  return const_iterator(&m_data, m_data.size());  }
+        /// Number of entries
+        std::size_t size()     const     {  return m_size;                                  }
+        bool empty()           const     {  return m_size == 0;                             }
+        /// Upper bound of the keys in the map
+        int limit()            const     {  return int(m_data.size());                      }
+        /// Access an entry. Returns EMPTY if the key is not present
+        T get(int key)  const  {
+          return key >= 0 && std::size_t(key) < m_data.size() ? m_data[key] : EMPTY;
+        }
+        /// Check if the key is present
+        bool contains(int key) const     {  return get(key) != EMPTY;                       }
+        /// Insert or overwrite an entry
+        void set(int key, T value)  {
+          if ( key < 0 ) throw std::out_of_range("DenseMap: Invalid negative key");
+          if ( std::size_t(key) >= m_data.size() )
+            m_data.resize(std::max(std::size_t(key)+1, 2*m_data.size()), EMPTY);
+          T& entry = m_data[key];
+          if ( entry == EMPTY && value != EMPTY ) ++m_size;
+          else if ( entry != EMPTY && value == EMPTY ) --m_size;
+          entry = value;
+        }
+        /// Remove an entry. Returns the removed value
+        T erase(int key)  {
+          T value = get(key);
+          if ( value != EMPTY )  {
+            m_data[key] = EMPTY;
+            --m_size;
+          }
+          return value;
+        }
+        /// Remove all entries
+        void clear()  {
+          m_data.clear();
+          m_size = 0;
+        }
+        /// Copy the entries to a std::map. The entries are sorted: linear complexity
+        template <typename MAP> void copyTo(MAP& m)  const  {
+          for( const auto& e : *this ) m.emplace_hint(m.end(), e.first, e.second);
+        }
+      };
+      /// Particle store indexed by the Geant4 track identifier (after rebasing: by the particle identifier)
+      typedef DenseMap<Particle*, nullptr> ParticleStore;
+      /// Store associating track identifiers with identifiers of existing MCParticles
+      typedef DenseMap<int, -1>            EquivalentStore;
+
     protected:
 
       /** Property variables used to configure the object */
@@ -117,13 +201,13 @@ namespace dd4hep {
       Geant4PrimaryMap* m_primaryMap            { nullptr };
       /// Local buffer about the 'current' G4Track
       Particle          m_currTrack;
-      /// Map with stored MC Particles
-      ParticleMap       m_particleMap;
+      /// Store with MC Particles
+      ParticleStore     m_particleMap;
       /// Map with stored MC Particles that were suspended by the stepping action
       ParticleMap       m_suspendedPM;
       bool              m_haveSuspended = false;
-      /// Map associating the G4Track identifiers with identifiers of existing MCParticles
-      TrackEquivalents  m_equivalentTracks;
+      /// Store associating the G4Track identifiers with identifiers of existing MCParticles
+      EquivalentStore   m_equivalentTracks;
 
       /// Recombine particles and associate the to parents with cleanup
       int recombineParents();
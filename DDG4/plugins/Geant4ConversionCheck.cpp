@@ -0,0 +1,120 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : agent
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/Detector.h>
+#include <DD4hep/Factories.h>
+#include <DD4hep/Printout.h>
+#include <DDG4/Geant4Converter.h>
+#include <DDG4/Geant4HierarchyDump.h>
+
+// Geant4 include files
+#include <G4VSolid.hh>
+
+// C/C++ include files
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+using namespace dd4hep;
+using namespace dd4hep::sim;
+
+namespace  {
+
+  /// Printer callback collecting the printout lines in a string
+  std::size_t collect_printout(void* arg, PrintLevel, const char* src, const char* fmt, va_list& args)  {
+    char text[4096];
+    va_list copy;
+    va_copy(copy, args);
+    ::vsnprintf(text, sizeof(text), fmt, copy);
+    va_end(copy);
+    std::string* output = (std::string*)arg;
+    *output += std::string(src) + " " + text + "\n";
+    return 1;
+  }
+
+  /// Convert the geometry and record the hierarchy dump and all converted solids
+  std::string convert(Detector& description, int nthreads, double& seconds)  {
+    std::string record;
+    Geant4Converter conv(description, WARNING);
+    conv.numThreads = nthreads;
+    auto start = std::chrono::high_resolution_clock::now();
+    std::unique_ptr<Geant4GeometryInfo> geo(conv.create(description.world()).detach());
+    seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+    PrintLevel level = setPrintLevel(INFO);
+    setPrinter2(&record, collect_printout);
+    Geant4HierarchyDump(description).dump("", geo->world());
+    setPrinter2(nullptr, nullptr);
+    setPrintLevel(level);
+
+    /// The hierarchy dump does not show the solids: add them in the order of the TGeo shapes
+    std::stringstream str;
+    for( const auto& [shape, solid] : geo->g4Solids )  {
+      G4ThreeVector pmin, pmax;
+      if ( !solid ) continue;
+      solid->BoundingLimits(pmin, pmax);
+      str << shape->GetName() << " " << solid->GetEntityType() << " " << solid->GetName()
+          << " limits: " << pmin << " " << pmax << "\n";
+      solid->StreamInfo(str);
+    }
+    return record + str.str();
+  }
+}
+
+/// Check that the parallel conversion to Geant4 gives the same geometry as the serial conversion
+/**
+ *  Factory: Geant4ConversionCheck
+ *
+ *  Usage: geoPluginRun -input <compact.xml> -plugin Geant4ConversionCheck [-threads <n>]
+ *
+ *  The geometry is converted twice: serially and with 'threads' threads.
+ *  The outputs of Geant4HierarchyDump and the description of all converted
+ *  solids must be identical.
+ *
+ *  \author  agent
+ *  \version 1.0
+ */
+static long conversion_check(Detector& description, int argc, char** argv)  {
+  int nthreads = 4;
+  for(int i = 0; i < argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-threads",argv[i],4) && i+1 < argc )
+      nthreads = std::stoi(argv[++i]);
+    else  {
+      std::cout <<
+        "Usage: -plugin Geant4ConversionCheck  -arg [-arg]                              \n\n"
+        "     Compare the serial and the parallel conversion of the geometry to Geant4. \n\n"
+        "     -threads <number>      Number of conversion threads. Default: 4           \n"
+        "     Arguments given: " << arguments(argc,argv) << std::endl << std::flush;
+      ::exit(EINVAL);
+    }
+  }
+  double serial_time = 0e0, parallel_time = 0e0;
+  std::string serial   = convert(description, 0, serial_time);
+  std::string parallel = convert(description, nthreads, parallel_time);
+  printout(ALWAYS, "Geant4ConversionCheck", "+++ Serial conversion:   %8.3f seconds.", serial_time);
+  printout(ALWAYS, "Geant4ConversionCheck", "+++ Parallel conversion: %8.3f seconds with %d threads.",
+           parallel_time, nthreads);
+  if ( serial != parallel )  {
+    except("Geant4ConversionCheck", "+++ The parallel conversion differs from the serial conversion!");
+  }
+  printout(ALWAYS, "Geant4ConversionCheck", "+++ Serial and parallel conversion are identical [%ld bytes].",
+           serial.length());
+  return 1;
+}
+DECLARE_APPLY(Geant4ConversionCheck,conversion_check)
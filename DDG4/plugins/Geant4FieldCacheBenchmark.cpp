@@ -0,0 +1,169 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : agent
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/Detector.h>
+#include <DD4hep/Factories.h>
+#include <DD4hep/Printout.h>
+#include <DD4hep/DD4hepUnits.h>
+#include <DDG4/Geant4Field.h>
+
+// Geant4 include files
+#include <CLHEP/Units/SystemOfUnits.h>
+
+// C/C++ include files
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <cerrno>
+#include <random>
+#include <iostream>
+
+using namespace dd4hep;
+
+/// Benchmark of the Geant4Field cache: speed and accuracy compared to the exact evaluation
+/**
+ *  Factory: Geant4FieldCacheBenchmark
+ *
+ *  Usage: geoPluginRun -input <compact.xml> -plugin Geant4FieldCacheBenchmark
+ *                      [-tracks <n>] [-steps <n>] [-step <length>] [-range <x> <y> <z>]
+ *                      [-radius <length>] [-tolerance <field>] [-linear]
+ *
+ *  Straight tracks start at random points in the box [-range,range]. Along each
+ *  track the field is queried in the pattern of a 4th order Runge-Kutta stepper.
+ *  The same queries are executed with the exact and with the cached field.
+ *  The evaluation rates and the maximal/mean deviation of the cached values are printed.
+ *  The check fails if the maximal deviation exceeds the tolerance. With -linear
+ *  it also fails if no query was answered by the linearisation of a cache cell,
+ *  i.e. if the field did not exercise the gradient of the cache.
+ *
+ *  \author  agent
+ *  \version 1.0
+ */
+static long field_cache_benchmark(Detector& description, int argc, char** argv)  {
+  std::size_t num_tracks = 1000, num_steps = 1000;
+  bool        linear     = false;
+  double      step       = 1e0*dd4hep::mm;
+  double      range[3]   = { 1e0*dd4hep::m, 1e0*dd4hep::m, 1e0*dd4hep::m };
+  sim::Geant4Field::CacheSetup setup;
+  setup.radius    = 1e0*CLHEP::cm;
+  setup.tolerance = 1e-4*CLHEP::tesla;
+  for(int i = 0; i < argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-tracks",argv[i],4) && i+1 < argc )
+      num_tracks = std::stoul(argv[++i]);
+    else if ( 0 == ::strncmp("-steps",argv[i],6) && i+1 < argc )
+      num_steps = std::stoul(argv[++i]);
+    else if ( 0 == ::strcmp("-step",argv[i]) && i+1 < argc )
+      step = _toDouble(argv[++i]);
+    else if ( 0 == ::strncmp("-range",argv[i],4) && i+3 < argc )  {
+      for( int j = 0; j < 3; ++j ) range[j] = _toDouble(argv[++i]);
+    }
+    else if ( 0 == ::strncmp("-radius",argv[i],4) && i+1 < argc )
+      setup.radius = _toDouble(argv[++i]) / dd4hep::mm * CLHEP::mm;
+    else if ( 0 == ::strncmp("-tolerance",argv[i],4) && i+1 < argc )
+      setup.tolerance = _toDouble(argv[++i]) / dd4hep::tesla * CLHEP::tesla;
+    else if ( 0 == ::strncmp("-linear",argv[i],4) )
+      linear = true;
+    else  {
+      std::cout <<
+        "Usage: -plugin Geant4FieldCacheBenchmark  -arg [-arg]                           \n\n"
+        "     Compare the cached Geant4 field with the exact field evaluation.          \n\n"
+        "     -tracks    <number>      Number of random tracks. Default: 1000            \n"
+        "     -steps     <number>      Number of steps per track. Default: 1000          \n"
+        "     -step      <length>      Step length. Default: 1*mm                        \n"
+        "     -range     <x> <y> <z>   Half-length of the box containing the tracks.     \n"
+        "     -radius    <length>      Validity radius of cache cells. Default: 1*cm     \n"
+        "     -tolerance <field>       Tolerated field deviation. Default: 1e-4*tesla    \n"
+        "     -linear                  Require cache hits from linearised cells.         \n"
+        "     Arguments given: " << arguments(argc,argv) << std::endl << std::flush;
+      ::exit(EINVAL);
+    }
+  }
+  OverlayedField field = description.field();
+  if ( !field.isValid() )  {
+    except("Geant4FieldCacheBenchmark","+++ The detector description has no field.");
+  }
+
+  // Positions in Geant4 units, 4 queries per step like the classical Runge-Kutta stepper
+  std::mt19937_64 gen(12345);
+  std::uniform_real_distribution<double> flat(-1e0, 1e0);
+  std::vector<double> points;
+  const double h = step / dd4hep::mm * CLHEP::mm;
+  points.reserve(4*4*num_tracks*num_steps);
+  for( std::size_t t = 0; t < num_tracks; ++t )  {
+    double pos[3], dir[3], len = 0e0;
+    for( int j = 0; j < 3; ++j )  {
+      pos[j] = range[j] * flat(gen) / dd4hep::mm * CLHEP::mm;
+      dir[j] = flat(gen);
+      len   += dir[j]*dir[j];
+    }
+    len = std::sqrt(len);
+    for( std::size_t s = 0; s < num_steps; ++s )  {
+      for( double frac : { 0e0, 0.5e0, 0.5e0, 1e0 } )  {
+        points.emplace_back(pos[0] + frac*h*dir[0]/len);
+        points.emplace_back(pos[1] + frac*h*dir[1]/len);
+        points.emplace_back(pos[2] + frac*h*dir[2]/len);
+        points.emplace_back(0e0);
+      }
+      for( int j = 0; j < 3; ++j ) pos[j] += h*dir[j]/len;
+    }
+  }
+
+  const std::size_t num_points = points.size()/4;
+  std::vector<double> exact(3*num_points), cached(3*num_points);
+  auto bench = [&](const sim::Geant4Field& fld, std::vector<double>& values)  {
+    auto start = std::chrono::high_resolution_clock::now();
+    for( std::size_t i = 0; i < num_points; ++i )
+      fld.GetFieldValue(&points[4*i], &values[3*i]);
+    std::chrono::duration<double> secs = std::chrono::high_resolution_clock::now() - start;
+    return double(num_points)/secs.count();
+  };
+  sim::Geant4Field exact_field(field);
+  sim::Geant4Field cached_field(field, setup);
+  double exact_rate  = bench(exact_field,  exact);
+  double cached_rate = bench(cached_field, cached);
+  double max_dev = 0e0, sum_dev = 0e0;
+  for( std::size_t i = 0; i < num_points; ++i )  {
+    double dev = 0e0;
+    for( int j = 0; j < 3; ++j )
+      dev = std::max(dev, std::abs(cached[3*i+j] - exact[3*i+j]));
+    max_dev  = std::max(max_dev, dev);
+    sum_dev += dev;
+  }
+  const auto& stat = cached_field.cacheStatistics();
+  printout(ALWAYS,"Geant4FieldCacheBenchmark","+++ %ld tracks, %ld steps of %g mm: %ld field queries.",
+           num_tracks, num_steps, h/CLHEP::mm, num_points);
+  printout(ALWAYS,"Geant4FieldCacheBenchmark","+++ Cache radius: %g mm tolerance: %g tesla %s",
+           setup.radius/CLHEP::mm, setup.tolerance/CLHEP::tesla,
+           cached_field.isConstant() ? "[field is constant]" : "");
+  printout(ALWAYS,"Geant4FieldCacheBenchmark","+++ Exact  field: %12.0f evaluations/sec", exact_rate);
+  printout(ALWAYS,"Geant4FieldCacheBenchmark","+++ Cached field: %12.0f evaluations/sec  speedup: %.2f",
+           cached_rate, cached_rate/exact_rate);
+  printout(ALWAYS,"Geant4FieldCacheBenchmark","+++ Cache: %ld hits (%ld linearised) %ld cells %ld exact evaluations",
+           stat.hits, stat.linear, stat.cells, stat.exact);
+  printout(ALWAYS,"Geant4FieldCacheBenchmark","+++ Deviation: max %g tesla mean %g tesla",
+           max_dev/CLHEP::tesla, sum_dev/double(num_points)/CLHEP::tesla);
+  if ( !(max_dev <= setup.tolerance) )  {
+    printout(ALWAYS,"Geant4FieldCacheBenchmark","+++ Deviation check FAILED: max %g tesla > tolerance %g tesla",
+             max_dev/CLHEP::tesla, setup.tolerance/CLHEP::tesla);
+    return 0;
+  }
+  if ( linear && 0 == stat.linear )  {
+    printout(ALWAYS,"Geant4FieldCacheBenchmark","+++ Linearisation check FAILED: no cache cell used the field gradient");
+    return 0;
+  }
+  printout(ALWAYS,"Geant4FieldCacheBenchmark","+++ Deviation check PASSED: max %g tesla <= tolerance %g tesla",
+           max_dev/CLHEP::tesla, setup.tolerance/CLHEP::tesla);
+  return 1;
+}
+DECLARE_APPLY(Geant4FieldCacheBenchmark,field_cache_benchmark)
@@ -58,6 +58,10 @@ namespace dd4hep {
       double      eps_max;
       /// G4PropagatorInField parameter: LargestAcceptableStep
       double      largest_step;
+      /// Geant4Field parameter: validity radius of field cache cells (disabled if negative)
+      double      field_cache_radius;
+      /// Geant4Field parameter: tolerated absolute deviation of cached field values
+      double      field_cache_tolerance;
 
     public:
       /// Default constructor
@@ -180,6 +184,8 @@ Geant4FieldTrackingSetup::Geant4FieldTrackingSetup() : eq_typ(), stepper_typ() {
   delta_one_step     = -1.0;
   delta_intersection = -1.0;
   largest_step       = -1.0;
+  field_cache_radius    = -1.0;
+  field_cache_tolerance =  1.0e-4*CLHEP::tesla;
 }
 
 /// Default destructor
@@ -193,7 +199,16 @@ int Geant4FieldTrackingSetup::execute(Detector& description)   {
   G4TransportationManager* transportMgr;
   G4PropagatorInField*     propagator;
   G4FieldManager*          fieldManager;
-  G4MagneticField*         mag_field    = new sim::Geant4Field(fld);
+  G4MagneticField*         mag_field    = nullptr;
+  if ( field_cache_radius > 0e0 )  {
+    sim::Geant4Field::CacheSetup cache;
+    cache.radius    = field_cache_radius;
+    cache.tolerance = field_cache_tolerance;
+    mag_field = new sim::Geant4Field(fld, cache);
+  }
+  else  {
+    mag_field = new sim::Geant4Field(fld);
+  }
   G4Mag_EqRhs*             mag_equation = PluginService::Create<G4Mag_EqRhs*>(eq_typ,mag_field);
   G4EquationOfMotion*      mag_eq       = mag_equation;
   if ( nullptr == mag_eq )   {
@@ -253,6 +268,8 @@ static long setup_fields(dd4hep::Detector& description,
       if ( pm["delta_one_step"] ) delta_one_step = pm.toDouble("delta_one_step");
       if ( pm["delta_intersection"] ) delta_intersection = pm.toDouble("delta_intersection");
       if ( pm["largest_step"] ) largest_step = pm.toDouble("largest_step");
+      if ( pm["field_cache_radius"] ) field_cache_radius = pm.toDouble("field_cache_radius");
+      if ( pm["field_cache_tolerance"] ) field_cache_tolerance = pm.toDouble("field_cache_tolerance");
     }
     virtual ~XMLFieldTrackingSetup() {}
   } setup(vals);
@@ -272,6 +289,8 @@ Geant4FieldTrackingSetupAction::Geant4FieldTrackingSetupAction(Geant4Context* ct
   declareProperty("eps_min",            eps_min = -1.0);
   declareProperty("eps_max",            eps_max = -1.0);
   declareProperty("largest_step",       largest_step = -1.0);
+  declareProperty("field_cache_radius",    field_cache_radius = -1.0);
+  declareProperty("field_cache_tolerance", field_cache_tolerance = 1.0e-4*CLHEP::tesla);
 }
 
 /// Post-track action callback
@@ -283,6 +302,8 @@ void Geant4FieldTrackingSetupAction::operator()()   {
   printout( INFO, "FieldSetup", "Epsilon:[min:%f max:%f]", eps_min, eps_max);
   printout( INFO, "FieldSetup", "Delta:[chord:%f 1-step:%f intersect:%f] LargestStep %f mm",
             delta_chord, delta_one_step, delta_intersection, largest_step);
+  printout( INFO, "FieldSetup", "Field cache:[radius:%f mm tolerance:%g tesla]",
+            field_cache_radius, field_cache_tolerance/CLHEP::tesla);
 }
 
 
@@ -299,6 +320,8 @@ Geant4FieldTrackingConstruction::Geant4FieldTrackingConstruction(Geant4Context*
   declareProperty("eps_min",            eps_min = -1.0);
   declareProperty("eps_max",            eps_max = -1.0);
   declareProperty("largest_step",       largest_step = -1.0);
+  declareProperty("field_cache_radius",    field_cache_radius = -1.0);
+  declareProperty("field_cache_tolerance", field_cache_tolerance = 1.0e-4*CLHEP::tesla);
 }
 
 /// Detector construction callback
@@ -310,6 +333,8 @@ void Geant4FieldTrackingConstruction::constructField(Geant4DetectorConstructionC
   printout( INFO, "FieldSetup", "Epsilon:[min:%f max:%f]", eps_min, eps_max);
   printout( INFO, "FieldSetup", "Delta:[chord:%f 1-step:%f intersect:%f] LargestStep %f mm",
             delta_chord, delta_one_step, delta_intersection, largest_step);
+  printout( INFO, "FieldSetup", "Field cache:[radius:%f mm tolerance:%g tesla]",
+            field_cache_radius, field_cache_tolerance/CLHEP::tesla);
 }
 
 DECLARE_GEANT4_SETUP(Geant4FieldSetup,setup_fields)
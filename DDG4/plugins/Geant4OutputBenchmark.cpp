@@ -0,0 +1,201 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : agent
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/Detector.h>
+#include <DD4hep/Factories.h>
+#include <DD4hep/Printout.h>
+#include <DDG4/Geant4Data.h>
+#include <DDG4/Geant4HitCollection.h>
+#include <DDG4/Geant4Output2ROOT.h>
+
+// ROOT include files
+#include <TROOT.h>
+#include <TFile.h>
+#include <TTree.h>
+#include <TBranch.h>
+#include <TSystem.h>
+
+// C/C++ include files
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <cerrno>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+using namespace dd4hep;
+using namespace dd4hep::sim;
+
+/// Scaling benchmark of the locked and the buffered ROOT output of Geant4Output2ROOT
+/**
+ *  Factory: Geant4OutputBenchmark
+ *
+ *  Usage: geoPluginRun -plugin Geant4OutputBenchmark [-events <n>] [-hits <n>]
+ *                      [-work <microseconds>] [-threads <n1>,<n2>,...] [-output <file>]
+ *
+ *  Worker threads produce events with tracker hits. Each event costs 'work'
+ *  microseconds of CPU time to mimic the simulation. The events are written
+ *  - like the shared output action: filled into a common tree under a global lock,
+ *  - like the buffered output action: serialized by the workers into a
+ *    Geant4Output2ROOTBuffer and written by a Geant4Output2ROOTWriter.
+ *  The event rates of both modes and the event order in the output are printed.
+ *
+ *  \author  agent
+ *  \version 1.0
+ */
+static long output_benchmark(Detector& /* description */, int argc, char** argv)  {
+  std::size_t num_events = 1000, num_hits = 1000;
+  long        work = 1000;
+  std::string output = "Geant4OutputBenchmark.root";
+  std::vector<int> threads = { 1, 2, 4, 8, 16, 32, 64 };
+  for(int i = 0; i < argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-events",argv[i],4) && i+1 < argc )
+      num_events = std::stoul(argv[++i]);
+    else if ( 0 == ::strncmp("-hits",argv[i],4) && i+1 < argc )
+      num_hits = std::stoul(argv[++i]);
+    else if ( 0 == ::strncmp("-work",argv[i],4) && i+1 < argc )
+      work = std::stol(argv[++i]);
+    else if ( 0 == ::strncmp("-output",argv[i],4) && i+1 < argc )
+      output = argv[++i];
+    else if ( 0 == ::strncmp("-threads",argv[i],4) && i+1 < argc )  {
+      std::stringstream str(argv[++i]);
+      std::string tok;
+      threads.clear();
+      while( std::getline(str, tok, ',') )
+        threads.emplace_back(std::stoi(tok));
+    }
+    else  {
+      std::cout <<
+        "Usage: -plugin Geant4OutputBenchmark  -arg [-arg]                              \n\n"
+        "     Compare the locked and the buffered ROOT output of Geant4Output2ROOT.     \n\n"
+        "     -events  <number>      Number of events. Default: 1000                    \n"
+        "     -hits    <number>      Number of tracker hits per event. Default: 1000    \n"
+        "     -work    <number>      CPU time per event in microseconds. Default: 1000  \n"
+        "     -threads <n1>,<n2>,..  Numbers of worker threads. Default: 1,2,4,...,64   \n"
+        "     -output  <file>        Output file name.                                  \n"
+        "     Arguments given: " << arguments(argc,argv) << std::endl << std::flush;
+      ::exit(EINVAL);
+    }
+  }
+  ROOT::EnableThreadSafety();
+  const ComponentCast& type = Geant4HitWrapper::manipulator<Geant4Tracker::Hit>()->vec_type;
+
+  /// Simulated event: busy for 'work' microseconds, then the hits are filled
+  auto simulate = [work](std::size_t id, std::vector<std::unique_ptr<Geant4Tracker::Hit> >& hits)  {
+    auto end = std::chrono::high_resolution_clock::now() + std::chrono::microseconds(work);
+    while( std::chrono::high_resolution_clock::now() < end ) {}
+    for( std::size_t i = 0; i < hits.size(); ++i )  {
+      auto& h = hits[i];
+      h->cellID        = (id << 20) + i;
+      h->energyDeposit = 1e-3 * double(i+1);
+      h->position      = { double(i), double(id), 1e0 };
+      h->momentum      = { 0e0, 0e0, double(id+1) };
+    }
+  };
+  /// Run 'num_events' events on 'nthreads' workers
+  auto run = [&](int nthreads, auto&& write_event)  {
+    std::atomic<std::size_t> next { 0 };
+    std::vector<std::thread> workers;
+    for( int t = 0; t < nthreads; ++t )  {
+      workers.emplace_back([&]()  {
+        std::vector<std::unique_ptr<Geant4Tracker::Hit> > hits;
+        std::vector<void*> ptrs;
+        for( std::size_t i = 0; i < num_hits; ++i )  {
+          hits.emplace_back(std::make_unique<Geant4Tracker::Hit>());
+          ptrs.emplace_back(hits.back().get());
+        }
+        for( std::size_t id = next++; id < num_events; id = next++ )  {
+          simulate(id, hits);
+          write_event(int(id), ptrs);
+        }
+      });
+    }
+    for( auto& w : workers ) w.join();
+  };
+  /// Check the event order in the output file
+  auto check = [](const std::string& fname, std::size_t& entries)  {
+    std::unique_ptr<TFile> file(TFile::Open(fname.c_str()));
+    TTree* tree = file ? file->Get<TTree>("G4EventIDs") : nullptr;
+    std::size_t disorder = 0;
+    entries = 0;
+    if ( tree )  {
+      Int_t id = 0, last = -1;
+      tree->SetBranchAddress("G4EventID", &id);
+      entries = tree->GetEntries();
+      for( Long64_t i = 0; i < tree->GetEntries(); ++i )  {
+        tree->GetEntry(i);
+        if ( id < last ) ++disorder;
+        last = id;
+      }
+    }
+    return disorder;
+  };
+
+  printout(ALWAYS,"Geant4OutputBenchmark","+++ %ld events with %ld tracker hits, %ld usec CPU time per event.",
+           num_events, num_hits, work);
+  for( int nthreads : threads )  {
+    /// Locked output: all workers fill the common event tree like the shared action
+    std::chrono::duration<double> locked_time;
+    {
+      auto start = std::chrono::high_resolution_clock::now();
+      std::mutex lock;
+      std::unique_ptr<TFile> file(TFile::Open(output.c_str(), "RECREATE"));
+      TDirectory::TContext ctxt(file.get());
+      TTree* tree    = new TTree("EVENT", "Geant4 EVENT information");
+      TTree* id_tree = new TTree("G4EventIDs", "Geant4 G4EventIDs information");
+      TBranch* hits  = tree->Branch("Hits", TBuffer::GetClass(type.type())->GetName(), static_cast<void*>(nullptr));
+      Int_t evtid = 0;
+      id_tree->Branch("G4EventID", &evtid, "G4EventID/I");
+      run(nthreads, [&](int id, std::vector<void*>& ptrs)  {
+        void* ptr = &ptrs;
+        std::lock_guard<std::mutex> guard(lock);
+        hits->SetAddress(&ptr);
+        tree->Fill();
+        evtid = id;
+        id_tree->Fill();
+      });
+      file->Write();
+      file->Close();
+      locked_time = std::chrono::high_resolution_clock::now() - start;
+    }
+    /// Buffered output: the workers serialize the events, the writer thread writes them
+    std::chrono::duration<double> buffered_time;
+    std::size_t entries = 0, disorder = 0;
+    {
+      auto start  = std::chrono::high_resolution_clock::now();
+      auto writer = std::make_shared<Geant4Output2ROOTWriter>(output, nthreads, 4*nthreads);
+      run(nthreads, [&](int id, std::vector<void*>& ptrs)  {
+        Geant4Output2ROOTBuffer buffer(output+".mem", "EVENT");
+        buffer.fill("Hits", type, &ptrs);
+        buffer.commit(id);
+        writer->push(id, buffer.serialize());
+      });
+      writer->close();
+      buffered_time = std::chrono::high_resolution_clock::now() - start;
+      disorder = check(writer->name(), entries);
+    }
+    gSystem->Unlink(output.c_str());
+    double locked_rate   = double(num_events)/locked_time.count();
+    double buffered_rate = double(num_events)/buffered_time.count();
+    double ideal_rate    = work > 0 ? 1e6*double(nthreads)/double(work) : 0e0;
+    printout(ALWAYS,"Geant4OutputBenchmark",
+             "+++ %3d threads: Locked output %9.1f events/sec  Buffered output %9.1f events/sec  "
+             "[CPU bound: %9.1f events/sec] %ld events written, %ld out of order",
+             nthreads, locked_rate, buffered_rate, ideal_rate, entries, disorder);
+  }
+  return 1;
+}
+DECLARE_APPLY(Geant4OutputBenchmark,output_benchmark)
@@ -0,0 +1,185 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : agent
+//
+//==========================================================================
+#ifndef DD4HEP_DDG4_GEANT4PARTICLERECORDCHECK_H
+#define DD4HEP_DDG4_GEANT4PARTICLERECORDCHECK_H
+
+// Framework include files
+#include <DDG4/Geant4EventAction.h>
+
+// C/C++ include files
+#include <map>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim {
+
+    /// Check the particle record and the track equivalents of the particle handler
+    /** The Geant4 parent of every track is recorded by a tracking action callback.
+     *  At the end of the event the track equivalents and the particle record
+     *  exported by the Geant4ParticleHandler are compared with the result of
+     *  the original std::map based algorithm:
+     *  - a track is equivalent to its first ancestor kept in the record,
+     *  - simulated particles are numbered in the order of their Geant4 track ID,
+     *  - the parent of a simulated particle is the particle equivalent to its Geant4 parent.
+     *
+     *  \author  agent
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4ParticleRecordCheck : public Geant4EventAction {
+    protected:
+      /// Geant4 parents of all tracks of the current event
+      std::map<int,int> m_parents;
+
+    public:
+      /// Standard constructor
+      Geant4ParticleRecordCheck(Geant4Context* context, const std::string& nam);
+      /// Default destructor
+      virtual ~Geant4ParticleRecordCheck();
+      /// Tracking action callback: record the Geant4 parent of the track
+      void endTracking(const G4Track* track);
+      /// Geant4EventAction interface: Begin-of-event callback
+      virtual void begin(const G4Event* event)  override;
+      /// Geant4EventAction interface: End-of-event callback
+      virtual void end(const G4Event* event)  override;
+    };
+
+  }    // End namespace sim
+}      // End namespace dd4hep
+
+#endif /* DD4HEP_DDG4_GEANT4PARTICLERECORDCHECK_H */
+
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : agent
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/InstanceCount.h>
+#include <DDG4/Geant4Particle.h>
+#include <DDG4/Geant4TrackingAction.h>
+
+// Geant 4 includes
+#include <G4Event.hh>
+#include <G4Track.hh>
+
+using namespace dd4hep::sim;
+
+/// Standard constructor
+Geant4ParticleRecordCheck::Geant4ParticleRecordCheck(Geant4Context* ctxt, const std::string& nam)
+  : Geant4EventAction(ctxt, nam)
+{
+  m_needsControl = true;
+  trackingAction().callAtFinal(this, &Geant4ParticleRecordCheck::endTracking);
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4ParticleRecordCheck::~Geant4ParticleRecordCheck() {
+  InstanceCount::decrement(this);
+}
+
+/// Tracking action callback: record the Geant4 parent of the track
+void Geant4ParticleRecordCheck::endTracking(const G4Track* track)   {
+  m_parents[track->GetTrackID()] = track->GetParentID();
+}
+
+/// Geant4EventAction interface: Begin-of-event callback
+void Geant4ParticleRecordCheck::begin(const G4Event* /* event */)   {
+  m_parents.clear();
+}
+
+/// Geant4EventAction interface: End-of-event callback
+void Geant4ParticleRecordCheck::end(const G4Event* event)    {
+  Geant4ParticleMap* parts = context()->event().extension<Geant4ParticleMap>();
+  if ( !parts )   {
+    warning("+++ [Event:%d] No particle map available!",event->GetEventID());
+    return;
+  }
+  const auto& particles = parts->particles();
+  const auto& equivalents = parts->equivalents();
+  long errors = 0;
+
+  /// Particles kept in the record by their Geant4 track identifier
+  std::map<int,int> kept;
+  for( const auto& p : particles )  {
+    if ( p.second->originalG4ID > 0 ) kept[p.second->originalG4ID] = p.first;
+  }
+
+  /// (1) Track equivalents: walk the Geant4 parents up to the first particle kept in the record
+  std::map<int,int> expected;
+  for( const auto& t : m_parents )  {
+    int g4_id = t.first;
+    auto ik = kept.find(g4_id);
+    while( ik == kept.end() )  {
+      auto ip = m_parents.find(g4_id);
+      if ( ip == m_parents.end() ) break;
+      g4_id = ip->second;
+      ik = kept.find(g4_id);
+    }
+    if ( ik != kept.end() ) expected[t.first] = ik->second;
+  }
+  for( const auto& e : expected )  {
+    auto ie = equivalents.find(e.first);
+    if ( ie == equivalents.end() || ie->second != e.second )  {
+      error("+++ [Event:%d] Track %d: equivalent particle %d expected %d.", event->GetEventID(),
+            e.first, ie == equivalents.end() ? -1 : ie->second, e.second);
+      ++errors;
+    }
+  }
+  if ( equivalents.size() != expected.size() )  {
+    error("+++ [Event:%d] %ld track equivalents expected %ld.", event->GetEventID(),
+          equivalents.size(), expected.size());
+    ++errors;
+  }
+
+  /// (2) Simulated particles are numbered in the order of the Geant4 track identifiers
+  int last_id = -1;
+  for( const auto& k : kept )  {
+    const Geant4Particle* p = particles.at(k.second);
+    if ( (p->reason&G4PARTICLE_PRIMARY) == G4PARTICLE_PRIMARY ) continue;
+    if ( p->id <= last_id )  {
+      error("+++ [Event:%d] Particle %d of track %d is not ordered by track ID.",
+            event->GetEventID(), p->id, k.first);
+      ++errors;
+    }
+    last_id = p->id;
+
+    /// (3) The parent is the particle equivalent to the Geant4 parent
+    auto ie = expected.find(p->g4Parent);
+    if ( p->g4Parent > 0 && ie != expected.end() )  {
+      auto iq = particles.find(ie->second);
+      if ( p->parents.empty() || *p->parents.begin() != ie->second ||
+           iq == particles.end() || iq->second->daughters.count(p->id) == 0 )  {
+        error("+++ [Event:%d] Particle %d: parent relationship to particle %d is wrong.",
+              event->GetEventID(), p->id, ie->second);
+        ++errors;
+      }
+    }
+  }
+  always("+++ [Event:%d] Particle record check: %ld particles, %ld track equivalents: %ld differences.",
+         event->GetEventID(), particles.size(), equivalents.size(), errors);
+}
+
+#include <DDG4/Factories.h>
+DECLARE_GEANT4ACTION(Geant4ParticleRecordCheck)
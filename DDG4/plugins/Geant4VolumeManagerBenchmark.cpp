@@ -0,0 +1,178 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : agent
+//
+//==========================================================================
+
+/** \addtogroup Geant4SteppingAction
+ *
+ * @{
+ * \package Geant4VolumeManagerBenchmark
+ *
+ * \brief Stepping action to measure the step rate of the touchable to volume ID lookup
+
+ The pre-step touchables of steps in sensitive volumes are collected until
+ 'SampleSize' touchables with different placement paths are available. The sample
+ is shuffled and resolved 'Repeat' times with Geant4VolumeManager::volumeID and
+ with the reference implementation (placement path vector, std::map lookup).
+ Consecutive lookups use different touchables: the last-hit cache of the volume
+ manager does not bias the result. The lookup rates and the number of mismatches
+ are printed when the action is deleted.
+
+ *
+ * @}
+ */
+
+#ifndef DDG4_Geant4VolumeManagerBenchmark_h
+#define DDG4_Geant4VolumeManagerBenchmark_h 1
+
+// Framework include files
+#include <DDG4/Geant4SteppingAction.h>
+#include <DDG4/Geant4VolumeManager.h>
+#include <DDG4/Geant4GeometryInfo.h>
+#include <DDG4/Geant4TouchableHandler.h>
+#include <DDG4/Geant4Mapping.h>
+
+// Geant4 include files
+#include <G4Step.hh>
+#include <G4TouchableHandle.hh>
+#include <G4LogicalVolume.hh>
+#include <G4VPhysicalVolume.hh>
+
+// C/C++ include files
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <unordered_set>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim {
+
+    /// Stepping action to benchmark the Geant4VolumeManager touchable lookup
+    /**
+     *  \author  agent
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4VolumeManagerBenchmark : public Geant4SteppingAction    {
+      typedef std::chrono::high_resolution_clock clock_t;
+      /// Property: Number of lookups per touchable of a sample
+      int         m_repeat   { 10 };
+      /// Property: Number of distinct touchables per sample
+      std::size_t m_sampleSize { 1000 };
+      /// Touchables of the current sample
+      std::vector<G4TouchableHandle> m_sample;
+      /// Placement path hashes of the current sample
+      std::unordered_set<uint64_t>   m_paths;
+      /// Random engine to shuffle the samples
+      std::mt19937 m_random      { 12345 };
+      /// Number of benchmarked touchables
+      std::size_t m_steps    { 0 };
+      /// Number of different results
+      std::size_t m_mismatch { 0 };
+      /// Time spent in the volume manager lookup
+      double      m_timeNew  { 0e0 };
+      /// Time spent in the reference lookup
+      double      m_timeRef  { 0e0 };
+
+      /// Reference implementation: heap allocated placement path and std::map lookup
+      static VolumeID reference(const Geant4GeometryInfo* info, const G4VTouchable* touchable, int& flags)  {
+        Geant4TouchableHandler handler(touchable);
+        std::vector<const G4VPhysicalVolume*> path = handler.placementPath();
+        flags = 0;
+        if ( path.empty() ) return Geant4VolumeManager::NonExisting;
+        uint64_t hash = detail::hash64(&path[0], sizeof(path[0])*path.size());
+        auto i = info->g4Paths.find(hash);
+        if ( i == info->g4Paths.end() ) return Geant4VolumeManager::NonExisting;
+        flags = (*i).second.flags;
+        return (*i).second.volumeID;
+      }
+
+    public:
+      /// Standard constructor
+      Geant4VolumeManagerBenchmark(Geant4Context* ctxt, const std::string& nam)
+        : Geant4SteppingAction(ctxt, nam)
+      {
+        declareProperty("Repeat",     m_repeat);
+        declareProperty("SampleSize", m_sampleSize);
+      }
+      /// Default destructor: print the result
+      virtual ~Geant4VolumeManagerBenchmark()   {
+        if ( m_steps > 0 )  {
+          double num = double(m_steps)*double(m_repeat);
+          always("+++ %ld distinct sensitive touchables, %d lookups per touchable. Mismatches: %ld",
+                 m_steps, m_repeat, m_mismatch);
+          always("+++ Reference lookup:      %12.0f lookups/sec", num/m_timeRef);
+          always("+++ Geant4VolumeManager:   %12.0f lookups/sec   speedup: %.2f",
+                 num/m_timeNew, m_timeRef/m_timeNew);
+        }
+        else  {
+          always("+++ Less than %ld distinct sensitive touchables seen. No benchmark result.", m_sampleSize);
+        }
+      }
+      /// Resolve the shuffled sample with both implementations
+      void benchmark()   {
+        Geant4VolumeManager mgr = Geant4Mapping::instance().volumeManager();
+        const Geant4GeometryInfo* info = mgr.ptr();
+        std::vector<VolumeID> vid_new(m_sample.size()), vid_ref(m_sample.size());
+        std::vector<int>      flags(m_sample.size());
+
+        std::shuffle(m_sample.begin(), m_sample.end(), m_random);
+        auto start = clock_t::now();
+        for( int i = 0; i < m_repeat; ++i )  {
+          for( std::size_t j = 0; j < m_sample.size(); ++j )
+            vid_new[j] = mgr.volumeID(m_sample[j]());
+        }
+        auto middle = clock_t::now();
+        for( int i = 0; i < m_repeat; ++i )  {
+          for( std::size_t j = 0; j < m_sample.size(); ++j )
+            vid_ref[j] = reference(info, m_sample[j](), flags[j]);
+        }
+        auto end = clock_t::now();
+
+        m_timeNew += std::chrono::duration<double>(middle-start).count();
+        m_timeRef += std::chrono::duration<double>(end-middle).count();
+        /// Parametrised/replicated placements add the copy numbers: compare only plain entries
+        for( std::size_t j = 0; j < m_sample.size(); ++j )  {
+          if ( vid_new[j] != vid_ref[j] && flags[j] == 0 )
+            ++m_mismatch;
+        }
+        m_steps += m_sample.size();
+        m_sample.clear();
+        m_paths.clear();
+      }
+      /// User stepping callback
+      virtual void operator()(const G4Step* step, G4SteppingManager*)  override   {
+        const G4TouchableHandle& touchable = step->GetPreStepPoint()->GetTouchableHandle();
+        const G4VPhysicalVolume* pv = touchable ? touchable->GetVolume() : nullptr;
+        if ( !pv || !pv->GetLogicalVolume()->GetSensitiveDetector() )  {
+          return;
+        }
+        Geant4TouchableHandler handler(touchable());
+        std::vector<const G4VPhysicalVolume*> path = handler.placementPath();
+        if ( path.empty() ) return;
+        uint64_t hash = detail::hash64(&path[0], sizeof(path[0])*path.size());
+        if ( m_paths.insert(hash).second )  {
+          m_sample.emplace_back(touchable);
+          if ( m_sample.size() >= m_sampleSize )
+            benchmark();
+        }
+      }
+    };
+  }
+}
+#endif   // DDG4_Geant4VolumeManagerBenchmark_h
+
+#include <DDG4/Factories.h>
+using namespace dd4hep::sim;
+DECLARE_GEANT4ACTION(Geant4VolumeManagerBenchmark)
@@ -831,17 +831,21 @@ class Geant4:
       self.kernel().generatorAction().add(gun)
     return gun
 
-  def setupROOTOutput(self, name, output, mc_truth=True):
+  def setupROOTOutput(self, name, output, mc_truth=True, buffered=False):
     """
     Configure ROOT output for the simulated events
 
+    In buffered mode each worker owns the output action and serializes its events
+    while a background thread writes them to the file in the order of the event ID.
+
     \author  M.Frank
     """
     # Only use shared=True in MT mode to avoid double-save in ST mode
-    shared = self.master().NumberOfThreads > 1
+    shared = self.master().NumberOfThreads > 1 and not buffered
 
     evt_root = EventAction(self.kernel(), 'Geant4Output2ROOT/' + name, shared)
     evt_root.HandleMCTruth = mc_truth
+    evt_root.Buffered = buffered
     evt_root.Control = True
     if not output.endswith('.root'):
       output = output + '.root'
@@ -689,6 +689,8 @@ class DD4hepSimulation(object):
     field.delta_intersection = self.field.delta_intersection
     field.delta_one_step = self.field.delta_one_step
     field.largest_step = self.field.largest_step
+    field.field_cache_radius = self.field.cache_radius
+    field.field_cache_tolerance = self.field.cache_tolerance
 
   def __checkFilesExist(self, fileNames, fileType=''):
     """Make sure all files in the given list exist, add to errorMessage otherwise.
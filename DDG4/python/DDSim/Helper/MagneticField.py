@@ -1,5 +1,5 @@
 """Helper object for Magnetic Field properties"""
-from g4units import mm, m
+from g4units import mm, m, tesla
 from DDSim.Helper.ConfigHelper import ConfigHelper
 
 
@@ -17,4 +17,8 @@ class MagneticField(ConfigHelper):
     self.delta_intersection = 0.001 * mm
     self.delta_one_step = 0.01 * mm
     self.largest_step = 10 * m
+    self._cache_radius_EXTRA = {'help': 'Validity radius of the field cache cells. The cache is disabled if negative'}
+    self.cache_radius = -1.0
+    self._cache_tolerance_EXTRA = {'help': 'Tolerated absolute deviation of the cached field values'}
+    self.cache_tolerance = 1e-4 * tesla
     self._closeProperties()
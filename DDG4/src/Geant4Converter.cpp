@@ -71,6 +71,8 @@
 #include <G4MaterialPropertiesIndex.hh>
 #endif
 #include <G4ScaledSolid.hh>
+#include <G4Voxelizer.hh>
+#include <G4TessellatedSolid.hh>
 #include <CLHEP/Units/SystemOfUnits.h>
 
 // C/C++ include files
@@ -78,6 +80,11 @@
 #include <iomanip>
 #include <sstream>
 #include <limits>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <exception>
 
 namespace units = dd4hep;
 using namespace dd4hep::sim;
@@ -689,6 +696,11 @@ void* Geant4Converter::handleSolid(const std::string& name, const TGeoShape* sha
       solid = convertShape<TGeoArb8>(shape);
     else if (isa == TGeoPara::Class())
       solid = convertShape<TGeoPara>(shape);
+    else if (isa == TGeoTessellated::Class() && m_deferClose && m_constituents.count(shape) == 0)  {
+      G4TessellatedSolid* g4 = convertTessellatedShape(shape, false);
+      m_openSolids.emplace_back(shape, g4);
+      solid = g4;
+    }
     else if (isa == TGeoTessellated::Class()) 
       solid = convertShape<TGeoTessellated>(shape);
     else if (isa == TGeoScaledShape::Class())  {
@@ -779,6 +791,42 @@ void* Geant4Converter::handleSolid(const std::string& name, const TGeoShape* sha
   return solid;
 }
 
+/// Close the deferred tessellated solids (vertex merging, voxelization) in parallel
+void Geant4Converter::closeSolids()  const  {
+  if ( m_openSolids.empty() ) return;
+  /// Closing a solid only touches the solid itself. The G4 stores are filled
+  /// by the constructors in the serial solid pass: the conversion stays deterministic.
+  std::size_t nthreads = std::min(std::size_t(numThreads), m_openSolids.size());
+  std::atomic<std::size_t> next { 0 };
+  std::exception_ptr error;
+  std::mutex lock;
+  G4int voxels = G4Voxelizer::GetDefaultVoxelsCount();
+  auto close = [&]()  {
+    G4Voxelizer::SetDefaultVoxelsCount(voxels);
+    for( std::size_t i = next++; i < m_openSolids.size(); i = next++ )  {
+      const auto* sh = (const TGeoTessellated*)m_openSolids[i].first;
+      try  {
+        m_openSolids[i].second->SetSolidClosed(sh->IsClosedBody());
+      }
+      catch(...)  {
+        std::lock_guard<std::mutex> guard(lock);
+        if ( !error ) error = std::current_exception();
+      }
+    }
+  };
+  TTimeStamp start;
+  std::vector<std::thread> threads;
+  for( std::size_t i = 0; i < nthreads; ++i )
+    threads.emplace_back(close);
+  for( auto& t : threads ) t.join();
+  std::size_t num_solids = m_openSolids.size();
+  m_openSolids.clear();
+  if ( error ) std::rethrow_exception(error);
+  TTimeStamp stop;
+  printout(outputLevel, "Geant4Converter", "++ Closed %ld tessellated solids with %ld threads in %8.3f seconds.",
+           num_solids, nthreads, stop.AsDouble()-start.AsDouble());
+}
+
 /// Dump logical volume in GDML format to output stream
 void* Geant4Converter::handleVolume(const std::string& name, const TGeoVolume* volume) const {
   Volume _v(volume);
@@ -1772,7 +1820,28 @@ Geant4Converter& Geant4Converter::create(DetElement top) {
   handleArray(this, geo.manager->GetListOfOpticalSurfaces(), &Geant4Converter::handleOpticalSurface);
   
   handle(this,     geo.volumes, &Geant4Converter::collectVolume);
+  m_deferClose = numThreads > 1;
+  if ( m_deferClose )   {
+    /// Constituents of boolean and scaled shapes are closed before their users are built
+    std::vector<const TGeoShape*> stack(geo.solids.begin(), geo.solids.end());
+    while( !stack.empty() )   {
+      const TGeoShape* sh = stack.back();
+      stack.pop_back();
+      if ( sh->IsA() == TGeoCompositeShape::Class() )   {
+        const TGeoBoolNode* boolean = ((const TGeoCompositeShape*)sh)->GetBoolNode();
+        for( const TGeoShape* c : { boolean->GetLeftShape(), boolean->GetRightShape() } )
+          if ( m_constituents.insert(c).second ) stack.emplace_back(c);
+      }
+      else if ( sh->IsA() == TGeoScaledShape::Class() )   {
+        const TGeoShape* c = ((const TGeoScaledShape*)sh)->GetShape();
+        if ( m_constituents.insert(c).second ) stack.emplace_back(c);
+      }
+    }
+  }
   handle(this,     geo.solids,  &Geant4Converter::handleSolid);
+  m_deferClose = false;
+  m_constituents.clear();
+  closeSolids();
   printout(outputLevel, "Geant4Converter", "++ Handled %ld solids.", geo.solids.size());
   handleRefs(this, geo.vis,     &Geant4Converter::handleVis);
   printout(outputLevel, "Geant4Converter", "++ Handled %ld visualization attributes.", geo.vis.size());
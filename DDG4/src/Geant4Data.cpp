@@ -22,10 +22,100 @@
 // Geant4 include files
 #include <G4Step.hh>
 #include <G4Allocator.hh>
+#include <G4Threading.hh>
 #include <G4OpticalPhoton.hh>
 
+// C/C++ include files
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <typeinfo>
+
 using namespace dd4hep::sim;
 
+namespace {
+
+  /// Per-thread pool of hits of one type
+  /** Pooling is only enabled in Geant4 worker threads, where hits are created and
+   *  deleted by the event loop of the same thread. Hits allocated by any other
+   *  thread (DDDigi, ROOT I/O, sequential Geant4) use the global allocator.
+   *  Every hit is preceded by a header naming its pool. Pooled hits deleted by
+   *  a foreign thread are handed back to the owning pool, which reuses them
+   *  at its next allocation.
+   */
+  template <typename HIT> class HitPool  {
+  public:
+    /// Memory block of one hit: pool header followed by the hit data
+    struct Block  {
+      HitPool* owner;
+      alignas(HIT) unsigned char data[sizeof(HIT)];
+    };
+
+  private:
+    /// Geant4 allocator serving the blocks of this pool
+    G4Allocator<Block>  m_allocator;
+    /// Lock protecting the blocks returned by foreign threads
+    std::mutex          m_lock;
+    /// Blocks returned by foreign threads
+    std::vector<Block*> m_returned;
+    /// Flag to avoid locking if no blocks were returned
+    std::atomic<bool>   m_hasReturned { false };
+
+    /// Access the pool of the current thread
+    static HitPool*& current()  {
+      static G4ThreadLocal HitPool* pool = nullptr;
+      return pool;
+    }
+    /// Access the block header of a hit
+    static Block* block(const void* ptr)  {
+      return (Block*)((const unsigned char*)ptr - offsetof(Block,data));
+    }
+    /// Allocate a block from the pool
+    Block* malloc_block()  {
+      if ( m_hasReturned.load(std::memory_order_acquire) )  {
+        std::lock_guard<std::mutex> lock(m_lock);
+        for( Block* b : m_returned ) m_allocator.FreeSingle(b);
+        m_returned.clear();
+        m_hasReturned.store(false, std::memory_order_release);
+      }
+      return m_allocator.MallocSingle();
+    }
+    /// Hand a block back to the pool from a foreign thread
+    void return_block(Block* b)  {
+      std::lock_guard<std::mutex> lock(m_lock);
+      m_returned.emplace_back(b);
+      m_hasReturned.store(true, std::memory_order_release);
+    }
+
+  public:
+    /// Allocate the memory of one hit
+    static void* allocate()  {
+      HitPool*& pool = current();
+      if ( !pool && G4Threading::IsWorkerThread() ) pool = new HitPool();
+      Block* b = pool ? pool->malloc_block() : (Block*)::operator new(sizeof(Block));
+      b->owner = pool;
+      return b->data;
+    }
+    /// Release the memory of one hit
+    static void release(void* ptr)  {
+      Block* b = block(ptr);
+      if ( !b->owner )
+        ::operator delete(b);
+      else if ( b->owner == current() )
+        b->owner->m_allocator.FreeSingle(b);
+      else
+        b->owner->return_block(b);
+    }
+    /// Check if the hit memory is owned by a pool
+    static bool pooled(const void* ptr)  {
+      return block(ptr)->owner != nullptr;
+    }
+  };
+  typedef HitPool<Geant4Tracker::Hit>     TrackerHitPool;
+  typedef HitPool<Geant4Calorimeter::Hit> CalorimeterHitPool;
+}
+
 /// Default constructor
 SimpleRun::SimpleRun()  {
   InstanceCount::increment(this);
@@ -129,6 +219,24 @@ Geant4Tracker::Hit::~Hit() {
   InstanceCount::decrement(this);
 }
 
+/// Geant4 required object allocator
+void* Geant4Tracker::Hit::operator new(std::size_t size)  {
+  /// Sub-classes with additional data members use the standard allocator
+  if ( size != sizeof(Hit) ) return ::operator new(size);
+  return TrackerHitPool::allocate();
+}
+
+/// Geant4 required object destroyer
+void Geant4Tracker::Hit::operator delete(void* ptr, std::size_t size)  {
+  if ( size != sizeof(Hit) ) return ::operator delete(ptr);
+  TrackerHitPool::release(ptr);
+}
+
+/// Check if the hit is taken from the pool of a Geant4 worker thread
+bool Geant4Tracker::Hit::isPooled(const Hit* hit)  {
+  return typeid(*hit) == typeid(Hit) && TrackerHitPool::pooled(hit);
+}
+
 /// Explicit assignment operation
 void Geant4Tracker::Hit::copyFrom(const Hit& c) {
   if ( &c != this )  {
@@ -208,3 +316,21 @@ Geant4Calorimeter::Hit::Hit(const Position& pos) : position(pos)  {
 Geant4Calorimeter::Hit::~Hit() {
   InstanceCount::decrement(this);
 }
+
+/// Geant4 required object allocator
+void* Geant4Calorimeter::Hit::operator new(std::size_t size)  {
+  /// Sub-classes with additional data members use the standard allocator
+  if ( size != sizeof(Hit) ) return ::operator new(size);
+  return CalorimeterHitPool::allocate();
+}
+
+/// Geant4 required object destroyer
+void Geant4Calorimeter::Hit::operator delete(void* ptr, std::size_t size)  {
+  if ( size != sizeof(Hit) ) return ::operator delete(ptr);
+  CalorimeterHitPool::release(ptr);
+}
+
+/// Check if the hit is taken from the pool of a Geant4 worker thread
+bool Geant4Calorimeter::Hit::isPooled(const Hit* hit)  {
+  return typeid(*hit) == typeid(Hit) && CalorimeterHitPool::pooled(hit);
+}
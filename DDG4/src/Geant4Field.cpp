@@ -13,17 +13,44 @@
 
 // Framework include files
 #include <DDG4/Geant4Field.h>
+#include <DD4hep/FieldTypes.h>
 #include <DD4hep/DD4hepUnits.h>
 #include <CLHEP/Units/SystemOfUnits.h>
+
+// C/C++ include files
+#include <algorithm>
+#include <cmath>
+
 namespace units = dd4hep;
 
 using namespace dd4hep::sim;
 
+namespace {
+  /// Check if a field component is constant everywhere
+  bool is_constant(const dd4hep::CartesianField& f)  {
+    auto* c = dynamic_cast<dd4hep::ConstantField*>(f.ptr());
+    return c && (0 == c->flag || nullptr == c->volume.ptr());
+  }
+}
+
+/// Constructor with field cache
+Geant4Field::Geant4Field(OverlayedField field, const CacheSetup& setup)
+  : m_field(field), m_setup(setup)
+{
+  const auto& components = m_field.data<OverlayedField::Object>()->magnetic_components;
+  if ( std::all_of(components.begin(), components.end(), is_constant) )   {
+    const double origin[3] = { 0e0, 0e0, 0e0 };
+    evaluate(origin, m_constant);
+    m_isConstant = true;
+  }
+}
+
 G4bool Geant4Field::DoesFieldChangeEnergy() const {
   return m_field.changesEnergy();
 }
 
-void Geant4Field::GetFieldValue(const double pos[4], double *field) const {
+/// Evaluate the detector description field. Position and field in Geant4 units
+void Geant4Field::evaluate(const double pos[3], double* field)  const  {
   static constexpr double fac1 = units::mm/CLHEP::mm;
   static constexpr double fac2 = CLHEP::tesla/units::tesla;
   double p[3] = {pos[0]*fac1, pos[1]*fac1, pos[2]*fac1}; // Convert from CLHEP units to tgeo units
@@ -34,3 +61,90 @@ void Geant4Field::GetFieldValue(const double pos[4], double *field) const {
   field[2] *= fac2;
   //::printf("Pos: %7.4f %7.4f %7.4f --> %9g %9g %9g\n",p[0],p[1],p[2],field[0],field[1],field[2]);
 }
+
+/// Compute a new cache cell around the given position and return the field value
+void Geant4Field::refresh(const double pos[3], double* field)  const  {
+  const double h   = m_setup.radius;
+  const double tol = m_setup.tolerance;
+  Cache& c = m_cache;
+  int mode = Cache::LINEAR;
+
+  evaluate(pos, field);
+  if ( tol > 0e0 && (c.mode == Cache::LINEAR || c.mode == Cache::CONSTANT) )   {
+    // Check the values delivered by the previous cell at the border to the new cell.
+    // If they were not good enough, the field is not smooth on the scale of the radius.
+    const double d[3] = { pos[0]-c.pos[0], pos[1]-c.pos[1], pos[2]-c.pos[2] };
+    if ( std::max({std::abs(d[0]), std::abs(d[1]), std::abs(d[2])}) <= 2e0*h )   {
+      for( int i = 0; i < 3; ++i )  {
+        double val = c.field[i];
+        if ( c.mode == Cache::LINEAR )
+          val += c.grad[i][0]*d[0] + c.grad[i][1]*d[1] + c.grad[i][2]*d[2];
+        if ( std::abs(val - field[i]) > tol ) mode = Cache::EXACT;
+      }
+    }
+  }
+  std::copy(pos, pos+3, c.pos);
+  std::copy(field, field+3, c.field);
+  if ( mode == Cache::LINEAR )   {
+    // Central differences at the cell border. The second differences estimate
+    // the error of the linearisation: discontinuities inside the cell are
+    // detected and the cell is evaluated exactly.
+    double change = 0e0, curvature = 0e0;
+    for( int j = 0; j < 3; ++j )  {
+      double p[3] = { pos[0], pos[1], pos[2] }, bp[3], bm[3];
+      p[j] = pos[j] + h;
+      evaluate(p, bp);
+      p[j] = pos[j] - h;
+      evaluate(p, bm);
+      for( int i = 0; i < 3; ++i )  {
+        c.grad[i][j] = (bp[i] - bm[i]) / (2e0*h);
+        change       = std::max(change, std::abs(bp[i] - bm[i]));
+        curvature    = std::max(curvature, std::abs(bp[i] + bm[i] - 2e0*field[i]));
+      }
+    }
+    if ( tol > 0e0 && 1.5e0*curvature > tol )
+      mode = Cache::EXACT;
+    else if ( tol > 0e0 && 1.5e0*change <= tol )
+      mode = Cache::CONSTANT;
+  }
+  c.mode = mode;
+  ++m_stat.cells;
+}
+
+void Geant4Field::GetFieldValue(const double pos[4], double *field) const {
+  if ( m_isConstant )   {
+    field[0] = m_constant[0];
+    field[1] = m_constant[1];
+    field[2] = m_constant[2];
+    return;
+  }
+  else if ( m_setup.radius > 0e0 )   {
+    const Cache& c = m_cache;
+    const double d[3] = { pos[0]-c.pos[0], pos[1]-c.pos[1], pos[2]-c.pos[2] };
+    if ( c.mode != Cache::INVALID &&
+         std::max({std::abs(d[0]), std::abs(d[1]), std::abs(d[2])}) <= m_setup.radius )   {
+      switch( c.mode )  {
+      case Cache::CONSTANT:
+        ++m_stat.hits;
+        field[0] = c.field[0];
+        field[1] = c.field[1];
+        field[2] = c.field[2];
+        return;
+      case Cache::LINEAR:
+        ++m_stat.hits;
+        ++m_stat.linear;
+        field[0] = c.field[0] + c.grad[0][0]*d[0] + c.grad[0][1]*d[1] + c.grad[0][2]*d[2];
+        field[1] = c.field[1] + c.grad[1][0]*d[0] + c.grad[1][1]*d[1] + c.grad[1][2]*d[2];
+        field[2] = c.field[2] + c.grad[2][0]*d[0] + c.grad[2][1]*d[1] + c.grad[2][2]*d[2];
+        return;
+      default:
+        ++m_stat.exact;
+        evaluate(pos, field);
+        return;
+      }
+    }
+    refresh(pos, field);
+    return;
+  }
+  evaluate(pos, field);
+}
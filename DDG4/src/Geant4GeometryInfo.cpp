@@ -49,3 +49,22 @@ void Geant4GeometryInfo::setWorld(const TGeoNode* node)    {
   }
   m_world = g4;
 }
+
+/// Build the table from the path map
+void Geant4GeometryInfo::PathTable::build(const std::map<uint64_t, Placement>& paths)   {
+  std::size_t size = 16;
+  while( size < 2*paths.size() ) size <<= 1;
+  slots.assign(size, Entry { 0, { 0, 0 } });
+  mask     = size - 1;
+  has_zero = false;
+  for( const auto& p : paths )  {
+    if ( p.first == 0 )  {
+      zero     = p.second;
+      has_zero = true;
+      continue;
+    }
+    uint64_t i = p.first & mask;
+    while( slots[i].key != 0 ) i = (i + 1) & mask;
+    slots[i] = Entry { p.first, p.second };
+  }
+}
@@ -80,6 +80,7 @@ Geant4HitCollection::Compare::~Compare()  {
 Geant4HitCollection::~Geant4HitCollection() {
   m_hits.clear();
   m_keys.clear();
+  m_positions.clear();
   InstanceCount::decrement(this);
 }
 
@@ -103,6 +104,7 @@ void Geant4HitCollection::clear()   {
   m_lastHit = ULONG_MAX;
   m_hits.clear();
   m_keys.clear();
+  m_positions.clear();
 }
 
 /// Find hit in a collection by comparison of attributes
@@ -142,6 +144,7 @@ void Geant4HitCollection::releaseData(const ComponentCast& cast, std::vector<voi
   }
   m_lastHit = ULONG_MAX;
   m_keys.clear();
+  m_positions.clear();
 }
 
 /// Release all hits from the Geant4 container. Ownership stays with the container
@@ -166,6 +169,7 @@ void Geant4HitCollection::releaseHitsUnchecked(std::vector<void*>& result) {
   }
   m_lastHit = ULONG_MAX;
   m_keys.clear();
+  m_positions.clear();
 }
 
 /// Release all hits from the Geant4 container. Ownership stays with the container
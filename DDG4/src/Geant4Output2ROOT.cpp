@@ -27,16 +27,251 @@
 #include <G4Run.hh>
 
 // ROOT include files
+#include <TROOT.h>
 #include <TFile.h>
 #include <TTree.h>
 #include <TBranch.h>
 #include <TSystem.h>
+#include <TMemFile.h>
+#include <TFileMerger.h>
+
+// C/C++ include files
+#include <algorithm>
 
 using namespace dd4hep::sim;
 
 /// Define the static mutex for ROOT I/O protection
 std::mutex Geant4Output2ROOT::s_rootMutex;
 
+namespace {
+  /// Buffer of the event currently saved by this thread in buffered mode
+  thread_local Geant4Output2ROOTBuffer* s_eventBuffer = nullptr;
+
+  /// Writers of the buffered output by file name. Protected by s_rootMutex
+  std::map<std::string, std::weak_ptr<Geant4Output2ROOTWriter> >& writers()  {
+    static std::map<std::string, std::weak_ptr<Geant4Output2ROOTWriter> > s_writers;
+    return s_writers;
+  }
+
+  /// Fill a branch of the event tree. Missing entries are padded with NULL pointers
+  int fill_branch(TTree* tree, std::map<std::string, TBranch*>& branches,
+                  const std::string& nam, const dd4hep::ComponentCast& type, void* ptr)
+  {
+    TBranch* b = nullptr;
+    auto i = branches.find(nam);
+    if (i == branches.end()) {
+      const std::type_info& typ = type.type();
+      if (auto* cl = TBuffer::GetClass(typ)) {
+        b = tree->Branch(nam.c_str(), cl->GetName(), static_cast<void*>(nullptr));
+        b->SetAutoDelete(false);
+        branches.emplace(nam, b);
+      }
+      else {
+        throw std::runtime_error("No ROOT TClass object available for object type:" + dd4hep::typeName(typ));
+      }
+    }
+    else {
+      b = i->second;
+    }
+    const Long64_t evt  = b->GetEntries();
+    const Long64_t nevt = b->GetTree()->GetEntries();
+    if (nevt > evt) {
+      b->SetAddress(nullptr);
+      for (Long64_t num = nevt - evt; num > 0; --num)
+        b->Fill();
+    }
+    b->SetAddress(&ptr);
+    const int nbytes = b->Fill();
+    if (nbytes < 0) {
+      throw std::runtime_error("Failed to write ROOT collection:" + nam + "!");
+    }
+    return nbytes;
+  }
+
+  /// Fill the event ID and pad all branches, which have less entries than the event tree
+  void commit_event(TTree* tree, TTree* id_tree, Int_t evtid)   {
+    TBranch* br = id_tree->GetBranch("G4EventID");
+    if (!br) {
+      br = id_tree->Branch("G4EventID", &evtid, "G4EventID/I");
+    }
+    else {
+      br->SetAddress(&evtid);
+    }
+    id_tree->Fill();
+
+    auto* a = tree->GetListOfBranches();
+    const Long64_t evt = tree->GetEntries() + 1;
+    const Int_t nb = a->GetEntriesFast();
+    /// Fill NULL pointers to all branches, which have less entries than the Event branch
+    for (Int_t i = 0; i < nb; ++i) {
+      auto* br_ptr = static_cast<TBranch*>(a->UncheckedAt(i));
+      const Long64_t br_evt = br_ptr->GetEntries();
+      if (br_evt < evt) {
+        br_ptr->SetAddress(nullptr);
+        for (Long64_t num = evt - br_evt; num > 0; --num)
+          br_ptr->Fill();
+      }
+    }
+    tree->SetEntries(evt);
+  }
+}
+
+/// Initializing constructor
+Geant4Output2ROOTBuffer::Geant4Output2ROOTBuffer(const std::string& nam, const std::string& sec)
+  : m_file(std::make_unique<TMemFile>(nam.c_str(), "RECREATE"))
+{
+  m_tree = section(sec);
+}
+
+/// Default destructor
+Geant4Output2ROOTBuffer::~Geant4Output2ROOTBuffer()   {
+  if ( m_file ) m_file->Close();
+}
+
+/// Create/access tree by name
+TTree* Geant4Output2ROOTBuffer::section(const std::string& nam)  {
+  auto i = m_sections.find(nam);
+  if (i == m_sections.end()) {
+    TDirectory::TContext ctxt(m_file.get());
+    TTree* t = new TTree(nam.c_str(), ("Geant4 " + nam + " information").c_str());
+    m_sections.emplace(nam, t);
+    return t;
+  }
+  return i->second;
+}
+
+/// Fill single EVENT branch entry (Geant4 collection data)
+int Geant4Output2ROOTBuffer::fill(const std::string& nam, const ComponentCast& type, void* ptr)  {
+  return fill_branch(m_tree, m_branches, nam, type, ptr);
+}
+
+/// Commit data at end of filling procedure
+void Geant4Output2ROOTBuffer::commit(int event_id)  {
+  commit_event(m_tree, section("G4EventIDs"), event_id);
+  m_committed = true;
+}
+
+/// Write the trees and return the content of the memory file
+Geant4Output2ROOTBuffer::Buffer Geant4Output2ROOTBuffer::serialize()   {
+  Buffer buffer;
+  if ( m_file )   {
+    TDirectory::TContext ctxt(m_file.get());
+    m_branches.clear();
+    m_sections.clear();
+    m_file->Write();
+    buffer.resize(m_file->GetSize());
+    m_file->CopyTo(buffer.data(), buffer.size());
+    m_file->Close();
+    m_file.reset();
+    m_tree = nullptr;
+  }
+  return buffer;
+}
+
+/// Initializing constructor: opens the output file and starts the writer thread
+Geant4Output2ROOTWriter::Geant4Output2ROOTWriter(const std::string& fname, int clients, std::size_t window)
+  : m_name(fname), m_merger(std::make_unique<TFileMerger>(kFALSE, kFALSE)),
+    m_window(window), m_clients(clients)
+{
+  m_merger->SetPrintLevel(0);
+  m_merger->SetMsgPrefix("Geant4Output2ROOT");
+  if ( !gSystem->AccessPathName(fname.c_str()) )  {
+    gSystem->Unlink(fname.c_str());
+  }
+  if ( !m_merger->OutputFile(fname.c_str(), "RECREATE") )  {
+    m_name = fname + ".1";
+    if ( !m_merger->OutputFile(m_name.c_str(), "RECREATE") )
+      dd4hep::except("Geant4Output2ROOT","Failed to create ROOT output file:'%s'", fname.c_str());
+  }
+  m_thread = std::thread([this]() { run(); });
+}
+
+/// Default destructor: flushes all events and closes the output file
+Geant4Output2ROOTWriter::~Geant4Output2ROOTWriter()   {
+  close();
+}
+
+/// Queue a serialized event
+void Geant4Output2ROOTWriter::push(int event_id, Buffer&& buffer)   {
+  {
+    std::lock_guard<std::mutex> lock(m_lock);
+    if ( m_stop )   {
+      dd4hep::printout(dd4hep::ERROR,"Geant4Output2ROOT","+++ Event %d lost: output file %s is closed.",
+                       event_id, m_name.c_str());
+      return;
+    }
+    m_queue.emplace_back(event_id, std::move(buffer));
+  }
+  m_cond.notify_one();
+}
+
+/// Release one client. The last client closes the output file
+void Geant4Output2ROOTWriter::release()   {
+  if ( --m_clients <= 0 ) close();
+}
+
+/// Check if the output file is closed and events are no longer accepted
+bool Geant4Output2ROOTWriter::closed()   {
+  std::lock_guard<std::mutex> lock(m_lock);
+  return m_stop;
+}
+
+/// Write all pending events and close the output file
+void Geant4Output2ROOTWriter::close()   {
+  std::call_once(m_closed, [this]()  {
+    {
+      std::lock_guard<std::mutex> lock(m_lock);
+      m_stop = true;
+    }
+    m_cond.notify_one();
+    if ( m_thread.joinable() ) m_thread.join();
+    dd4hep::printout(dd4hep::INFO,"Geant4Output2ROOT","+++ Closing ROOT output file %s [%ld events]",
+                     m_name.c_str(), m_events);
+    /// The merger writes and closes the output file
+    m_merger.reset();
+  });
+}
+
+/// Writer thread: merge queued events to the output file
+void Geant4Output2ROOTWriter::run()   {
+  std::unique_lock<std::mutex> lock(m_lock);
+  for(;;)   {
+    m_cond.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+    for( auto& e : m_queue )
+      m_pending.emplace(e.first, std::move(e.second));
+    m_queue.clear();
+    bool stop = m_stop;
+    lock.unlock();
+    merge(stop);
+    lock.lock();
+    if ( stop && m_queue.empty() ) break;
+  }
+}
+
+/// Merge pending events to the output file
+void Geant4Output2ROOTWriter::merge(bool all)   {
+  std::size_t count = 0;
+  while ( !m_pending.empty() )   {
+    auto i = m_pending.begin();
+    if ( !all && i->first != m_next && m_pending.size() <= m_window ) break;
+    Buffer& data = i->second;
+    if ( !data.empty() )  {
+      m_merger->AddAdoptFile(new TMemFile((m_name+".mem").c_str(), data.data(), data.size(), "READ"));
+      ++count;
+    }
+    m_next = i->first + 1;
+    m_pending.erase(i);
+  }
+  if ( count > 0 )   {
+    if ( !m_merger->PartialMerge(TFileMerger::kAllIncremental) )  {
+      dd4hep::printout(dd4hep::ERROR,"Geant4Output2ROOT","+++ Failed to write %ld events to %s",
+                       count, m_name.c_str());
+      return;
+    }
+    m_events += count;
+  }
+}
+
 /// Standard constructor
 Geant4Output2ROOT::Geant4Output2ROOT(Geant4Context* ctxt, const std::string& nam)
   : Geant4OutputAction(ctxt, nam) {
@@ -45,11 +280,15 @@ Geant4Output2ROOT::Geant4Output2ROOT(Geant4Context* ctxt, const std::string& nam
   declareProperty("DisabledCollections",  m_disabledCollections);
   declareProperty("DisableParticles",     m_disableParticles);
   declareProperty("FilesByRun",           m_filesByRun);
+  declareProperty("Buffered",             m_buffered);
+  declareProperty("ReorderWindow",        m_reorderWindow);
   InstanceCount::increment(this);
 }
 
 /// Default destructor
 Geant4Output2ROOT::~Geant4Output2ROOT() {
+  /// The writer of the buffered output is closed by its last user
+  m_writer.reset();
   closeOutput();
   InstanceCount::decrement(this);
 }
@@ -61,12 +300,35 @@ void Geant4Output2ROOT::endRun(const G4Run* run) {
   // ST: nThreads==0, close immediately
   // MT: wait until every worker has called endRun before closing
   int done = ++m_endRunCount;
-  if (nThreads == 0 || done >= nThreads) {
+  if ( m_writer )  {
+    /// The writer counts the endRun calls of all instances
+    m_writer->release();
+  }
+  else if (nThreads == 0 || done >= nThreads) {
     closeOutput();
   }
   Geant4OutputAction::endRun(run);
 }
 
+/// End-of-event callback: in buffered mode the event is serialized by this thread
+void Geant4Output2ROOT::end(const G4Event* evt)  {
+  if ( !m_writer )   {
+    Geant4OutputAction::end(evt);
+    return;
+  }
+  /// Reset the thread's event buffer also if saving the event throws
+  struct Guard  {
+    Guard(Geant4Output2ROOTBuffer* b)  {  s_eventBuffer = b;        }
+    ~Guard()                           {  s_eventBuffer = nullptr;  }
+  };
+  Geant4Output2ROOTBuffer buffer(m_writer->name()+".mem", m_section);
+  {
+    Guard guard(&buffer);
+    Geant4OutputAction::end(evt);
+  }
+  m_writer->push(evt->GetEventID(), buffer.committed() ? buffer.serialize() : Geant4Output2ROOTBuffer::Buffer());
+}
+
 /// Close current output file. Must be called with s_rootMutex held.
 void Geant4Output2ROOT::closeOutputLocked()   {
   if (!m_file) return;
@@ -85,12 +347,17 @@ void Geant4Output2ROOT::closeOutputLocked()   {
 
 /// Close current output file
 void Geant4Output2ROOT::closeOutput()   {
+  if ( m_writer )   {
+    m_writer->close();
+    return;
+  }
   std::lock_guard<std::mutex> lock(s_rootMutex);
   closeOutputLocked();
 }
 
 /// Create/access tree by name
 TTree* Geant4Output2ROOT::section(const std::string& nam) {
+  if ( s_eventBuffer ) return s_eventBuffer->section(nam);
   auto i = m_sections.find(nam);
   if (i == m_sections.end()) {
     TDirectory::TContext ctxt(m_file.get());
@@ -118,7 +385,24 @@ void Geant4Output2ROOT::beginRun(const G4Run* run) {
     if ( idx != std::string::npos )
       fname += m_output.substr(idx);
   }
-  if ( !m_file && !fname.empty() ) {
+  if ( m_buffered && !fname.empty() )  {
+    /// All instances writing the same file share the writer. It is closed after
+    /// the endRun calls of all workers, which is also the case for a shared instance.
+    const int nThreads = context()->kernel().master().numThreads();
+    std::size_t window = m_reorderWindow > 0 ? m_reorderWindow : 4*std::max(nThreads, 1);
+    ROOT::EnableThreadSafety();
+    /// The writer of the previous run is closed. As in the locked mode a file
+    /// closed at the end of a run is recreated by the next run.
+    m_writer.reset();
+    auto& entry = writers()[fname];
+    m_writer = entry.lock();
+    if ( !m_writer || m_writer->closed() )   {
+      info("+++ Opening buffered ROOT output file %s [reorder window: %ld events]", fname.c_str(), window);
+      m_writer = std::make_shared<Geant4Output2ROOTWriter>(fname, std::max(nThreads, 1), window);
+      entry = m_writer;
+    }
+  }
+  else if ( !m_file && !fname.empty() ) {
     TDirectory::TContext ctxt(TDirectory::CurrentDirectory());
     if ( !gSystem->AccessPathName(fname.c_str()) )  {
       gSystem->Unlink(fname.c_str());
@@ -141,68 +425,22 @@ void Geant4Output2ROOT::beginRun(const G4Run* run) {
 
 /// Fill single EVENT branch entry (Geant4 collection data)
 int Geant4Output2ROOT::fill(const std::string& nam, const ComponentCast& type, void* ptr) {
+  if ( s_eventBuffer ) return s_eventBuffer->fill(nam, type, ptr);
   std::lock_guard<std::mutex> lock(s_rootMutex);
   if (!m_file) return 0;
-  TBranch* b = nullptr;
-  auto i = m_branches.find(nam);
-  if (i == m_branches.end()) {
-    const std::type_info& typ = type.type();
-    if (auto* cl = TBuffer::GetClass(typ)) {
-      b = m_tree->Branch(nam.c_str(), cl->GetName(), static_cast<void*>(nullptr));
-      b->SetAutoDelete(false);
-      m_branches.emplace(nam, b);
-    }
-    else {
-      throw std::runtime_error("No ROOT TClass object available for object type:" + typeName(typ));
-    }
-  }
-  else {
-    b = i->second;
-  }
-  const Long64_t evt  = b->GetEntries();
-  const Long64_t nevt = b->GetTree()->GetEntries();
-  if (nevt > evt) {
-    b->SetAddress(nullptr);
-    for (Long64_t num = nevt - evt; num > 0; --num)
-      b->Fill();
-  }
-  b->SetAddress(&ptr);
-  const int nbytes = b->Fill();
-  if (nbytes < 0) {
-    throw std::runtime_error("Failed to write ROOT collection:" + nam + "!");
-  }
-  return nbytes;
+  return fill_branch(m_tree, m_branches, nam, type, ptr);
 }
 
 /// Commit data at end of filling procedure
 void Geant4Output2ROOT::commit(OutputContext<G4Event>& ctxt) {
-  std::lock_guard<std::mutex> lock(s_rootMutex);
-  if (m_file) {
-    Int_t evtid = ctxt.context->GetEventID();
-    TTree* id_tree = section("G4EventIDs");
-    TBranch* br = id_tree->GetBranch("G4EventID");
-    if (!br) {
-      br = id_tree->Branch("G4EventID", &evtid, "G4EventID/I");
-    }
-    else {
-      br->SetAddress(&evtid);
-    }
-    id_tree->Fill();
-
-    auto* a = m_tree->GetListOfBranches();
-    const Long64_t evt = m_tree->GetEntries() + 1;
-    const Int_t nb = a->GetEntriesFast();
-    /// Fill NULL pointers to all branches, which have less entries than the Event branch
-    for (Int_t i = 0; i < nb; ++i) {
-      auto* br_ptr = static_cast<TBranch*>(a->UncheckedAt(i));
-      const Long64_t br_evt = br_ptr->GetEntries();
-      if (br_evt < evt) {
-        br_ptr->SetAddress(nullptr);
-        for (Long64_t num = evt - br_evt; num > 0; --num)
-          br_ptr->Fill();
-      }
+  if ( s_eventBuffer )   {
+    s_eventBuffer->commit(ctxt.context->GetEventID());
+  }
+  else  {
+    std::lock_guard<std::mutex> lock(s_rootMutex);
+    if (m_file) {
+      commit_event(m_tree, section("G4EventIDs"), ctxt.context->GetEventID());
     }
-    m_tree->SetEntries(evt);
   }
   Geant4OutputAction::commit(ctxt);
 }
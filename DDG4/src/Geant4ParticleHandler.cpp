@@ -108,7 +108,8 @@ bool Geant4ParticleHandler::adopt(Geant4Action* action)    {
 
 /// Clear particle maps
 void Geant4ParticleHandler::clear()  {
-  detail::releaseObjects(m_particleMap);
+  for( const auto& part : m_particleMap )
+    part.second->release();
   m_particleMap.clear();
   // m_suspendedPM should already be empty and cleared...
   assert(m_suspendedPM.empty() && "There was something wrong with the particle record treatment, please open a bug report!");
@@ -220,13 +221,12 @@ void Geant4ParticleHandler::begin(const G4Track* track)   {
   // if particles are not tracked to the end, we pick up where we stopped previously
   if ( m_haveSuspended )  {
     // primary particles are already in the particle map, we don't have to store them in another map
-    auto existingParticle = m_particleMap.find(h.id());
-    if ( existingParticle != m_particleMap.end() )  {
-      m_currTrack.get_data(*(existingParticle->second));
+    if ( Particle* existing = m_particleMap.get(h.id()) )  {
+      m_currTrack.get_data(*existing);
       return;
     }
     //other particles might not be in the particleMap yet, so we take them from here
-    existingParticle = m_suspendedPM.find(h.id());
+    auto existingParticle = m_suspendedPM.find(h.id());
     if ( existingParticle != m_suspendedPM.end() ) {
       m_currTrack.get_data(*(existingParticle->second));
       // make sure we delete a suspended particle in the map, fill it back later...
@@ -242,7 +242,7 @@ void Geant4ParticleHandler::begin(const G4Track* track)   {
       except("+++ Tracking preaction: Primary particle without generator particle!");
     }
     reason |= (G4PARTICLE_PRIMARY|G4PARTICLE_ABOVE_ENERGY_THRESHOLD);
-    m_particleMap[h.id()] = prim_part->addRef();
+    m_particleMap.set(h.id(), prim_part->addRef());
   }
 
   if ( prim_part )   {
@@ -398,19 +398,20 @@ void Geant4ParticleHandler::end(const G4Track* track)   {
   Geant4ParticleInformation* track_info =
     dynamic_cast<Geant4ParticleInformation*>(track->GetUserInformation());
   if( !mask.isNull() || track_info || reason_mask.isSet(G4PARTICLE_SIM_BACKSCATTER) )  {
-    m_equivalentTracks[g4_id] = g4_id;
-    ParticleMap::iterator ip = m_particleMap.find(g4_id);
+    m_equivalentTracks.set(g4_id, g4_id);
+    Particle* part = m_particleMap.get(g4_id);
     if( mask.isSet(G4PARTICLE_PRIMARY) )  {
-      ph.dump2(outputLevel()-1,name(),"Add Primary", h.id(), ip != m_particleMap.end());
+      ph.dump2(outputLevel()-1,name(),"Add Primary", h.id(), part != nullptr);
     }
     if( reason_mask.isSet(G4PARTICLE_SIM_BACKSCATTER) )  {
       mask.set(G4PARTICLE_KEEP_ALWAYS);
       info("+++ Track: %6d Particle back-scattering to tracker --> keep particle in MC history.", g4_id);
     }
     // Create a new MC particle from the current track information saved in the pre-tracking action
-    Particle* part = 0;
-    if( ip==m_particleMap.end() ) part = m_particleMap[g4_id] = new Particle();
-    else part = (*ip).second;
+    if( !part )  {
+      part = new Particle();
+      m_particleMap.set(g4_id, part);
+    }
     if( track_info )  {
       mask.set(G4PARTICLE_KEEP_USER);
       part->extension.reset(track_info->release());
@@ -423,17 +424,16 @@ void Geant4ParticleHandler::end(const G4Track* track)   {
     // We will not store them on the record, but have to memorise the
     // track identifier in order to restore the history for the created hits.
     int pid = m_currTrack.g4Parent;
-    m_equivalentTracks[g4_id] = pid;
+    m_equivalentTracks.set(g4_id, pid);
     // Need to find the last stored particle and OR this particle's mask
     // with the mask of the last stored particle
-    auto iend = m_equivalentTracks.end(), iequiv=m_equivalentTracks.end();
-    ParticleMap::iterator ip;
-    for(ip=m_particleMap.find(pid); ip == m_particleMap.end(); ip=m_particleMap.find(pid))  {
-      if (iequiv=m_equivalentTracks.find(pid); iequiv == iend) break;  // ERROR
-      pid = (*iequiv).second;
-    }
-    if ( ip != m_particleMap.end() )
-      (*ip).second->reason |= track_reason;
+    Particle* parent = m_particleMap.get(pid);
+    while( !parent )  {
+      if ( (pid = m_equivalentTracks.get(pid)) < 0 ) break;  // ERROR
+      parent = m_particleMap.get(pid);
+    }
+    if ( parent )
+      parent->reason |= track_reason;
     else
       ph.dumpWithVertex(outputLevel()+3,name(),"FATAL: No real particle parent present");
   }
@@ -441,7 +441,7 @@ void Geant4ParticleHandler::end(const G4Track* track)   {
   if( track->GetTrackStatus() == fSuspend ) {
     m_haveSuspended = true;
     //track is already in particle map, we pick it up from there in begin again
-    if(m_particleMap.find(g4_id) != m_particleMap.end()) return;
+    if( m_particleMap.contains(g4_id) ) return;
     //track is not already stored, keep it in special map
     auto iPart = m_suspendedPM.emplace(g4_id, new Particle());
     (iPart.first->second)->get_data(m_currTrack);
@@ -467,8 +467,8 @@ void Geant4ParticleHandler::beginEvent(const G4Event* event)  {
 void Geant4ParticleHandler::dumpMap(const char* tag)  const  {
   const std::string& n = name();
   Geant4ParticleHandle::header4(INFO,n,tag);
-  for(ParticleMap::const_iterator iend=m_particleMap.end(), i=m_particleMap.begin(); i!=iend; ++i)  {
-    Geant4ParticleHandle((*i).second).dump4(INFO,n,tag);
+  for( const auto& part : m_particleMap )  {
+    Geant4ParticleHandle(part.second).dump4(INFO,n,tag);
   }
 }
 
@@ -492,9 +492,15 @@ void Geant4ParticleHandler::endEvent(const G4Event* event)  {
     h->end(event);
   setVertexEndpointBit();
 
-  // Now export the data to the final record.
+  // Now export the data to the final record. The ownership of the particles is passed.
+  ParticleMap      particles;
+  TrackEquivalents equivalents;
+  m_particleMap.copyTo(particles);
+  m_equivalentTracks.copyTo(equivalents);
+  m_particleMap.clear();
+  m_equivalentTracks.clear();
   Geant4ParticleMap* part_map = context()->event().extension<Geant4ParticleMap>();
-  part_map->adopt(m_particleMap, m_equivalentTracks);
+  part_map->adopt(particles, equivalents);
   m_primaryMap = 0;
   clear();
 }
@@ -502,50 +508,53 @@ void Geant4ParticleHandler::endEvent(const G4Event* event)  {
 /// Rebase the simulated tracks, so that they fit to the generator particles
 void Geant4ParticleHandler::rebaseSimulatedTracks(int )   {
   /// No we have to update the map of equivalent tracks and assign the 'equivalentTrack' entry
-  TrackEquivalents equivalents, orgParticles;
-  ParticleMap      finalParticles;
-  ParticleMap::const_iterator ipar, iend, i;
-  int count;
+  EquivalentStore equivalents;
+  ParticleStore   finalParticles;
+  int count = 0;
 
   Geant4PrimaryInteraction* interaction = context()->event().extension<Geant4PrimaryInteraction>();
   ParticleMap& pm = interaction->particles;
 
   // (1.0) Copy the pre-defined particle mapping for the simulated tracks
   //       It is assumed the mapping is ZERO based without holes.
-  for(count = 0, iend=pm.end(), i=pm.begin(); i!=iend; ++i)  {
-    Particle* p = (*i).second;
-    orgParticles[p->id] = p->id;
-    finalParticles[p->id] = p;
+  for( const auto& i : pm )  {
+    Particle* p = i.second;
+    finalParticles.set(p->id, p);
     if ( p->id > count ) count = p->id;
     if ( (p->reason&G4PARTICLE_PRIMARY) != G4PARTICLE_PRIMARY )  {
       p->addRef();
     }
   }
   // (1.1) Define the new particle mapping for the simulated tracks
-  for(++count, iend=m_particleMap.end(), i=m_particleMap.begin(); i!=iend; ++i)  {
-    Particle* p = (*i).second;
+  ++count;
+  for( const auto& i : m_particleMap )  {
+    Particle* p = i.second;
     if ( (p->reason&G4PARTICLE_PRIMARY) != G4PARTICLE_PRIMARY )  {
-      //if ( orgParticles.find(p->id) == orgParticles.end() )  {
-      orgParticles[p->id] = count;
-      finalParticles[count] = p;
+      finalParticles.set(count, p);
       p->id = count;
       ++count;
     }
   }
-  // (2) Re-evaluate the corresponding geant4 track equivalents using the new mapping
-  for(TrackEquivalents::iterator ie=m_equivalentTracks.begin(),ie_end=m_equivalentTracks.end(); ie!=ie_end; ++ie)  {
-    int g4_equiv = (*ie).first;
-    while( (ipar=m_particleMap.find(g4_equiv)) == m_particleMap.end() )  {
-      TrackEquivalents::const_iterator iequiv = m_equivalentTracks.find(g4_equiv);
-      if ( iequiv == ie_end )  {
-        break;  // ERROR !! Will be handled by printout below because ipar==end()
+  // (2) Re-evaluate the corresponding geant4 track equivalents using the new mapping.
+  //     Geant4 parents have smaller track identifiers than their daughters. Hence the
+  //     resolution of the parent is known when the daughter is processed: linear complexity.
+  std::vector<int> resolved(m_equivalentTracks.limit(), -1);
+  for( const auto& ie : m_equivalentTracks )  {
+    int g4_equiv = ie.first;
+    Particle* par = m_particleMap.get(g4_equiv);
+    while( !par )  {
+      int next = m_equivalentTracks.get(g4_equiv);
+      if ( next < 0 )  {
+        break;  // ERROR !! Will be handled by printout below because par==nullptr
       }
-      g4_equiv = (*iequiv).second;
-    }
-    TrackEquivalents::mapped_type equiv = (*ie).second;
-    if ( ipar != m_particleMap.end() )   {
-      Geant4ParticleHandle p = (*ipar).second;
-      equivalents[(*ie).first] = p->id;  // requires (1) to be filled properly!
+      g4_equiv = (next < ie.first && resolved[next] >= 0) ? resolved[next] : next;
+      par = m_particleMap.get(g4_equiv);
+    }
+    int equiv = ie.second;
+    if ( par )   {
+      Geant4ParticleHandle p = par;
+      resolved[ie.first] = g4_equiv;
+      equivalents.set(ie.first, p->id);  // requires (1) to be filled properly!
       const G4ParticleDefinition* def = p.definition();
       int pdg = int(std::abs(def->GetPDGEncoding())+0.1);
       if ( pdg != 0 && pdg<36 && !(pdg > 10 && pdg < 17) && pdg != 22 )  {
@@ -568,15 +577,12 @@ void Geant4ParticleHandler::rebaseSimulatedTracks(int )   {
   //     We rely here on the ordering of the particles accoding to their
   //     Processing by Geant4 to establish mother daughter relationships.
   //     == > use finalParticles map and NOT m_particleMap.
-  int equiv_id = -1;
-  for( auto& part : finalParticles )  {
-    auto& p = part.second;
+  for( const auto& part : finalParticles )  {
+    Particle* p = part.second;
     if ( p->g4Parent > 0 )  {
-      TrackEquivalents::iterator iequ = equivalents.find(p->g4Parent);
-      if ( iequ != equivalents.end() )  {
-        equiv_id = (*iequ).second;//equivalents[p->g4Parent];
-        if ( (ipar=finalParticles.find(equiv_id)) != finalParticles.end() )  {
-          Particle* q = (*ipar).second;
+      int equiv_id = equivalents.get(p->g4Parent);
+      if ( equiv_id >= 0 )  {
+        if ( Particle* q = finalParticles.get(equiv_id) )  {
           bool      prim = (p->reason&G4PARTICLE_PRIMARY) == G4PARTICLE_PRIMARY;
           // We assume that the mother daughter relationship
           // is filled by the event readers!
@@ -601,28 +607,6 @@ void Geant4ParticleHandler::rebaseSimulatedTracks(int )   {
             p->g4Parent,p->id);
     }
   }
-#if 0
-  for(iend=finalParticles.end(), i=finalParticles.begin(); i!=iend; ++i)  {
-    Particle* p = (*i).second;
-    if ( p->g4Parent > 0 )  {
-      int parent_id = (*p->parents.begin());
-      if ( (ipar=finalParticles.find(parent_id)) != finalParticles.end() )  {
-        Particle* q = (*ipar).second;
-        // Generator particles have a proper history.
-        // We only deal with particles, which are not of MC origin.
-        //p->parents.insert(q->id);
-        if ( parent_id == q->id )
-          q->daughters.insert(p->id);
-        else
-          error("+++ Inconsistency in equivalent record! Parent: %d Daughter:%d",q->id, p->id);
-        continue;
-      }
-      error("+++ Inconsistency in particle record: Geant4 parent %d "
-            "of particle %d not in record of final particles!",
-            p->g4Parent,p->id);
-    }
-  }
-#endif
   m_equivalentTracks = std::move(equivalents);
   m_particleMap = std::move(finalParticles);
 }
@@ -662,11 +646,12 @@ bool Geant4ParticleHandler::defaultDropParticle(const Particle& particle)   {
 /// Clean the monte carlo record. Remove all unwanted stuff.
 /// This is the core of the object executed at the end of each event action.
 int Geant4ParticleHandler::recombineParents()  {
-  std::set<int> remove;
+  std::vector<int> remove;
 
   /// Need to start from BACK, to clean first the latest produced stuff.
-  for(ParticleMap::reverse_iterator i=m_particleMap.rbegin(); i!=m_particleMap.rend(); ++i)  {
-    Particle* p = (*i).second;
+  for( int g4_id = m_particleMap.limit()-1; g4_id >= 0; --g4_id )  {
+    Particle* p = m_particleMap.get(g4_id);
+    if ( !p ) continue;
     PropertyMask mask(p->reason);
     // Allow the user to force the particle handling either by
     // or the reason mask with G4PARTICLE_KEEP_USER or
@@ -704,8 +689,7 @@ int Geant4ParticleHandler::recombineParents()  {
       //continue;
     }
     else if ( mask.isSet(G4PARTICLE_KEEP_PROCESS) )  {
-      if(ParticleMap::iterator ip = m_particleMap.find(p->g4Parent); ip != m_particleMap.end() )   {
-        Particle* parent_part = (*ip).second;
+      if( Particle* parent_part = m_particleMap.get(p->g4Parent) )   {
         PropertyMask parent_mask(parent_part->reason);
         if ( parent_mask.isSet(G4PARTICLE_ABOVE_ENERGY_THRESHOLD) )   {
           parent_mask.set(G4PARTICLE_KEEP_PARENT);
@@ -718,11 +702,9 @@ int Geant4ParticleHandler::recombineParents()  {
 
     /// Remove this track from the list and also do the cleanup in the parent's children list
     if ( remove_me )  {
-      int g4_id = (*i).first;
-      remove.insert(g4_id);
-      m_equivalentTracks[g4_id] = p->g4Parent;
-      if(ParticleMap::iterator ip = m_particleMap.find(p->g4Parent); ip != m_particleMap.end() )   {
-        Particle* parent_part = (*ip).second;
+      remove.emplace_back(g4_id);
+      m_equivalentTracks.set(g4_id, p->g4Parent);
+      if( Particle* parent_part = m_particleMap.get(p->g4Parent) )   {
         PropertyMask(parent_part->reason).set(mask.value());
         parent_part->steps += p->steps;
         parent_part->secondaries += p->secondaries;
@@ -733,10 +715,8 @@ int Geant4ParticleHandler::recombineParents()  {
     }
   }
   for( int r : remove )  {
-    if( auto ir = m_particleMap.find(r); ir != m_particleMap.end() )  {
-      (*ir).second->release();
-      m_particleMap.erase(ir);
-    }
+    if( Particle* p = m_particleMap.erase(r) )
+      p->release();
   }
   return int(remove.size());
 }
@@ -752,10 +732,9 @@ void Geant4ParticleHandler::checkConsistency()  const   {
     PropertyMask mask(p->reason);
     PropertyMask status(p->status);
     std::set<int>& daughters = p->daughters;
-    ParticleMap::const_iterator j;
     // For all particles, the set of daughters must be contained in the record.
     for( int id_dau : daughters )   {
-      if ( j=m_particleMap.find(id_dau); j == m_particleMap.end() )   {
+      if ( !m_particleMap.contains(id_dau) )   {
         ++num_errors;
         error("+++ Particle:%d Daughter %d is not in particle map!",p->id,id_dau);
       }
@@ -765,9 +744,9 @@ void Geant4ParticleHandler::checkConsistency()  const   {
     if ( !mask.isSet(G4PARTICLE_PRIMARY) && !status.anySet(G4PARTICLE_GEN_STATUS) )  {
       bool in_map = false, in_parent_list = false;
       int  parent_id = -1;
-      if( auto eq_it=m_equivalentTracks.find(p->g4Parent); eq_it != m_equivalentTracks.end() )   {
-        parent_id = (*eq_it).second;
-        in_map    = (j=m_particleMap.find(parent_id)) != m_particleMap.end();
+      if( m_equivalentTracks.contains(p->g4Parent) )   {
+        parent_id = m_equivalentTracks.get(p->g4Parent);
+        in_map    = m_particleMap.contains(parent_id);
         in_parent_list = p->parents.find(parent_id) != p->parents.end();
       }
       if ( !in_map || !in_parent_list )  {
@@ -789,7 +768,7 @@ void Geant4ParticleHandler::checkConsistency()  const   {
 }
 
 void Geant4ParticleHandler::setVertexEndpointBit() {
-  for( auto& part : m_particleMap )   {
+  for( const auto& part : m_particleMap )   {
     auto* p = part.second;
     if( !p->parents.empty() ) {
       PropertyMask mask(p->status);
@@ -803,7 +782,8 @@ void Geant4ParticleHandler::setVertexEndpointBit() {
                          |G4PARTICLE_SIM_STOPPED)) {
         continue;
       }
-      Geant4Particle *parent(m_particleMap[ *p->parents.begin() ]);
+      Geant4Particle *parent = m_particleMap.get(*p->parents.begin());
+      if( !parent ) continue;
       const double X( parent->vex - p->vsx );
       const double Y( parent->vey - p->vsy );
       const double Z( parent->vez - p->vsz );
@@ -250,7 +250,7 @@ namespace dd4hep {
       return new G4GenericTrap(sh->GetName(), sh->GetDz() * CM_2_MM, vertices);
     }
 
-    template <> G4VSolid* convertShape<TGeoTessellated>(const TGeoShape* shape)  {
+    G4TessellatedSolid* convertTessellatedShape(const TGeoShape* shape, bool close)  {
       TGeoTessellated*   sh  = (TGeoTessellated*) shape;
       G4TessellatedSolid* g4 = new G4TessellatedSolid(sh->GetName());
       int num_facet = sh->GetNfacets();
@@ -293,9 +293,15 @@ namespace dd4hep {
         }
         g4->AddFacet(g4f);
       }
-      g4->SetSolidClosed(sh->IsClosedBody());
+      if ( close )  {
+        g4->SetSolidClosed(sh->IsClosedBody());
+      }
       return g4;
     }
+
+    template <> G4VSolid* convertShape<TGeoTessellated>(const TGeoShape* shape)  {
+      return convertTessellatedShape(shape, true);
+    }
     
   }    // End namespace sim
 }      // End namespace dd4hep
@@ -20,6 +20,7 @@
 // Forward declarations
 class TGeoShape;
 class G4VSolid;
+class G4TessellatedSolid;
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -30,6 +31,9 @@ namespace dd4hep {
     /// Convert a specific TGeo shape into the geant4 equivalent
     template <typename T> G4VSolid* convertShape(const TGeoShape* shape);
 
+    /// Convert a tessellated TGeo shape. Closing the solid (vertex merging, voxelization) may be deferred
+    G4TessellatedSolid* convertTessellatedShape(const TGeoShape* shape, bool close);
+
   }    // End namespace sim
 }      // End namespace dd4hep
 #endif // DDG4_SRC_GEANT4SHAPECONVERTER_H
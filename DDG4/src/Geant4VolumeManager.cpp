@@ -29,6 +29,7 @@
 
 // C/C++ include files
 #include <set>
+#include <cstring>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -317,6 +318,7 @@ Geant4VolumeManager::Geant4VolumeManager(const Detector& description, Geant4Geom
       Populator p(description, *info, debug);
       printout( ALWAYS, "Geant4VolumeManager", "+++ Populating Geant4 volume manager.");
       p.populate(description.world());
+      info->g4PathTable.build(info->g4Paths);
       printout( ALWAYS, "Geant4VolumeManager",
                 "+++ Geant4 volume manager populated with %ld sensitive path entries.",
                 info->g4Paths.size() );
@@ -379,83 +381,142 @@ namespace  {
   }
 }
 
-/// Access CELLID by Geant4 touchable object
-VolumeID Geant4VolumeManager::volumeID(const G4VTouchable* touchable) const  {
-  Geant4TouchableHandler handler(touchable);
-  std::vector<const G4VPhysicalVolume*> path = handler.placementPath();
-  if( !isValid() )  {
-    printout(INFO, "Geant4VolumeManager", "+++   INVALID Geant4VolumeManager handle.");
-    return NonExisting;
-  }
-  else if( !ptr()->valid )  {
-    printout(INFO, "Geant4VolumeManager", "+++   INVALID Geant4VolumeManager [Not initialized]");
-    return NonExisting;
-  }
-  else if( path.empty() )  {
-    printout(INFO, "Geant4VolumeManager", "+++   EMPTY volume Geant4 Path: %s",
-             Geant4TouchableHandler::placementPath(path).c_str());
-    return NonExisting;
+namespace  {
+  /// Maximal depth of placement paths resolved without heap allocation
+  constexpr int MAX_PATH_DEPTH = 64;
+
+  /// Lookup the placement entry of a path hash
+  const Geant4GeometryInfo::Placement* lookup_path(const Geant4GeometryInfo* info, uint64_t hash)  {
+    if( !info->g4PathTable.empty() )  {
+      return info->g4PathTable.find(hash);
+    }
+    auto i = info->g4Paths.find(hash);
+    return i != info->g4Paths.end() ? &(*i).second : nullptr;
   }
-  else  {
-    uint64_t hash = detail::hash64(&path[0], sizeof(path[0])*path.size());
-    auto i = ptr()->g4Paths.find(hash);
-    if( i != ptr()->g4Paths.end() )  {
-      const auto& e = (*i).second;
-      VolumeID volid = e.volumeID;
-      /// No parametrization or replication.
-      if( e.flags == 0 )  {
-        return volid;
-      }
-      const auto& paramterised = ptr()->g4Parameterised;
-      const auto& replicated   = ptr()->g4Replicated;
-      /// This is incredibly slow .... but what can I do ? Need a better idea.
-      for( std::size_t j=0; j < path.size(); ++j )  {
-        const auto* phys = path[j];
-        if( phys->IsParameterised() )  {
-          int copy_no = touchable->GetCopyNumber(j);
-          const auto it = paramterised.find(phys);
-          if( it != paramterised.end() )  {
-            //printout(INFO,"Geant4VolumeManager",
-            //         "Copy number:   %ld  <--> %ld", copy_no, long(phys->GetCopyNo()));
-            const auto* field = (*it).second.data()->params->field;
-            volid |= IDDescriptor::encode(field, copy_no);
-            continue;
-          }
-          except("Geant4VolumeManager",
-                 "Error  Geant4VolumeManager::volumeID(const G4VTouchable* touchable)");
+
+  /// Add the copy numbers of parametrised and replicated placements to the volume ID
+  VolumeID resolve_copy_numbers(const Geant4GeometryInfo* info,
+                                const G4VTouchable* touchable,
+                                const G4VPhysicalVolume* const* path,
+                                int depth, VolumeID volid)  {
+    const auto& paramterised = info->g4Parameterised;
+    const auto& replicated   = info->g4Replicated;
+    /// This is incredibly slow .... but what can I do ? Need a better idea.
+    for( int j=0; j < depth; ++j )  {
+      const auto* phys = path[j];
+      if( phys->IsParameterised() )  {
+        int copy_no = touchable->GetCopyNumber(j);
+        const auto it = paramterised.find(phys);
+        if( it != paramterised.end() )  {
+          //printout(INFO,"Geant4VolumeManager",
+          //         "Copy number:   %ld  <--> %ld", copy_no, long(phys->GetCopyNo()));
+          const auto* field = (*it).second.data()->params->field;
+          volid |= IDDescriptor::encode(field, copy_no);
+          continue;
         }
-        else if( phys->IsReplicated() )   {
-          int copy_no = touchable->GetCopyNumber(j);
-          const auto it = replicated.find(phys);
-          if( it != replicated.end() )  {
-            const auto* field = (*it).second.data()->params->field;
-            volid |= IDDescriptor::encode(field, copy_no);
-            continue;
-          }
-          except("Geant4VolumeManager",
-                 "Error  Geant4VolumeManager::volumeID(const G4VTouchable* touchable)");
+        except("Geant4VolumeManager",
+               "Error  Geant4VolumeManager::volumeID(const G4VTouchable* touchable)");
+      }
+      else if( phys->IsReplicated() )   {
+        int copy_no = touchable->GetCopyNumber(j);
+        const auto it = replicated.find(phys);
+        if( it != replicated.end() )  {
+          const auto* field = (*it).second.data()->params->field;
+          volid |= IDDescriptor::encode(field, copy_no);
+          continue;
         }
+        except("Geant4VolumeManager",
+               "Error  Geant4VolumeManager::volumeID(const G4VTouchable* touchable)");
       }
-      return volid;
     }
+    return volid;
+  }
+
+  /// Diagnose a placement path without volume manager entry
+  VolumeID bad_path(const Geant4VolumeManager* mgr, const std::vector<const G4VPhysicalVolume*>& path)  {
     if( !path[0] )  {
       printout(INFO, "Geant4VolumeManager", "+++   Bad Geant4 volume path: \'%s\' [invalid path] %s",
-               Geant4TouchableHandler::placementPath(path).c_str(), debug_status(this).c_str());
-      return InvalidPath;
+               Geant4TouchableHandler::placementPath(path).c_str(), debug_status(mgr).c_str());
+      return Geant4VolumeManager::InvalidPath;
     }
     else if( !path[0]->GetLogicalVolume()->GetSensitiveDetector() )  {
       printout(DEBUG, "Geant4VolumeManager", "+++   Bad Geant4 volume path: \'%s\' [insensitive] %s",
-               Geant4TouchableHandler::placementPath(path).c_str(), debug_status(this).c_str());
-      return Insensitive;
+               Geant4TouchableHandler::placementPath(path).c_str(), debug_status(mgr).c_str());
+      return Geant4VolumeManager::Insensitive;
     }
     printout(INFO, "Geant4VolumeManager",
              "+++   Bad Geant4 volume path: \'%s\' [missing entry] %s",
-             Geant4TouchableHandler::placementPath(path).c_str(), debug_status(this).c_str());
+             Geant4TouchableHandler::placementPath(path).c_str(), debug_status(mgr).c_str());
+    return Geant4VolumeManager::NonExisting;
+  }
+
+  /// Resolve the volume ID of a placement path
+  VolumeID path_volume_id(const Geant4VolumeManager* mgr, const G4VTouchable* touchable,
+                          const G4VPhysicalVolume* const* path, int depth)  {
+    uint64_t hash = detail::hash64(path, depth*sizeof(path[0]));
+    const Geant4GeometryInfo::Placement* e = lookup_path(mgr->ptr(), hash);
+    if( e )  {
+      /// No parametrization or replication.
+      if( e->flags == 0 )  {
+        return e->volumeID;
+      }
+      return resolve_copy_numbers(mgr->ptr(), touchable, path, depth, e->volumeID);
+    }
+    return bad_path(mgr, std::vector<const G4VPhysicalVolume*>(path, path+depth));
+  }
+}
+
+/// Access CELLID by Geant4 touchable object
+VolumeID Geant4VolumeManager::volumeID(const G4VTouchable* touchable) const  {
+  /// Last resolved path of this thread: consecutive steps mostly stay in the same cell
+  struct LastHit  {
+    const Geant4GeometryInfo* info  { nullptr };
+    int                       depth { 0 };
+    VolumeID                  volid { 0 };
+    const G4VPhysicalVolume*  path[MAX_PATH_DEPTH];
+  };
+  static thread_local LastHit last;
+  int depth = touchable ? touchable->GetHistoryDepth() : 0;
+
+  if( !isValid() )  {
+    printout(INFO, "Geant4VolumeManager", "+++   INVALID Geant4VolumeManager handle.");
     return NonExisting;
   }
-  printout(INFO, "Geant4VolumeManager", "+++   Bad Geant4 volume path: \'%s\' %s",
-           Geant4TouchableHandler::placementPath(path).c_str(), yes_no(path.empty()));
-  return NonExisting;
+  else if( !ptr()->valid )  {
+    printout(INFO, "Geant4VolumeManager", "+++   INVALID Geant4VolumeManager [Not initialized]");
+    return NonExisting;
+  }
+  else if( depth <= 0 )  {
+    printout(INFO, "Geant4VolumeManager", "+++   EMPTY volume Geant4 Path: %s", "");
+    return NonExisting;
+  }
+  else if( depth > MAX_PATH_DEPTH )  {
+    std::vector<const G4VPhysicalVolume*> path = placementPath(touchable);
+    return path_volume_id(this, touchable, &path[0], depth);
+  }
+  /// Allocation free path walk over a stack buffer
+  const G4VPhysicalVolume* path[MAX_PATH_DEPTH];
+  for( int i = 0; i < depth; ++i )
+    path[i] = touchable->GetVolume(i);
+
+  const std::size_t len = depth*sizeof(path[0]);
+  if( last.info == ptr() && last.depth == depth && 0 == ::memcmp(last.path, path, len) )  {
+    return last.volid;
+  }
+  uint64_t hash = detail::hash64(path, len);
+  const Geant4GeometryInfo::Placement* e = lookup_path(ptr(), hash);
+  if( e && e->flags == 0 )  {
+    /// No parametrization or replication: remember the result for the next step
+    last.info  = ptr();
+    last.depth = depth;
+    last.volid = e->volumeID;
+    ::memcpy(last.path, path, len);
+    return e->volumeID;
+  }
+  else if( e )  {
+    return resolve_copy_numbers(ptr(), touchable, path, depth, e->volumeID);
+  }
+  return bad_path(this, std::vector<const G4VPhysicalVolume*>(path, path+depth));
 }
 
 /// Access fully decoded volume fields  by placement path
@@ -466,9 +527,9 @@ void Geant4VolumeManager::volumeDescriptor(const std::vector<const G4VPhysicalVo
   vol_desc.first = NonExisting;
   if( !path.empty() && checkValidity() )  {
     auto hash = detail::hash64(&path[0], sizeof(path[0])*path.size());
-    auto i = ptr()->g4Paths.find(hash);
-    if( i != ptr()->g4Paths.end() )  {
-      VolumeID vid = (*i).second.volumeID;
+    const auto* entry = lookup_path(ptr(), hash);
+    if( entry )  {
+      VolumeID vid = entry->volumeID;
       G4LogicalVolume* lvol = path[0]->GetLogicalVolume();
       if( lvol->GetSensitiveDetector() ) {
         const auto* node = path[0];
@@ -17,6 +17,7 @@
 #include <stack>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 // Disable some diagnostics, which we know, but need to ignore
 #if defined(__GNUC__) && !defined(__APPLE__) && !defined(__llvm__)
@@ -65,6 +66,19 @@ namespace  {
     FCN(double (*f)(double,double,double,double)) { f4 = f; }
     FCN(double (*f)(double,double,double,double,double)) { f5 = f; }
   };
+
+  /// Internal expression evaluator helper class: instruction of a compiled expression
+  /** Variables and functions refer to their dictionary entries. These are looked up
+   *  when the instruction is executed: redefinitions are picked up without recompilation.
+   */
+  struct Instruction {
+    int         code;           // Operator token or one of OP_VALUE, OP_VARIABLE, OP_FUNCTION
+    int         npar;           // Number of function parameters
+    double      value;          // Constant value
+    const Item* item;           // Dictionary entry of the variable or function
+  };
+  /// Compiled expression: instructions of a stack machine in the order of the evaluation
+  typedef std::vector<Instruction> Program;
 }
 
 //typedef char * pchar;
@@ -109,6 +123,9 @@ struct EVAL::Object::Struct {
   };
 
   dic_type    theDictionary;
+  /// Cache of compiled expressions. Entries refer to dictionary entries and must be
+  /// dropped whenever entries are removed from the dictionary.
+  std::unordered_map<std::string,Program> theCache;
   int theReadersWaiting = 0;
   bool theWriterWaiting = false;
   std::condition_variable theCond;
@@ -134,7 +151,13 @@ static constexpr char sss[MAX_N_PAR+2] = "012345";
 enum { ENDL, LBRA, OR, AND, EQ, NE, GE, GT, LE, LT,
        PLUS, MINUS, MULT, DIV, POW, RBRA, VALUE };
 
-static int engine(char const*, char const*, double &, char const* &, const dic_type &);
+/// Instruction codes of compiled expressions besides the operators
+enum { OP_VALUE = 100, OP_VARIABLE, OP_FUNCTION };
+
+/// Maximal number of cached expressions. The cache is flushed if exceeded
+static constexpr std::size_t MAX_CACHE_SIZE = 1000000;
+
+static int engine(char const*, char const*, double &, char const* &, const dic_type &, Program* = nullptr);
 
 static int variable(const std::string & name, double & result,
                     const dic_type & dictionary)
@@ -174,6 +197,8 @@ static int variable(const std::string & name, double & result,
   }
 }
 
+static int call_function(const Item& item, int npar, const double* pp, double & result);
+
 static int execute_function(const std::string & name, std::stack<double> & par,
                     double & result, const dic_type & dictionary)
 /***********************************************************************
@@ -202,6 +227,23 @@ static int execute_function(const std::string & name, std::stack<double> & par,
 
   double pp[MAX_N_PAR];
   for(int i=0; i<npar; i++) { pp[i] = par.top(); par.pop(); }
+  return call_function(item, npar, pp, result);
+}
+
+static int call_function(const Item& item, int npar, const double* pp, double & result)
+/***********************************************************************
+ *                                                                     *
+ * Function: Calls the function of a dictionary entry.                 *
+ *           This function is used by execute_function() and execute().*
+ *                                                                     *
+ * Parameters:                                                         *
+ *   item   - dictionary entry of the function.                        *
+ *   npar   - number of parameters.                                    *
+ *   pp     - parameters in reverse order.                             *
+ *   result - value of the function.                                   *
+ *                                                                     *
+ ***********************************************************************/
+{
   errno = 0;
   if (item.function == 0)       return EVAL::ERROR_CALCULATION_ERROR;
   FCN fcn(item.function);
@@ -229,7 +271,7 @@ static int execute_function(const std::string & name, std::stack<double> & par,
 }
 
 static int operand(char const* begin, char const* end, double & result,
-                   char const* & endp, const dic_type & dictionary)
+                   char const* & endp, const dic_type & dictionary, Program* code)
 /***********************************************************************
  *                                                                     *
  * Name: operand                                     Date:    03.10.00 *
@@ -245,6 +287,7 @@ static int operand(char const* begin, char const* end, double & result,
  *   result - value of the operand.                                    *
  *   endp   - pointer to the character where the evaluation stoped.    *
  *   dictionary - dictionary of available variables and functions.     *
+ *   code   - if not null: the compiled instructions are appended.     *
  *                                                                     *
  ***********************************************************************/
 {
@@ -263,6 +306,7 @@ static int operand(char const* begin, char const* end, double & result,
 #endif
       result = strtod(pointer, (char **)(&pointer));
     if (errno == 0) {
+      if (code) code->push_back({OP_VALUE, 0, result, nullptr});
       EVAL_EXIT( EVAL::OK, --pointer );
     }else{
       EVAL_EXIT( EVAL::ERROR_CALCULATION_ERROR, begin );
@@ -284,6 +328,8 @@ static int operand(char const* begin, char const* end, double & result,
   SKIP_BLANKS;
   if (c != '(') {
     EVAL_STATUS = variable(name, result, dictionary);
+    if (code && EVAL_STATUS == EVAL::OK)
+      code->push_back({OP_VARIABLE, 0, 0.0, &dictionary.find(name)->second});
     EVAL_EXIT( EVAL_STATUS, (EVAL_STATUS == EVAL::OK) ? --pointer : begin);
   }
 
@@ -305,7 +351,7 @@ static int operand(char const* begin, char const* end, double & result,
     case ',':
       if (pos.size() == 1) {
         par_end = pointer-1;
-        EVAL_STATUS = engine(par_begin, par_end, value, par_end, dictionary);
+        EVAL_STATUS = engine(par_begin, par_end, value, par_end, dictionary, code);
         if (EVAL_STATUS == EVAL::WARNING_BLANK_STRING)
 	  { EVAL_EXIT( EVAL::ERROR_EMPTY_PARAMETER, --par_end ); }
         if (EVAL_STATUS != EVAL::OK)
@@ -320,7 +366,7 @@ static int operand(char const* begin, char const* end, double & result,
         break;
       }else{
         par_end = pointer-1;
-        EVAL_STATUS = engine(par_begin, par_end, value, par_end, dictionary);
+        EVAL_STATUS = engine(par_begin, par_end, value, par_end, dictionary, code);
         switch (EVAL_STATUS) {
         case EVAL::OK:
           par.push(value);
@@ -332,7 +378,10 @@ static int operand(char const* begin, char const* end, double & result,
         default:
           EVAL_EXIT( EVAL_STATUS, par_end );
         }
+        int npar = par.size();
         EVAL_STATUS = execute_function(name, par, result, dictionary);
+        if (code && EVAL_STATUS == EVAL::OK)
+          code->push_back({OP_FUNCTION, npar, 0.0, &dictionary.find(sss[npar]+name)->second});
         EVAL_EXIT( EVAL_STATUS, (EVAL_STATUS == EVAL::OK) ? pointer : begin);
       }
     }
@@ -353,52 +402,71 @@ static int operand(char const* begin, char const* end, double & result,
  *   val - stack of values.                                            *
  *                                                                     *
  ***********************************************************************/
+static int calculate(int op, double val1, double val2, double & result);
+
 static int maker(int op, std::stack<double> & val)
 {
   if (val.size() < 2) return EVAL::ERROR_SYNTAX_ERROR;
   double val2 = val.top(); val.pop();
   double val1 = val.top();
+  return calculate(op, val1, val2, val.top());
+}
+
+/***********************************************************************
+ *                                                                     *
+ * Function: Executes basic arithmetic operations on two values.       *
+ *           This function is used by maker() and execute().           *
+ *                                                                     *
+ * Parameters:                                                         *
+ *   op     - code of the operation.                                   *
+ *   val1   - first operand.                                           *
+ *   val2   - second operand.                                          *
+ *   result - result of the operation.                                 *
+ *                                                                     *
+ ***********************************************************************/
+static int calculate(int op, double val1, double val2, double & result)
+{
   switch (op) {
   case OR:                                // operator ||
-    val.top() = (val1 || val2) ? 1. : 0.;
+    result = (val1 || val2) ? 1. : 0.;
     return EVAL::OK;
   case AND:                               // operator &&
-    val.top() = (val1 && val2) ? 1. : 0.;
+    result = (val1 && val2) ? 1. : 0.;
     return EVAL::OK;
   case EQ:                                // operator ==
-    val.top() = (val1 == val2) ? 1. : 0.;
+    result = (val1 == val2) ? 1. : 0.;
     return EVAL::OK;
   case NE:                                // operator !=
-    val.top() = (val1 != val2) ? 1. : 0.;
+    result = (val1 != val2) ? 1. : 0.;
     return EVAL::OK;
   case GE:                                // operator >=
-    val.top() = (val1 >= val2) ? 1. : 0.;
+    result = (val1 >= val2) ? 1. : 0.;
     return EVAL::OK;
   case GT:                                // operator >
-    val.top() = (val1 >  val2) ? 1. : 0.;
+    result = (val1 >  val2) ? 1. : 0.;
     return EVAL::OK;
   case LE:                                // operator <=
-    val.top() = (val1 <= val2) ? 1. : 0.;
+    result = (val1 <= val2) ? 1. : 0.;
     return EVAL::OK;
   case LT:                                // operator <
-    val.top() = (val1 <  val2) ? 1. : 0.;
+    result = (val1 <  val2) ? 1. : 0.;
     return EVAL::OK;
   case PLUS:                              // operator '+'
-    val.top() = val1 + val2;
+    result = val1 + val2;
     return EVAL::OK;
   case MINUS:                             // operator '-'
-    val.top() = val1 - val2;
+    result = val1 - val2;
     return EVAL::OK;
   case MULT:                              // operator '*'
-    val.top() = val1 * val2;
+    result = val1 * val2;
     return EVAL::OK;
   case DIV:                               // operator '/'
     if (val2 == 0.0) return EVAL::ERROR_CALCULATION_ERROR;
-    val.top() = val1 / val2;
+    result = val1 / val2;
     return EVAL::OK;
   case POW:                               // operator '^' (or '**')
     errno = 0;
-    val.top() = pow(val1,val2);
+    result = pow(val1,val2);
     if (errno == 0) return EVAL::OK;
     [[fallthrough]];
   default:
@@ -420,10 +488,11 @@ static int maker(int op, std::stack<double> & val)
  *   result - result of the evaluation.                                *
  *   endp   - pointer to the character where the evaluation stoped.    *
  *   dictionary - dictionary of available variables and functions.     *
+ *   code   - if not null: the compiled instructions are appended.     *
  *                                                                     *
  ***********************************************************************/
 static int engine(char const* begin, char const* end, double & result,
-                  char const*& endp, const dic_type & dictionary)
+                  char const*& endp, const dic_type & dictionary, Program* code)
 {
   static constexpr int SyntaxTable[17][17] = {
     //E  (  || && == != >= >  <= <  +  -  *  /  ^  )  V - current token
@@ -538,12 +607,13 @@ static int engine(char const* begin, char const* end, double & result,
     case 0:                             // syntax error
       EVAL_EXIT( EVAL::ERROR_SYNTAX_ERROR, pointer );
     case 1:                             // operand: number, variable, function
-      EVAL_STATUS = operand(pointer, end, value, pointer, dictionary);
+      EVAL_STATUS = operand(pointer, end, value, pointer, dictionary, code);
       if (EVAL_STATUS != EVAL::OK) { EVAL_EXIT( EVAL_STATUS, pointer ); }
       val.push(value);
       continue;
     case 2:                             // unary + or unary -
       val.push(0.0);
+      if (code) code->push_back({OP_VALUE, 0, 0.0, nullptr});
     case 3: default:                    // next operator
       break;
     }
@@ -572,6 +642,7 @@ static int engine(char const* begin, char const* end, double & result,
         if (EVAL_STATUS != EVAL::OK) {
           EVAL_EXIT( EVAL_STATUS, pos.top() );
         }
+        if (code) code->push_back({iTop, 0, 0.0, nullptr});
         op.top() = iCur; pos.top() = pointer;
         break;
       case 3:                           // delete '(' from stack
@@ -582,6 +653,7 @@ static int engine(char const* begin, char const* end, double & result,
         if (EVAL_STATUS != EVAL::OK) {  // repete with the same iCur
           EVAL_EXIT( EVAL_STATUS, pos.top() );
         }
+        if (code) code->push_back({iTop, 0, 0.0, nullptr});
         op.pop(); pos.pop();
         continue;
       }
@@ -590,6 +662,108 @@ static int engine(char const* begin, char const* end, double & result,
   }
 }
 
+//---------------------------------------------------------------------------
+static int evaluate_cached(char const* expression, double & result,
+                           char const* & endp, EVAL::Object::Struct* imp);
+
+static int execute(const Program& code, double & result, EVAL::Object::Struct* imp)
+/***********************************************************************
+ *                                                                     *
+ * Function: Executes a compiled expression. The operations are the    *
+ *           same and in the same order as in engine(): the result is  *
+ *           identical. Errors are not analysed: the caller must       *
+ *           re-evaluate the expression with engine().                 *
+ *                                                                     *
+ * Parameters:                                                         *
+ *   code   - compiled expression.                                     *
+ *   result - result of the evaluation.                                *
+ *   imp    - evaluator data: dictionary and expression cache.         *
+ *                                                                     *
+ ***********************************************************************/
+{
+  double  buffer[64];
+  std::vector<double> heap;
+  double* val = buffer;                 // value stack
+  int     top = -1;                     // top of the value stack
+  if (code.size() > sizeof(buffer)/sizeof(buffer[0])) {
+    heap.resize(code.size());
+    val = heap.data();
+  }
+  for (const Instruction& ins : code) {
+    switch (ins.code) {
+    case OP_VALUE:
+      val[++top] = ins.value;
+      break;
+    case OP_VARIABLE:
+      if (ins.item->what == Item::VARIABLE) {
+        val[++top] = ins.item->variable;
+      }else if (ins.item->what == Item::EXPRESSION) {
+        char const* endp;
+        if (evaluate_cached(ins.item->expression.c_str(), val[top+1], endp, imp) != EVAL::OK)
+          return EVAL::ERROR_CALCULATION_ERROR;
+        ++top;
+      }else{
+        return EVAL::ERROR_CALCULATION_ERROR;
+      }
+      break;
+    case OP_FUNCTION: {
+      double pp[MAX_N_PAR];
+      for(int i=0; i<ins.npar; i++) pp[i] = val[top--];
+      int status = call_function(*ins.item, ins.npar, pp, val[top+1]);
+      if (status != EVAL::OK) return status;
+      ++top;
+      break;
+    }
+    default: {
+      if (top < 1) return EVAL::ERROR_SYNTAX_ERROR;
+      double val2 = val[top--];
+      int status = calculate(ins.code, val[top], val2, val[top]);
+      if (status != EVAL::OK) return status;
+      break;
+    }
+    }
+  }
+  if (top != 0) return EVAL::ERROR_SYNTAX_ERROR;
+  result = val[0];
+  return EVAL::OK;
+}
+
+static int evaluate_cached(char const* expression, double & result,
+                           char const* & endp, EVAL::Object::Struct* imp)
+/***********************************************************************
+ *                                                                     *
+ * Function: Evaluates an expression using the cache of compiled       *
+ *           expressions. Expressions are compiled on first use.       *
+ *           Only expressions evaluated successfully are cached.       *
+ *           Errors are always reported by engine().                   *
+ *                                                                     *
+ *           The caller must hold the lock of the evaluator data.      *
+ *                                                                     *
+ * Parameters:                                                         *
+ *   expression - character string with the expression.                *
+ *   result - result of the evaluation.                                *
+ *   endp   - pointer to the character where the evaluation stoped.    *
+ *   imp    - evaluator data: dictionary and expression cache.         *
+ *                                                                     *
+ ***********************************************************************/
+{
+  char const* end = expression + strlen(expression) - 1;
+  auto iter = imp->theCache.find(expression);
+  if (iter != imp->theCache.end()) {
+    if (execute(iter->second, result, imp) == EVAL::OK) {
+      endp = end + 1;
+      return EVAL::OK;
+    }
+    return engine(expression, end, result, endp, imp->theDictionary);
+  }
+  Program code;
+  int status = engine(expression, end, result, endp, imp->theDictionary, &code);
+  if (status == EVAL::OK) {
+    imp->theCache.emplace(expression, std::move(code));
+  }
+  return status;
+}
+
 //---------------------------------------------------------------------------
 static int setItem(const char * prefix, const char * name,
                    const Item & item, EVAL::Object::Struct* imp) {
@@ -694,12 +868,13 @@ Evaluator::Object::~Object() {
 Evaluator::Object::EvalStatus Evaluator::Object::evaluate(const char * expression) const {
   EvalStatus s;
   if (expression != 0) {
+    // The lock is held during the entire evaluation: the cache may be modified
     Struct::ReadLock guard(imp);
-    s.theStatus = engine(expression,
-                         expression+strlen(expression)-1,
-                         s.theResult,
-                         s.thePosition,
-                         imp->theDictionary);
+    if (imp->theCache.size() > MAX_CACHE_SIZE) imp->theCache.clear();
+    s.theStatus = evaluate_cached(expression,
+                                  s.theResult,
+                                  s.thePosition,
+                                  imp);
   }
   return s;
 }
@@ -863,6 +1038,7 @@ void Evaluator::Object::removeVariable(const char * name) {
   const char * pointer; int n; REMOVE_BLANKS;
   if (n == 0) return;
   Struct::WriteLock guard(imp);
+  imp->theCache.clear();
   imp->theDictionary.erase(std::string(pointer,n));
 }
 
@@ -873,6 +1049,7 @@ void Evaluator::Object::removeFunction(const char * name, int npar) {
   const char * pointer; int n; REMOVE_BLANKS;
   if (n == 0) return;
   Struct::WriteLock guard(imp);
+  imp->theCache.clear();
   imp->theDictionary.erase(sss[npar]+std::string(pointer,n));
 }
 
@@ -21,6 +21,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 
 namespace dd4hep {
@@ -75,6 +76,39 @@ namespace dd4hep {
       CellID cellID(const Position& global) const;
 
 
+      /** Enable the thread-safe mode of cellID(const Position&).
+       *  Every calling thread uses its own TGeoNavigator and caches the last
+       *  visited sensitive node, so that neighbouring points are resolved without
+       *  a new search. The cache is only used while the thread's navigator is still
+       *  positioned on this node. The volume IDs are collected directly from the navigator's
+       *  node stack (no TGeoPhysicalNode is constructed).
+       *  Must be called once from the main thread before any worker thread calls
+       *  cellID: the geometry manager is switched to multi-threaded mode
+       *  (TGeoManager::SetMaxThreads) for maxThreads worker threads.
+       */
+      void enableMultiThreading(int maxThreads) ;
+
+      /// Check if the thread-safe mode of cellID(const Position&) is enabled
+      bool isMultiThreaded() const { return _multiThreaded ; }
+
+      /** Batch version of position(const CellID&): convert n cellIDs to global positions.
+       *  The cells are grouped by volume context: the readout, segmentation and transformations
+       *  are resolved once per group. The results are bit-identical to the scalar call.
+       */
+      void positions(const CellID* cells, std::size_t n, Position* result) const;
+
+      /** Batch version of positionNominal(const CellID&): no alignment corrections are applied.
+       */
+      void positionsNominal(const CellID* cells, std::size_t n, Position* result) const;
+
+      /** Batch version of cellID(const Position&): convert n global positions to cellIDs.
+       *  Consecutive positions within the same sensitive placement reuse the navigation
+       *  result (transformation and volume ID) of the previous position.
+       *  The results are identical to the scalar call.
+       */
+      void cellIDs(const Position* global, std::size_t n, CellID* result) const;
+
+
 
       /** Find the context with DetElement, placements etc for a given cellID of a sensitive volume.
        *  Returns NULL if not found (e.g. if the cellID does not correspond to a sensitive volume).
@@ -117,8 +151,14 @@ namespace dd4hep {
     std::vector<double> cellDimensions(const CellID& cell) const ;
 
     protected:
+      /// Thread-safe implementation of cellID(const Position&) using a navigator per thread
+      CellID cellIDMT(const Position& global) const;
+
       VolumeManager _volumeManager{} ;
       const Detector* _description ;
+      bool _multiThreaded{false} ;
+      /// Unique key of the per-thread navigation caches (never reused, unlike object addresses)
+      unsigned long _navigationKey{0} ;
 
     };
 
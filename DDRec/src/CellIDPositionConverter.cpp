@@ -17,6 +17,11 @@
 #include <DD4hep/detail/VolumeManagerInterna.h>
 
 #include <TGeoManager.h>
+#include <TGeoNavigator.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 
 namespace dd4hep {
   namespace rec {
@@ -71,6 +76,12 @@ namespace dd4hep {
       
       local.GetCoordinates(l);
 
+      // the volume manager caches the composed volume-to-world transformation
+      if( context->worldTrafo ){
+	context->worldTrafo->localToWorld(l, g);
+	return Position(g[0], g[1], g[2]);
+      }
+
       const TGeoMatrix& volToElement = context->toElement();
       volToElement.LocalToMaster(l, e);
 
@@ -84,8 +95,151 @@ namespace dd4hep {
 
 
 
+    void CellIDPositionConverter::positions(const CellID* cells, std::size_t n, Position* result) const {
+
+      // untill we have the alignment map object, we return the nominal position
+
+      positionsNominal( cells, n, result ) ;
+    }
+
+    void CellIDPositionConverter::positionsNominal(const CellID* cells, std::size_t n, Position* result) const {
+
+      if( n == 0 )
+	return ;
+
+      // first pass: resolve the context of every cell
+      std::vector<const VolumeManagerContext*> contexts( n ) ;
+      std::vector<std::size_t> order( n ) ;
+      for( std::size_t i = 0 ; i < n ; ++i ){
+	contexts[i] = findContext( cells[i] ) ;
+	order[i] = i ;
+      }
+
+      // group the cells by context - keep the input order within each group
+      std::stable_sort( order.begin(), order.end(), [&contexts]( std::size_t a, std::size_t b ){
+	  return contexts[a] < contexts[b] ;
+	} ) ;
+
+      // second pass: resolve readout and transformations once per group.
+      // Both matrices are applied one after the other exactly like in the scalar
+      // call: a composed matrix would not give bit-identical results.
+      double l[3], e[3], g[3];
+      for( std::size_t first = 0 ; first < n ; ){
+
+	const VolumeManagerContext* context = contexts[ order[first] ] ;
+	std::size_t last = first ;
+	while( last < n && contexts[ order[last] ] == context )
+	  ++last ;
+
+	if( context == NULL ){
+	  for( std::size_t k = first ; k < last ; ++k )
+	    result[ order[k] ] = Position() ;
+	  first = last ;
+	  continue ;
+	}
+
+	DetElement det = context->element ;
+	Readout r = findReadout( det ) ;
+	Segmentation seg = r.segmentation() ;
+
+	const TGeoMatrix& volToElement = context->toElement();
+	const TGeoMatrix& elementToGlobal = det.nominal().worldTransformation();
+
+	const VolumeManagerTransform* worldTrafo = context->worldTrafo ;
+
+	for( std::size_t k = first ; k < last ; ++k ){
+	  const std::size_t i = order[k] ;
+	  Position local = seg.position( cells[i] );
+	  local.GetCoordinates(l);
+	  if( worldTrafo ){
+	    worldTrafo->localToWorld(l, g);
+	    result[i] = Position(g[0], g[1], g[2]);
+	    continue ;
+	  }
+	  volToElement.LocalToMaster(l, e);
+	  elementToGlobal.LocalToMaster(e, g);
+	  result[i] = Position(g[0], g[1], g[2]);
+	}
+	first = last ;
+      }
+    }
+
+    void CellIDPositionConverter::cellIDs(const Position* global, std::size_t n, CellID* result) const {
+
+      if( n == 0 )
+	return ;
+
+      // the thread-safe mode caches the last visited node per thread anyhow
+      if( _multiThreaded ){
+	for( std::size_t i = 0 ; i < n ; ++i )
+	  result[i] = cellIDMT( global[i] ) ;
+	return ;
+      }
+
+      TGeoManager *geoManager = _description->world().volume()->GetGeoManager() ;
+
+      // navigation result of the previous position
+      bool          haveLast = false ;
+      TGeoHMatrix   lastMatrix ;
+      Segmentation  lastSeg ;
+      VolumeID      lastVolID = 0 ;
+
+      for( std::size_t i = 0 ; i < n ; ++i ){
+
+	const Position& pos = global[i] ;
+	double g[3], l[3] ;
+	pos.GetCoordinates( g ) ;
+
+	// the current node of the navigator is still the sensitive placement of the previous point
+	if( haveLast && geoManager->IsSameLocation( g[0], g[1], g[2] ) ){
+	  lastMatrix.MasterToLocal( g, l );
+	  result[i] = lastSeg.cellID( Position( l[0], l[1], l[2] ) , pos, lastVolID  );
+	  continue ;
+	}
+
+	haveLast = false ;
+	result[i] = CellID(0) ;
+
+	PlacedVolume pv = geoManager->FindNode( g[0] , g[1] , g[2] ) ;
+
+	if( ! pv.isValid() || ! pv.volume().isSensitive() )
+	  continue ;
+
+	lastMatrix = *geoManager->GetCurrentMatrix() ;
+	lastMatrix.MasterToLocal( g, l );
+
+	SensitiveDetector sd = pv.volume().sensitiveDetector();
+	Readout r = sd.readout() ;
+
+	// collect all volIDs for the current path
+	PlacedVolume::VolIDs volIDs ;
+	volIDs.insert( std::end(volIDs), std::begin(pv.volIDs()), std::end(pv.volIDs())) ;
+
+	TGeoPhysicalNode pN( geoManager->GetPath() ) ;
+
+	unsigned motherCount = 0 ;
+
+	while( pN.GetMother( motherCount ) != NULL   ){
+
+	    PlacedVolume mPv = pN.GetMother( motherCount++ ) ;
+
+	    if( mPv.isValid() &&  pN.GetMother( motherCount ) != NULL )  // world has no volIDs
+	      volIDs.insert( std::end(volIDs), std::begin(mPv.volIDs()), std::end(mPv.volIDs())) ;
+	}
+
+	lastVolID = r.idSpec().encode( volIDs ) ;
+	lastSeg   = r.segmentation() ;
+	haveLast  = true ;
+
+	result[i] = lastSeg.cellID( Position( l[0], l[1], l[2] ) , pos, lastVolID  );
+      }
+    }
+
     CellID CellIDPositionConverter::cellID(const Position& global) const {
 
+      if( _multiThreaded )
+	return cellIDMT( global ) ;
+
       CellID result(0) ;
       
       TGeoManager *geoManager = _description->world().volume()->GetGeoManager() ;
@@ -127,6 +281,100 @@ namespace dd4hep {
       return result ;
     }
 
+    namespace {
+
+      /// Per-thread navigation state of the thread-safe cellID conversion
+      struct NavigationCache {
+	unsigned long  key       = 0 ;
+	TGeoNavigator* navigator = nullptr ;
+	/// Last visited sensitive node and its navigation result
+	TGeoNode*     node      = nullptr ;
+	TGeoHMatrix   matrix ;
+	Segmentation  segmentation ;
+	VolumeID      volumeID  = 0 ;
+      };
+
+      /// Source of the navigation cache keys
+      std::atomic<unsigned long> s_navigationKeys{0} ;
+
+      NavigationCache& navigationCache( unsigned long key, TGeoManager* mgr ) {
+	static thread_local NavigationCache cache ;
+	if( cache.key != key ){
+	  cache = NavigationCache() ;
+	  cache.key       = key ;
+	  cache.navigator = mgr->GetCurrentNavigator() ;
+	  if( cache.navigator == nullptr )
+	    cache.navigator = mgr->AddNavigator() ;
+	}
+	return cache ;
+      }
+
+      /// Check if the navigator is still positioned on the cached node
+      bool samePlacement( TGeoNavigator* nav, const NavigationCache& cache ) {
+	if( nav->GetCurrentNode() != cache.node )
+	  return false ;
+	// the same node may be reached through different paths: compare the placement
+	const TGeoHMatrix* m = nav->GetCurrentMatrix() ;
+	return 0 == std::memcmp( m->GetTranslation(), cache.matrix.GetTranslation(), 3*sizeof(double) ) &&
+	  0 == std::memcmp( m->GetRotationMatrix(), cache.matrix.GetRotationMatrix(), 9*sizeof(double) ) ;
+      }
+    }
+
+    void CellIDPositionConverter::enableMultiThreading(int maxThreads) {
+
+      TGeoManager *geoManager = _description->world().volume()->GetGeoManager() ;
+
+      if( ! geoManager->IsMultiThread() || geoManager->GetMaxThreads() < maxThreads )
+	geoManager->SetMaxThreads( maxThreads ) ;
+
+      _navigationKey = ++s_navigationKeys ;
+      _multiThreaded = true ;
+    }
+
+    CellID CellIDPositionConverter::cellIDMT(const Position& global) const {
+
+      TGeoManager *geoManager = _description->world().volume()->GetGeoManager() ;
+      NavigationCache& cache = navigationCache( _navigationKey, geoManager ) ;
+      TGeoNavigator* nav = cache.navigator ;
+
+      double g[3], l[3] ;
+      global.GetCoordinates( g ) ;
+
+      // neighbouring hit: still inside the last visited sensitive node. Other clients
+      // of the thread's navigator may have moved it in between: check the position first
+      if( cache.node != nullptr && samePlacement( nav, cache ) && nav->IsSameLocation( g[0], g[1], g[2] ) ){
+	cache.matrix.MasterToLocal( g, l );
+	return cache.segmentation.cellID( Position( l[0], l[1], l[2] ) , global, cache.volumeID  );
+      }
+
+      cache.node = nullptr ;
+
+      PlacedVolume pv = nav->FindNode( g[0] , g[1] , g[2] ) ;
+
+      if( ! pv.isValid() || ! pv.volume().isSensitive() )
+	return CellID(0) ;
+
+      cache.matrix = *nav->GetCurrentMatrix() ;
+      cache.matrix.MasterToLocal( g, l );
+
+      SensitiveDetector sd = pv.volume().sensitiveDetector();
+      Readout r = sd.readout() ;
+
+      // collect all volIDs from the navigator's node stack - the world (level 0) has no volIDs
+      PlacedVolume::VolIDs volIDs ;
+      for( int up = 0, level = nav->GetLevel() ; up < level ; ++up ){
+	PlacedVolume mPv = nav->GetMother( up ) ;
+	if( mPv.isValid() )
+	  volIDs.insert( std::end(volIDs), std::begin(mPv.volIDs()), std::end(mPv.volIDs())) ;
+      }
+
+      cache.volumeID     = r.idSpec().encode( volIDs ) ;
+      cache.segmentation = r.segmentation() ;
+      cache.node         = pv.ptr() ;
+
+      return cache.segmentation.cellID( Position( l[0], l[1], l[2] ) , global, cache.volumeID  );
+    }
+
     // CellID CellIDPositionConverter::cellID(const Position& global) const {
       
     //   CellID result(0) ;
@@ -0,0 +1,101 @@
+#include "DD4hep/DDTest.h"
+
+#include <exception>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "DDG4/Geant4ParticleHandler.h"
+
+using namespace dd4hep::sim;
+typedef Geant4ParticleHandler::EquivalentStore Store;
+
+static dd4hep::DDTest test( "DenseMap" ) ;
+
+//=============================================================================
+
+int main(int /* argc */, char** /* argv */ ){
+
+  try{
+
+    // ----- write your tests in here -------------------------------------
+
+    test.log( "test insertion and lookup" );
+    Store store;
+    test( store.empty(), " new map is empty" );
+    test( store.get(5), -1, " absent key gives the empty value" );
+    test( store.get(-3), -1, " negative key gives the empty value" );
+    store.set(7, 70);
+    store.set(2, 20);
+    store.set(40, 400);
+    test( store.size(), std::size_t(3), " number of entries after insertion" );
+    test( store.get(7), 70, " lookup of an inserted key" );
+    test( store.contains(40) && !store.contains(39), " contains distinguishes present and absent keys" );
+    store.set(7, 71);
+    test( store.size(), std::size_t(3), " overwriting an entry keeps the size" );
+    test( store.get(7), 71, " overwritten value" );
+
+    bool thrown = false;
+    try  {
+      store.set(-1, 10);
+    }
+    catch( const std::exception& )  {
+      thrown = true;
+    }
+    test( thrown, " negative key is refused" );
+
+    test.log( "test removal" );
+    test( store.erase(2), 20, " erase returns the removed value" );
+    test( store.erase(2), -1, " erasing an absent key returns the empty value" );
+    test( store.erase(1000), -1, " erasing a key beyond the limit returns the empty value" );
+    test( store.size(), std::size_t(2), " number of entries after removal" );
+    store.set(40, -1);
+    test( store.size(), std::size_t(1), " setting the empty value removes the entry" );
+    test( store.contains(40), false, " entry set to the empty value is absent" );
+
+    test.log( "test ordered iteration across holes" );
+    std::map<int,int> reference;
+    Store dense;
+    for( int i = 0; i < 200; ++i )  {
+      int key = (i * 37) % 211;
+      dense.set(key, i);
+      reference[key] = i;
+    }
+    for( int key = 0; key < 211; key += 3 )  {
+      dense.erase(key);
+      reference.erase(key);
+    }
+    std::vector<std::pair<int,int> > entries;
+    for( const auto& e : dense ) entries.emplace_back(e.first, e.second);
+    std::vector<std::pair<int,int> > expected(reference.begin(), reference.end());
+    test( dense.size(), reference.size(), " size agrees with std::map" );
+    test( entries == expected, " iteration agrees with std::map: ascending keys, holes skipped" );
+
+    std::map<int,int> copy;
+    dense.copyTo(copy);
+    test( copy == reference, " copy to std::map" );
+
+    Store holes;
+    holes.set(0, 1);
+    holes.set(10, 2);
+    holes.erase(0);
+    auto it = holes.begin();
+    test( it != holes.end() && (*it).first == 10, " iteration skips a leading hole" );
+    holes.erase(10);
+    test( holes.begin() == holes.end(), " map with holes only is empty to iterate" );
+
+    dense.clear();
+    test( dense.empty() && dense.begin() == dense.end() && dense.limit() == 0, " cleared map is empty" );
+
+    // --------------------------------------------------------------------
+
+  } catch( std::exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
+
+//=============================================================================
@@ -0,0 +1,174 @@
+#include "DD4hep/DDTest.h"
+
+#include <exception>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "DDDigi/DigiData.h"
+
+using namespace dd4hep::digi;
+typedef std::multimap<dd4hep::CellID, EnergyDeposit> Reference;
+
+static dd4hep::DDTest test( "DepositMapping" ) ;
+
+//=============================================================================
+
+namespace  {
+
+  /// Random deposits on few cells, such that most cells are hit several times
+  DepositVector make_deposits(std::mt19937_64& gen, std::size_t num_deposits, unsigned num_cells)  {
+    std::uniform_int_distribution<unsigned> cell(0, num_cells-1);
+    std::uniform_real_distribution<double>  flat(0e0, 1e0);
+    DepositVector vec;
+    for( std::size_t i = 0; i < num_deposits; ++i )  {
+      EnergyDeposit dep;
+      dep.position     = Position(flat(gen), flat(gen), flat(gen));
+      dep.momentum     = Direction(flat(gen), flat(gen), flat(gen));
+      dep.deposit      = 1e-3 + flat(gen);
+      dep.depositError = 1e-4 * flat(gen);
+      dep.history.hits.emplace_back(Key(Key::key_type(i+1)), dep.deposit);
+      vec.emplace(0x1000 + 7*cell(gen), std::move(dep));
+    }
+    return vec;
+  }
+
+  /// Deposit map with the content of a deposit vector (multimap insertion order)
+  DepositMapping make_mapping(const DepositVector& vec)  {
+    DepositMapping map;
+    for( const auto& d : vec ) map.data.emplace(d.first, d.second);
+    return map;
+  }
+
+  /// Original multimap algorithm of DepositMapping::merge: fold into the first deposit of a cell
+  template <typename CONT> void reference_merge(Reference& ref, const CONT& updates)  {
+    for( const auto& dep : updates )  {
+      auto iter = ref.find(dep.first);
+      if ( iter == ref.end() )
+        ref.emplace(dep.first, dep.second);
+      else
+        iter->second.update_deposit_weighted(dep.second);
+    }
+  }
+
+  /// Original multimap algorithm of DepositMapping::insert: keep all deposits
+  template <typename CONT> void reference_insert(Reference& ref, const CONT& updates)  {
+    for( const auto& dep : updates )
+      ref.emplace(dep);
+  }
+
+  /// Compare a deposit container entry by entry with the reference
+  template <typename CONT> bool same(const CONT& cont, const Reference& ref)  {
+    if ( cont.size() != ref.size() ) return false;
+    auto r = ref.begin();
+    for( const auto& c : cont )  {
+      const EnergyDeposit& a = c.second;
+      const EnergyDeposit& b = r->second;
+      if ( c.first != r->first ||
+           a.deposit != b.deposit || a.depositError != b.depositError ||
+           a.position != b.position || a.momentum != b.momentum ||
+           a.history.hits.size() != b.history.hits.size() )
+        return false;
+      ++r;
+    }
+    return true;
+  }
+}
+
+int main(int /* argc */, char** /* argv */ ){
+
+  try{
+
+    // ----- write your tests in here -------------------------------------
+    std::mt19937_64 gen(4711);
+    DepositVector events[3] = { make_deposits(gen, 500, 97),
+                                make_deposits(gen, 300, 97),
+                                make_deposits(gen, 5,   97) };
+
+    test.log( "test merge against the multimap algorithm" );
+    {
+      Reference ref;
+      DepositMapping map;
+      for( const auto& ev : events )  {
+        reference_merge(ref, ev);
+        DepositVector upda = ev;
+        map.merge(std::move(upda));
+      }
+      test( same(map, ref), " DepositMapping::merge(DepositVector&&)" );
+    }
+    {
+      Reference ref;
+      DepositMapping map;
+      for( const auto& ev : events )  {
+        DepositMapping upda = make_mapping(ev);
+        reference_merge(ref, upda);
+        map.merge(std::move(upda));
+      }
+      test( same(map, ref), " DepositMapping::merge(DepositMapping&&)" );
+    }
+
+    test.log( "test insert against the multimap algorithm" );
+    {
+      Reference ref;
+      DepositMapping map;
+      for( const auto& ev : events )  {
+        reference_insert(ref, ev);
+        map.insert(ev);
+      }
+      test( same(map, ref), " DepositMapping::insert(const DepositVector&)" );
+    }
+    {
+      Reference ref;
+      DepositMapping map;
+      for( const auto& ev : events )  {
+        DepositMapping upda = make_mapping(ev);
+        reference_insert(ref, upda);
+        map.insert(upda);
+      }
+      test( same(map, ref), " DepositMapping::insert(const DepositMapping&)" );
+    }
+
+    test.log( "test combine against the multimap algorithm" );
+    {
+      Reference ref;
+      reference_merge(ref, events[0]);
+      DepositVector vec = events[0];
+      std::size_t folded = vec.combine();
+      test( vec.is_combined(), " vector is combined" );
+      test( folded, events[0].size() - ref.size(), " number of folded deposits" );
+      test( same(vec, ref), " DepositVector::combine()" );
+      bool found = true;
+      for( const auto& r : ref )
+        found &= vec.get(r.first).deposit == r.second.deposit;
+      test( found, " binary search lookup of combined cells" );
+    }
+
+    test.log( "test combine_cells of DigiContainerCombine against the multimap algorithm" );
+    {
+      /// DigiContainerCombine: inputs are inserted into one vector, then the cells are combined
+      Reference ref;
+      DepositVector out;
+      for( const auto& ev : events )  {
+        DepositMapping input = make_mapping(ev);
+        reference_merge(ref, input);
+        out.insert(input);
+      }
+      out.combine();
+      test( same(out, ref), " combined output of several deposit maps" );
+      DepositMapping map;
+      for( const auto& ev : events )
+        map.merge(make_mapping(ev));
+      test( same(map, ref), " merged deposit map equals the combined output" );
+    }
+
+    // --------------------------------------------------------------------
+  }
+  catch( std::exception &e ){
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+  return 0;
+}
+
+//=============================================================================
@@ -81,6 +81,33 @@ int main(int /* argc */, char** /* argv */ ){
       test( r.first, Evaluator::OK, " status OK");
     }
     
+    {
+      // compiled expressions are cached: repeated evaluations must give identical results
+      e.setVariable("cacheVar", 3);
+      e.setVariable("cacheExpr", "2*cacheVar+1");
+      auto r1 = e.evaluate("-cacheExpr*cm + sqrt(cacheVar)^2 + max(cacheVar, 1/4)");
+      auto r2 = e.evaluate("-cacheExpr*cm + sqrt(cacheVar)^2 + max(cacheVar, 1/4)");
+      test( r1.first, Evaluator::OK, " status OK");
+      test( r2.first, Evaluator::OK, " status OK of cached expression");
+      test( r1.second == r2.second, " cached expression gives identical result");
+      test( r1.second, -7*0.01 + std::pow(std::sqrt(3.),2) + 3, " value of expression");
+
+      // redefined variables are picked up by cached expressions
+      e.setVariable("cacheVar", 5);
+      auto r3 = e.evaluate("cacheExpr");
+      test( r3.second, 11., " redefined variable used by cached expression");
+      e.setVariable("cacheExpr", "cacheVar*cacheVar");
+      auto r4 = e.evaluate("cacheExpr");
+      test( r4.second, 25., " redefined expression used by cached expression");
+
+      // errors in cached expressions are reported as without cache
+      e.setVariable("cacheDiv", 1);
+      e.evaluate("1/cacheDiv");
+      e.setVariable("cacheDiv", 0);
+      auto r5 = e.evaluate("1/cacheDiv");
+      test( r5.first, Evaluator::ERROR_CALCULATION_ERROR, " status CALCULATION ERROR of cached expression");
+    }
+
     {
       //use cm as length
       Evaluator e_cm(100.);
@@ -0,0 +1,102 @@
+#include "DD4hep/DDTest.h"
+
+#include <exception>
+#include <iostream>
+#include <vector>
+#include <future>
+#include <thread>
+
+#include "DDG4/Geant4Data.h"
+#include "DDG4/Geant4HitCollection.h"
+
+#include "G4Threading.hh"
+
+using namespace dd4hep::sim;
+typedef Geant4Calorimeter::Hit Hit;
+
+static dd4hep::DDTest test( "Geant4HitCollection" ) ;
+
+//=============================================================================
+
+int main(int /* argc */, char** /* argv */ ){
+
+  try{
+
+    // ----- write your tests in here -------------------------------------
+
+    test.log( "test position lookup of Geant4HitCollection" );
+    Geant4HitCollection coll("Detector", "Hits", nullptr, (const Hit*)nullptr);
+    std::vector<Position> positions;
+    for( int i = 0; i < 50; ++i )  {
+      for( int j = 0; j < 50; ++j )
+        positions.emplace_back(0.1*i, -0.1*j, 1e-3*(i*j));
+    }
+    for( const auto& pos : positions )
+      coll.addByPosition(pos, new Hit(pos));
+    test( coll.GetSize(), positions.size(), " number of hits added by position" );
+
+    bool found = true;
+    for( const auto& pos : positions )  {
+      Hit* hit = coll.findByPosition<Hit>(pos);
+      found &= hit && hit == coll.find<Hit>(PositionCompare<Hit,Position>(pos));
+    }
+    test( found, " hashed lookup gives the same hits as PositionCompare" );
+    test( coll.findByPosition<Hit>(Position(0.05, 0., 0.)) == nullptr, " no hit at unknown position" );
+    test( coll.findByPosition<Hit>(Position(-0., 0., 0.)) != nullptr, " -0 and +0 are the same position" );
+
+    bool thrown = false;
+    Hit* duplicate = new Hit(positions[7]);
+    try  {
+      coll.addByPosition(positions[7], duplicate);
+    }
+    catch( const std::exception& )  {
+      thrown = true;
+      delete duplicate;
+    }
+    test( thrown, " second hit at the same position is refused" );
+
+    coll.clear();
+    test( coll.findByPosition<Hit>(positions[0]) == nullptr, " position map is cleared with the collection" );
+
+    test.log( "test pooled allocation of DDG4 hits" );
+    {
+      auto* cal = new Hit(Position(1., 2., 3.));
+      test( !Hit::isPooled(cal), " hit outside Geant4 worker threads uses the global allocator" );
+      delete cal;
+#ifdef G4MULTITHREADED
+      std::promise<Hit*> created, recreated;
+      std::promise<void>  returned;
+      std::thread worker([&]()  {
+        G4Threading::G4SetThreadId(0);
+        auto* hit = new Hit(Position(1., 2., 3.));
+        hit->truth.emplace_back();
+        created.set_value(hit);
+        returned.get_future().wait();
+        recreated.set_value(new Hit());
+      });
+      Hit* pooled = created.get_future().get();
+      test( Hit::isPooled(pooled), " hit inside a Geant4 worker thread is taken from the pool" );
+      /// Deleted by a foreign thread: the hit must go back to the pool of the worker
+      delete pooled;
+      returned.set_value();
+      Hit* reused = recreated.get_future().get();
+      worker.join();
+      test( reused == pooled, " hit deleted by a foreign thread is reused by the owning pool" );
+      test( Hit::isPooled(reused), " reused hit is still owned by the pool" );
+      test( reused->truth.empty(), " pooled calorimeter hit is properly constructed" );
+      delete reused;
+#endif
+    }
+
+    // --------------------------------------------------------------------
+
+  } catch( std::exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
+
+//=============================================================================
@@ -0,0 +1,89 @@
+#include "DD4hep/DDTest.h"
+#include <exception>
+#include <iostream>
+
+#include "DDSegmentation/BitFieldCoderFixed.h"
+
+using namespace std;
+using namespace dd4hep;
+using namespace DDSegmentation;
+
+namespace {
+  inline constexpr char descriptor[] = "system:5,side:-2,layer:9,module:8,sensor:8,x:32:-16,y:-16";
+  inline constexpr char other[]      = "system:5,side:-2,layer:9,module:8,sensor:8,x:32:-16,y:16";
+  typedef BitFieldCoderFixed<descriptor> Coder;
+  typedef BitFieldCoderFixed<other>      OtherCoder;
+
+  // Layout is computed by the compiler
+  static_assert( Coder::size() == 7, "number of fields" );
+  static_assert( Coder::index("layer") == 2, "index of field layer" );
+  static_assert( Coder::field("x").offset == 32 && Coder::field("x").width == 16, "layout of field x" );
+  static_assert( Coder::field("y").offset == 48 && Coder::field("y").isSigned, "layout of field y" );
+  static_assert( Coder::mask() == 0xFFFFFFFFFFFFFFFFULL, "all 64 bits are used" );
+}
+
+//=============================================================================
+int main(int /* argc */, char** /* argv */ ){
+  // this should be the first line in your test
+  DDTest test( "bitfieldcoder_fixed" );
+
+  try{
+
+    // ----- write your tests in here -------------------------------------
+
+    test.log( "test bitfieldcoder fixed" );
+
+    const BitFieldCoder bf( descriptor ) ;
+    constexpr auto layer  = Coder::field( "layer" ) ;
+    constexpr auto module = Coder::field( "module" ) ;
+    constexpr auto sensor = Coder::field( "sensor" ) ;
+    constexpr auto side   = Coder::field( "side" ) ;
+    constexpr auto system = Coder::field( "system" ) ;
+    constexpr auto x      = Coder::field( "x" ) ;
+    constexpr auto y      = Coder::field( "y" ) ;
+
+    CellID field = 0  ;
+
+    layer.set(  field, 373 );
+    module.set( field, 254 );
+    sensor.set( field, 202 );
+    side.set(   field, 1 );
+    system.set( field, 30 );
+    x.set(      field, -310 );
+    y.set(      field, -16710 );
+
+    test(  field , CellID(0xbebafecacafebabeUL)  , " same value 0xbebafecacafebabeUL from fixed coder " );
+
+    test( layer.value( field ),  bf.get( field, "layer" ),  " fixed vs. runtime access: layer" );
+    test( module.value( field ), bf.get( field, "module" ), " fixed vs. runtime access: module" );
+    test( sensor.value( field ), bf.get( field, "sensor" ), " fixed vs. runtime access: sensor" );
+    test( side.value( field ),   bf.get( field, "side" ),   " fixed vs. runtime access: side" );
+    test( system.value( field ), bf.get( field, "system" ), " fixed vs. runtime access: system" );
+    test( x.value( field ),      FieldID(-310),             " fixed access: x" );
+    test( Coder::get<Coder::index("y")>( field ), FieldID(-16710), " fixed access by index: y" );
+
+    test( Coder::matches( bf ),      true,  " descriptor matches runtime decoder" );
+    test( OtherCoder::matches( bf ), false, " different signedness does not match" );
+
+    bool thrown = false ;
+    try { OtherCoder::verify( bf ) ; } catch( const std::runtime_error& ) { thrown = true ; }
+    test( thrown, true, " verify throws on descriptor mismatch" );
+
+    thrown = false ;
+    try { side.set( field, 5 ) ; } catch( const std::runtime_error& ) { thrown = true ; }
+    test( thrown, true, " out of range value throws" );
+
+    // --------------------------------------------------------------------
+
+
+  } catch( exception &e ){
+    //} catch( ... ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
+
+//=============================================================================
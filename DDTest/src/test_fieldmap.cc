@@ -0,0 +1,158 @@
+#include "DD4hep/DDTest.h"
+#include "DD4hep/FieldTypes.h"
+#include "DD4hep/DD4hepUnits.h"
+
+#include <cmath>
+#include <cstdio>
+#include <exception>
+#include <random>
+#include <vector>
+
+using namespace dd4hep;
+
+namespace {
+
+  /// Trilinear test field in tesla. Lengths in mm. Reproduced exactly by trilinear interpolation
+  void cartesian_field(double x, double y, double z, double b[3])  {
+    b[0] = 1.0 + 1e-3*x + 2e-3*y - 1e-3*z + 1e-9*x*y*z;
+    b[1] = 0.5 - 2e-3*x + 1e-6*x*y;
+    b[2] = 2.0 + 1e-3*z + 1e-6*y*z;
+  }
+
+  /// Bilinear test field (Br, Bphi, Bz) in tesla in the (r,z) plane. Lengths in mm
+  void cylindrical_field(double r, double z, double b[3])  {
+    b[0] = 1e-3*r + 1e-6*r*z;
+    b[1] = 0.2;
+    b[2] = 2.0 + 1e-3*z - 1e-6*r*z;
+  }
+
+  /// Write a field map sampling the test field
+  template <typename FIELD>
+  void write_map(const std::string& name, int geom, const unsigned dim[3],
+                 const double start[3], const double step[3], FIELD func)  {
+    std::vector<float> values;
+    for( unsigned k = 0; k < dim[2]; ++k )  {
+      for( unsigned j = 0; j < dim[1]; ++j )  {
+        for( unsigned i = 0; i < dim[0]; ++i )  {
+          double b[3];
+          func(start[0] + i*step[0], start[1] + j*step[1], start[2] + k*step[2], b);
+          values.emplace_back(float(b[0]));
+          values.emplace_back(float(b[1]));
+          values.emplace_back(float(b[2]));
+        }
+      }
+    }
+    FieldMapField::write(name, geom, dim, start, step, values);
+  }
+
+  /// Evaluate the field map at a position given in mm. Result in tesla
+  void evaluate(FieldMapField& map, double x, double y, double z, double b[3])  {
+    double pos[3] = { x*dd4hep::mm, y*dd4hep::mm, z*dd4hep::mm };
+    double fld[3] = { 0e0, 0e0, 0e0 };
+    map.fieldComponents(pos, fld);
+    for( int i = 0; i < 3; ++i ) b[i] = fld[i]/dd4hep::tesla;
+  }
+
+  double deviation(const double b[3], const double e[3])  {
+    return std::max(std::fabs(b[0]-e[0]), std::max(std::fabs(b[1]-e[1]), std::fabs(b[2]-e[2])));
+  }
+}
+
+//=============================================================================
+int main(int /* argc */, char** /* argv */ ){
+
+  DDTest test( "fieldmap" ) ;
+  const double tolerance = 1e-5;  // tesla: the nodes are stored as floats
+
+  try{
+    std::mt19937 gen(12345);
+    std::uniform_real_distribution<double> flat(-1e0, 1e0);
+
+    // ----- Cartesian grid folded in x: trilinear interpolation between the nodes
+    {
+      const char* name = "test_fieldmap_cartesian.bin";
+      unsigned dim[3]   = { 11, 11, 11 };
+      double   start[3] = { 0e0, -500e0, -1000e0 };
+      double   step[3]  = { 100e0, 100e0, 200e0 };
+      write_map(name, FieldMapField::CARTESIAN, dim, start, step,
+                [](double x, double y, double z, double b[3]) { cartesian_field(x, y, z, b); });
+      FieldMapField map;
+      map.fold = 1;
+      map.parity[0][0] = -1e0;
+      map.load(name, dd4hep::mm, dd4hep::tesla);
+
+      double max_dev = 0e0, max_fold_dev = 0e0;
+      for( int i = 0; i < 10000; ++i )  {
+        double x = 1000e0*std::fabs(flat(gen)), y = 500e0*flat(gen), z = 1000e0*flat(gen);
+        double b[3], e[3];
+        cartesian_field(x, y, z, e);
+        evaluate(map, x, y, z, b);
+        max_dev = std::max(max_dev, deviation(b, e));
+        // Folded: the map is looked up at |x|, Bx changes sign
+        e[0] = -e[0];
+        evaluate(map, -x, y, z, b);
+        max_fold_dev = std::max(max_fold_dev, deviation(b, e));
+      }
+      test( max_dev < tolerance, "cartesian map: trilinear interpolation reproduces the field" );
+      test( max_fold_dev < tolerance, "cartesian map: folded axis applies the component parity" );
+
+      double b[3], zero[3] = { 0e0, 0e0, 0e0 };
+      evaluate(map, 100e0, 600e0, 0e0, b);
+      test( deviation(b, zero), 0e0, "cartesian map: no contribution outside the grid" );
+      std::remove(name);
+    }
+
+    // ----- Cartesian grid with a single node in z: the field is invariant along z
+    {
+      const char* name = "test_fieldmap_planar.bin";
+      unsigned dim[3]   = { 11, 11, 1 };
+      double   start[3] = { -500e0, -500e0, 0e0 };
+      double   step[3]  = { 100e0, 100e0, 0e0 };
+      write_map(name, FieldMapField::CARTESIAN, dim, start, step,
+                [](double x, double y, double, double b[3]) { cartesian_field(x, y, 0e0, b); });
+      FieldMapField map;
+      map.load(name, dd4hep::mm, dd4hep::tesla);
+
+      double b[3], e[3];
+      cartesian_field(120e0, -340e0, 0e0, e);
+      evaluate(map, 120e0, -340e0, 5000e0, b);
+      test( deviation(b, e) < tolerance, "planar map: axis with a single node is not bounded" );
+      std::remove(name);
+    }
+
+    // ----- Cylindrical grid in (r,z): bilinear interpolation rotated to the azimuth
+    {
+      const char* name = "test_fieldmap_cylindrical.bin";
+      unsigned dim[3]   = { 11, 11, 1 };
+      double   start[3] = { 0e0, -1000e0, 0e0 };
+      double   step[3]  = { 100e0, 200e0, 0e0 };
+      write_map(name, FieldMapField::CYLINDRICAL, dim, start, step,
+                [](double r, double z, double, double b[3]) { cylindrical_field(r, z, b); });
+      FieldMapField map;
+      map.load(name, dd4hep::mm, dd4hep::tesla);
+
+      double max_dev = 0e0;
+      for( int i = 0; i < 10000; ++i )  {
+        double x = 700e0*flat(gen), y = 700e0*flat(gen), z = 1000e0*flat(gen);
+        double r = std::sqrt(x*x + y*y), c[3], b[3];
+        cylindrical_field(r, z, c);
+        double e[3] = { (c[0]*x - c[1]*y)/r, (c[0]*y + c[1]*x)/r, c[2] };
+        evaluate(map, x, y, z, b);
+        max_dev = std::max(max_dev, deviation(b, e));
+      }
+      test( max_dev < tolerance, "cylindrical map: bilinear interpolation rotated to the azimuth" );
+
+      double b[3], e[3] = { 0e0, 0e0, 0e0 };
+      cylindrical_field(0e0, 300e0, e);
+      evaluate(map, 0e0, 0e0, 300e0, b);
+      test( std::fabs(b[2] - e[2]) < tolerance && b[0] == 0e0 && b[1] == 0e0,
+            "cylindrical map: only Bz on the axis" );
+      std::remove(name);
+    }
+  } catch( std::exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+  return 0;
+}
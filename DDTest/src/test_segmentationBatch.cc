@@ -0,0 +1,103 @@
+#include "DDSegmentation/CartesianGridXY.h"
+#include "DDSegmentation/CartesianGridXYZ.h"
+#include "DDSegmentation/CylindricalGridPhiZ.h"
+#include "DDSegmentation/MultiSegmentation.h"
+#include "DDSegmentation/PolarGridRPhi.h"
+#include "DD4hep/DDTest.h"
+
+#include <cstring>
+#include <exception>
+#include <random>
+#include <vector>
+
+using namespace dd4hep::DDSegmentation;
+
+namespace {
+
+  /// Compare the batch interfaces against the scalar calls: results must be bit-identical
+  void check(dd4hep::DDTest& test, const Segmentation& seg, const std::string& tag)  {
+    const std::size_t n = 10000;
+    std::mt19937 gen(12345);
+    std::uniform_real_distribution<double> dist(-50., 50.);
+    std::vector<double>   x(n), y(n), z(n), px(n), py(n), pz(n);
+    std::vector<VolumeID> vol(n);
+    std::vector<CellID>   cells(n);
+
+    for( std::size_t i = 0; i < n; ++i )  {
+      x[i] = dist(gen);
+      y[i] = dist(gen);
+      z[i] = dist(gen);
+      vol[i] = (i%2) ? 0x8 : 0x0;  // toggle the 'side' bit
+    }
+    seg.cellIDs(n, x.data(), y.data(), z.data(), nullptr, nullptr, nullptr, vol.data(), cells.data());
+    seg.positions(n, cells.data(), px.data(), py.data(), pz.data());
+
+    std::size_t bad_ids = 0, bad_pos = 0;
+    for( std::size_t i = 0; i < n; ++i )  {
+      Vector3D local(x[i], y[i], z[i]);
+      if( seg.cellID(local, local, vol[i]) != cells[i] ) ++bad_ids;
+      Vector3D pos = seg.position(cells[i]);
+      if( std::memcmp(&pos.X, &px[i], sizeof(double)) ||
+          std::memcmp(&pos.Y, &py[i], sizeof(double)) ||
+          std::memcmp(&pos.Z, &pz[i], sizeof(double)) ) ++bad_pos;
+    }
+    test( bad_ids, std::size_t(0), tag + ": batch cellIDs identical to scalar cellID" );
+    test( bad_pos, std::size_t(0), tag + ": batch positions identical to scalar position" );
+  }
+}
+
+int main() {
+
+  dd4hep::DDTest test( "segmentationBatch" );
+
+  try{
+
+    CartesianGridXY xy("system:3,side:1,x:32:-16,y:-16");
+    xy.parameter("grid_size_x")->setValue("0.7");
+    xy.parameter("grid_size_y")->setValue("1.1");
+    check(test, xy, "CartesianGridXY");
+
+    CartesianGridXYZ xyz("system:3,side:1,x:-10,y:-10,z:-10");
+    check(test, xyz, "CartesianGridXYZ");
+
+    PolarGridRPhi rphi("system:3,side:1,r:32:16,phi:-16");
+    rphi.parameter("grid_size_phi")->setValue("0.01");
+    check(test, rphi, "PolarGridRPhi");
+
+    CylindricalGridPhiZ phiz("system:3,side:1,phi:32:-16,z:-16");
+    phiz.parameter("grid_size_phi")->setValue("0.01");
+    check(test, phiz, "CylindricalGridPhiZ");
+
+    // Sub-segmentations are selected by the 'side' field
+    MultiSegmentation multi("system:3,side:1,x:32:-16,y:-16");
+    multi.parameter("key")->setValue("side");
+    CartesianGridXY* sub0 = new CartesianGridXY("system:3,side:1,x:32:-16,y:-16");
+    CartesianGridXY* sub1 = new CartesianGridXY("system:3,side:1,x:32:-16,y:-16");
+    sub1->parameter("grid_size_x")->setValue("3.3");
+    multi.addSubsegmentation(0, 0, sub0);
+    multi.addSubsegmentation(1, 1, sub1);
+    BitFieldCoder decoder("system:3,side:1,x:32:-16,y:-16");
+    multi.setDecoder(&decoder);
+    check(test, multi, "MultiSegmentation");
+
+    // Changing an identifier after the decoder is set must re-bind the bit field element
+    BitFieldCoder uv_decoder("system:3,side:1,x:16:-8,y:-8,u:-8,v:-8");
+    CartesianGridXY uv("system:3,side:1,x:16:-8,y:-8,u:-8,v:-8");
+    uv.setDecoder(&uv_decoder);
+    uv.parameter("identifier_x")->setValue("u");
+    uv.parameter("identifier_y")->setValue("v");
+    Vector3D local(3.2, -5.7, 0.);
+    CellID uv_id = uv.cellID(local, local, 0);
+    test( uv_decoder.get(uv_id, "u"), FieldID(3), "CartesianGridXY: identifier_x re-bound to field u" );
+    test( uv_decoder.get(uv_id, "v"), FieldID(-6), "CartesianGridXY: identifier_y re-bound to field v" );
+    test( uv_decoder.get(uv_id, "x") + uv_decoder.get(uv_id, "y"), FieldID(0), "CartesianGridXY: fields x and y untouched" );
+    test( uv.position(uv_id).X, 3., "CartesianGridXY: position decoded from field u" );
+    test( uv.volumeID(uv_id), VolumeID(0), "CartesianGridXY: volumeID masks the fields u and v" );
+
+  } catch( std::exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+  return 0;
+}
@@ -0,0 +1,142 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+//
+//  Benchmark of the scalar and the batch conversions of the
+//  CellIDPositionConverter. The cellIDs are taken from all sensitive
+//  placements known to the volume manager.
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/Detector.h"
+#include "DD4hep/Printout.h"
+#include "DD4hep/VolumeManager.h"
+#include "DD4hep/detail/VolumeManagerInterna.h"
+#include "DDRec/CellIDPositionConverter.h"
+
+#include <chrono>
+#include <thread>
+#include <cstring>
+#include <iostream>
+
+using namespace dd4hep;
+using namespace dd4hep::rec;
+
+//=============================================================================
+
+namespace {
+
+  /// Collect the volume identifiers of all registered sensitive placements
+  void collect_cells(const detail::VolumeManagerObject& o, std::vector<CellID>& cells)  {
+    for( const auto& v : o.volumes )
+      cells.emplace_back(v.first);
+    for( const auto& s : o.subdetectors )
+      collect_cells(*s.second.data<detail::VolumeManagerObject>(), cells);
+  }
+
+  /// Elapsed time in seconds
+  double elapsed(std::chrono::high_resolution_clock::time_point start)  {
+    std::chrono::duration<double> secs = std::chrono::high_resolution_clock::now() - start;
+    return secs.count();
+  }
+}
+
+int main_wrapper(int argc, char** argv ){
+
+  if( argc < 2 ) {
+    std::cout << " usage: bench_cellid_position_converter compact.xml [turns] [max-threads]" << std::endl ;
+    exit(1) ;
+  }
+  std::size_t turns = argc > 2 ? std::stoul( argv[2] ) : 10 ;
+  int max_threads   = argc > 3 ? std::stoi( argv[3] ) : 0 ;
+
+  Detector& description = Detector::getInstance();
+  description.fromCompact( argv[1] );
+
+  CellIDPositionConverter conv( description ) ;
+  VolumeManager mgr = VolumeManager::getVolumeManager( description ) ;
+
+  std::vector<CellID> cells ;
+  collect_cells( *mgr.data<detail::VolumeManagerObject>(), cells ) ;
+  if( cells.empty() ){
+    std::cout << " no sensitive placements found in " << argv[1] << std::endl ;
+    return 1 ;
+  }
+  std::size_t n = cells.size() ;
+  std::vector<Position> pos_scalar( n ), pos_batch( n ) ;
+  std::vector<CellID>   ids_scalar( n ), ids_batch( n ) ;
+
+  //---- cellID -> position
+  auto start = std::chrono::high_resolution_clock::now() ;
+  for( std::size_t t = 0 ; t < turns ; ++t )
+    for( std::size_t i = 0 ; i < n ; ++i )
+      pos_scalar[i] = conv.position( cells[i] ) ;
+  double t_pos_scalar = elapsed( start ) ;
+
+  start = std::chrono::high_resolution_clock::now() ;
+  for( std::size_t t = 0 ; t < turns ; ++t )
+    conv.positions( cells.data(), n, pos_batch.data() ) ;
+  double t_pos_batch = elapsed( start ) ;
+
+  //---- position -> cellID
+  start = std::chrono::high_resolution_clock::now() ;
+  for( std::size_t t = 0 ; t < turns ; ++t )
+    for( std::size_t i = 0 ; i < n ; ++i )
+      ids_scalar[i] = conv.cellID( pos_scalar[i] ) ;
+  double t_id_scalar = elapsed( start ) ;
+
+  start = std::chrono::high_resolution_clock::now() ;
+  for( std::size_t t = 0 ; t < turns ; ++t )
+    conv.cellIDs( pos_scalar.data(), n, ids_batch.data() ) ;
+  double t_id_batch = elapsed( start ) ;
+
+  std::size_t pos_mismatch = 0, id_mismatch = 0 ;
+  for( std::size_t i = 0 ; i < n ; ++i ){
+    if( 0 != std::memcmp( &pos_scalar[i], &pos_batch[i], sizeof(Position) ) ) ++pos_mismatch ;
+    if( ids_scalar[i] != ids_batch[i] ) ++id_mismatch ;
+  }
+  double num = double( n * turns ) ;
+  printout( ALWAYS, "CellIDConverterBench", "+++ %ld cells, %ld turns", n, turns ) ;
+  printout( ALWAYS, "CellIDConverterBench", "+++ position: scalar %12.0f /sec  batch %12.0f /sec  speedup %.2f  mismatches: %ld",
+            num/t_pos_scalar, num/t_pos_batch, t_pos_scalar/t_pos_batch, pos_mismatch ) ;
+  printout( ALWAYS, "CellIDConverterBench", "+++ cellID:   scalar %12.0f /sec  batch %12.0f /sec  speedup %.2f  mismatches: %ld",
+            num/t_id_scalar, num/t_id_batch, t_id_scalar/t_id_batch, id_mismatch ) ;
+
+  //---- position -> cellID with a navigator per thread
+  if( max_threads > 0 ){
+    conv.enableMultiThreading( max_threads ) ;
+    double t_single = 0e0 ;
+    for( int nthr = 1 ; nthr <= max_threads ; nthr *= 2 ){
+      std::vector<std::thread> threads ;
+      std::vector<std::size_t> bad( nthr, 0 ) ;
+      start = std::chrono::high_resolution_clock::now() ;
+      for( int it = 0 ; it < nthr ; ++it ){
+        threads.emplace_back( [&, it](){
+            for( std::size_t t = 0 ; t < turns ; ++t )
+              for( std::size_t i = 0 ; i < n ; ++i )
+                if( conv.cellID( pos_scalar[i] ) != ids_scalar[i] ) ++bad[it] ;
+          } ) ;
+      }
+      for( auto& thr : threads ) thr.join() ;
+      double t_mt = elapsed( start ) ;
+      if( nthr == 1 ) t_single = t_mt ;
+      std::size_t nbad = 0 ;
+      for( std::size_t b : bad ) nbad += b ;
+      id_mismatch += nbad ;
+      printout( ALWAYS, "CellIDConverterBench", "+++ cellID MT: %3d threads %12.0f /sec  scaling %.2f  mismatches: %ld",
+                nthr, num*nthr/t_mt, t_single*nthr/t_mt, nbad ) ;
+    }
+  }
+  return ( pos_mismatch == 0 && id_mismatch == 0 ) ? 0 : 1 ;
+}
+
+//=============================================================================
+#include "main.h"
@@ -0,0 +1,138 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+//
+//  Benchmark of the cell ID encoding and decoding of all segmentations
+//  of a compact description. For every readout a set of cell IDs is
+//  created from local positions on a regular grid. Then the rates of
+//  - the string keyed field access of the BitFieldCoder,
+//  - the index based field access of the BitFieldCoder,
+//  - Segmentation::position, Segmentation::cellID and Segmentation::volumeID
+//  are printed per segmentation type.
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/Detector.h"
+#include "DD4hep/Printout.h"
+#include "DD4hep/Readout.h"
+#include "DD4hep/Segmentations.h"
+#include "DDSegmentation/Segmentation.h"
+
+#include <chrono>
+#include <iostream>
+
+using namespace dd4hep;
+
+//=============================================================================
+
+namespace {
+
+  /// Elapsed time in seconds
+  double elapsed(std::chrono::high_resolution_clock::time_point start)  {
+    std::chrono::duration<double> secs = std::chrono::high_resolution_clock::now() - start;
+    return secs.count();
+  }
+
+  /// Benchmark one segmentation. Round trip mismatches are informative only (cell boundaries)
+  void bench(const std::string& readout, const DDSegmentation::Segmentation* seg, std::size_t turns)  {
+    const DDSegmentation::BitFieldCoder* decoder = seg->decoder();
+    const auto& fields = decoder->fields();
+    std::vector<CellID>   cells;
+    std::vector<DDSegmentation::Vector3D> pos;
+    std::size_t mismatch = 0;
+
+    for( int ix = -25 ; ix < 25 ; ++ix )
+      for( int iy = -25 ; iy < 25 ; ++iy )
+        for( int iz = -4 ; iz < 4 ; ++iz )  {
+          DDSegmentation::Vector3D p(ix*1.7, iy*1.3, iz*2.9);
+          cells.emplace_back( seg->cellID(p, p, 0) ) ;
+        }
+    std::size_t n = cells.size() ;
+    pos.resize( n ) ;
+
+    //---- String keyed field access
+    long sum = 0 ;
+    auto start = std::chrono::high_resolution_clock::now() ;
+    for( std::size_t t = 0 ; t < turns ; ++t )
+      for( std::size_t i = 0 ; i < n ; ++i )
+        for( const auto& f : fields )
+          sum += decoder->get( cells[i], f.name() ) ;
+    double t_str = elapsed( start ) ;
+
+    //---- Index based field access
+    start = std::chrono::high_resolution_clock::now() ;
+    for( std::size_t t = 0 ; t < turns ; ++t )
+      for( std::size_t i = 0 ; i < n ; ++i )
+        for( const auto& f : fields )
+          sum -= f.value( cells[i] ) ;
+    double t_idx = elapsed( start ) ;
+
+    //---- Segmentation: cellID -> position
+    start = std::chrono::high_resolution_clock::now() ;
+    for( std::size_t t = 0 ; t < turns ; ++t )
+      for( std::size_t i = 0 ; i < n ; ++i )
+        pos[i] = seg->position( cells[i] ) ;
+    double t_pos = elapsed( start ) ;
+
+    //---- Segmentation: position -> cellID
+    start = std::chrono::high_resolution_clock::now() ;
+    for( std::size_t t = 0 ; t < turns ; ++t )
+      for( std::size_t i = 0 ; i < n ; ++i )
+        if( seg->cellID( pos[i], pos[i], 0 ) != cells[i] && t == 0 ) ++mismatch ;
+    double t_id = elapsed( start ) ;
+
+    //---- Segmentation: cellID -> volumeID
+    VolumeID vid = 0 ;
+    start = std::chrono::high_resolution_clock::now() ;
+    for( std::size_t t = 0 ; t < turns ; ++t )
+      for( std::size_t i = 0 ; i < n ; ++i )
+        vid |= seg->volumeID( cells[i] ) ;
+    double t_vid = elapsed( start ) ;
+
+    double num = double( n * turns ) ;
+    double nfld = num * double( fields.size() ) ;
+    printout( ALWAYS, "SegmentationBench", "+++ %-24s %-24s %ld cells %ld fields  checksum: %ld/%ld",
+              readout.c_str(), seg->type().c_str(), n, fields.size(), sum, long(vid) ) ;
+    printout( ALWAYS, "SegmentationBench", "+++      field get: by name %12.0f /sec  by index %12.0f /sec  speedup %.2f",
+              nfld/t_str, nfld/t_idx, t_str/t_idx ) ;
+    printout( ALWAYS, "SegmentationBench", "+++      position %12.0f /sec  cellID %12.0f /sec  volumeID %12.0f /sec  mismatches: %ld",
+              num/t_pos, num/t_id, num/t_vid, mismatch ) ;
+  }
+}
+
+int main_wrapper(int argc, char** argv ){
+
+  if( argc < 2 ) {
+    std::cout << " usage: bench_segmentation_bitfield compact.xml [turns]" << std::endl ;
+    exit(1) ;
+  }
+  std::size_t turns = argc > 2 ? std::stoul( argv[2] ) : 10 ;
+
+  Detector& description = Detector::getInstance();
+  description.fromCompact( argv[1] );
+
+  for( const auto& r : description.readouts() ){
+    Readout ro( r.second ) ;
+    Segmentation seg = ro.segmentation() ;
+    if( !seg.isValid() || !seg.segmentation() ) continue ;
+    try {
+      bench( r.first, seg.segmentation(), turns ) ;
+    }
+    catch( const std::exception& e ){
+      printout( WARNING, "SegmentationBench", "+++ %-24s %-24s skipped: %s",
+                r.first.c_str(), seg.type().c_str(), e.what() ) ;
+    }
+  }
+  return 0 ;
+}
+
+//=============================================================================
+#include "main.h"
@@ -0,0 +1,95 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+import os
+import logging
+import DDG4
+from g4units import GeV, MeV
+#
+logging.basicConfig(format='%(levelname)s: %(message)s', level=logging.INFO)
+logger = logging.getLogger(__name__)
+#
+"""
+
+   dd4hep simulation example setup DDG4 in multi-threaded mode
+   with the buffered ROOT output and several runs writing the same file
+
+   python MiniTel_buffered_MT.py -batch -threads 4 -runs 2 -events 20
+
+   \author  agent
+   \version 1.0
+
+"""
+
+
+def setupWorker(geant4, output):
+  kernel = geant4.kernel()
+  logger.info('#PYTHON: +++ Creating Geant4 worker thread ....')
+  geant4.setupROOTOutput('RootOutput', output, mc_truth=True, buffered=True)
+  geant4.setupGun('Gun', particle='pi-', energy=10 * GeV, multiplicity=1)
+
+  gen = DDG4.GeneratorAction(kernel, "Geant4InteractionMerger/InteractionMerger")
+  kernel.generatorAction().adopt(gen)
+  gen = DDG4.GeneratorAction(kernel, "Geant4PrimaryHandler/PrimaryHandler")
+  kernel.generatorAction().adopt(gen)
+  part = DDG4.GeneratorAction(kernel, "Geant4ParticleHandler/ParticleHandler")
+  part.SaveProcesses = ['Decay']
+  part.MinimalKineticEnergy = 1 * MeV
+  kernel.generatorAction().adopt(part)
+  return 1
+
+
+def setupMaster(geant4):
+  logger.info('#PYTHON: +++ Setting up master thread for %d workers', int(geant4.master().NumberOfThreads))
+  return 1
+
+
+def setupSensitives(geant4):
+  from dd4hep import DetElement
+  for i in geant4.description.detectors():
+    det = DetElement(i.second.ptr())
+    sd = geant4.description.sensitiveDetector(str(det.name()))
+    if sd.isValid():
+      geant4.setupTracker(det.name())
+  return 1
+
+
+def run():
+  args = DDG4.CommandLine()
+  kernel = DDG4.Kernel()
+  install_dir = os.environ['DD4hepExamplesINSTALL']
+  kernel.loadGeometry(str("file:" + install_dir + "/examples/ClientTests/compact/MiniTel.xml"))
+  kernel.NumberOfThreads = int(args.threads or 4)
+  kernel.RunManagerType = 'G4MTRunManager'
+  geant4 = DDG4.Geant4(kernel)
+  ui = geant4.setupCshUI()
+  if args.batch:
+    ui.Commands = ['/run/beamOn ' + str(args.events or 20)] * int(args.runs or 2) + ['/ddg4/UI/terminate']
+    kernel.UI = ''
+
+  output = args.output or 'MiniTel_buffered_MT.root'
+  geant4.addUserInitialization(worker=setupWorker, worker_args=(geant4, output),
+                               master=setupMaster, master_args=(geant4,))
+  seq, act = geant4.addDetectorConstruction("Geant4DetectorGeometryConstruction/ConstructGeo")
+  seq, act = geant4.addDetectorConstruction("Geant4PythonDetectorConstruction/SetupSD",
+                                            sensitives=setupSensitives, sensitives_args=(geant4,))
+  seq, act = geant4.addDetectorConstruction("Geant4DetectorSensitivesConstruction/ConstructSD")
+  geant4.setupTrackingFieldMT()
+
+  rndm = DDG4.Action(kernel, 'Geant4Random/Random')
+  rndm.Seed = 987654321
+  rndm.initialize()
+
+  geant4.setupPhysics('QGSP_BERT')
+  geant4.run()
+
+
+if __name__ == "__main__":
+  run()
@@ -0,0 +1,55 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+import DDG4
+#
+"""
+
+   dd4hep example setup using the python configuration
+
+   Simulate events with a fixed random seed and check the particle record
+   and the track equivalents of the particle handler against the original
+   std::map based algorithm (action Geant4ParticleRecordCheck).
+
+   \author  agent
+   \version 1.0
+
+"""
+
+
+def run():
+  from MiniTelSetup import Setup
+  args = DDG4.CommandLine()
+
+  m = Setup(geometry=args.geometry)
+  cmds = ['/run/beamOn ' + str(args.events or 10)]
+  if args.batch:
+    DDG4.setPrintLevel(DDG4.OutputLevel.WARNING)
+    cmds.append('/ddg4/UI/terminate')
+    m.kernel.UI = ''
+
+  seq, act = m.geant4.addDetectorConstruction("Geant4DetectorGeometryConstruction/ConstructGeo")
+  seq, act = m.geant4.addDetectorConstruction("Geant4DetectorSensitivesConstruction/ConstructSD")
+  m.ui.Commands = cmds
+  m.configure()
+  rndm = DDG4.Action(m.kernel, 'Geant4Random/Random')
+  rndm.Seed = 987654321
+  rndm.initialize()
+
+  m.setupGun()
+  m.setupGenerator()
+  check = DDG4.EventAction(m.kernel, 'Geant4ParticleRecordCheck/ParticleRecordCheck')
+  m.kernel.eventAction().adopt(check)
+  m.setupPhysics()
+  m.run()
+
+
+if __name__ == "__main__":
+  run()
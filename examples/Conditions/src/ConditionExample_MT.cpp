@@ -22,6 +22,10 @@
    Populate the conditions store by hand for a set of IOVs.
    Then compute the corresponding alignment entries....
 
+   With the option -scaling the event processing is repeated with
+   1, 2, 4, ... up to the requested number of threads and the
+   throughput of the prepare calls is printed for each step.
+
 */
 // Framework include files
 #include "ConditionExampleObjects.h"
@@ -140,8 +144,8 @@ namespace {
             printout(INFO,"Re-use","Thread:%3d Conditions reused: %d times. "
                      "Number of accesses:%d       IOV:%s",
                      identifier, num_reuse, num_access, pool_iov.str().c_str());
-            printout(INFO,"Prepare","Thread:%3d Total %ld conditions (S:%6ld,L:%6ld,C:%6ld,M:%ld) of type %s [%8.3f sec]",
-                     identifier, res.total(), res.selected, res.loaded, res.computed, res.missing,
+            printout(INFO,"Prepare","Thread:%3d Total %ld conditions (S:%6ld,L:%6ld,C:%6ld,M:%ld,R:%ld) of type %s [%8.3f sec]",
+                     identifier, res.total(), res.selected, res.loaded, res.computed, res.missing, res.reused,
                      iov.str().c_str(), stop.AsDouble()-start.AsDouble());
           }
           num_access = accessConditions(iov);
@@ -173,7 +177,7 @@ namespace {
 static int condition_example (Detector& description, int argc, char** argv)  {
   string input;
   int    num_iov = 10, num_threads = 1, num_run = 30;
-  bool   arg_error = false;
+  bool   arg_error = false, scaling = false, incremental = false;
   for(int i=0; i<argc && argv[i]; ++i)  {
     if ( 0 == ::strncmp("-input",argv[i],4) )
       input = argv[++i];
@@ -183,6 +187,10 @@ static int condition_example (Detector& description, int argc, char** argv)  {
       num_run = ::atol(argv[++i]);
     else if ( 0 == ::strncmp("-threads",argv[i],4) )
       num_threads = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-scaling",argv[i],4) )
+      scaling = true;
+    else if ( 0 == ::strncmp("-incremental",argv[i],4) )
+      incremental = true;
     else
       arg_error = true;
   }
@@ -195,6 +203,8 @@ static int condition_example (Detector& description, int argc, char** argv)  {
       "     -iovs    <number>        Number of parallel IOV slots for processing.    \n"
       "     -runs    <number>        Number of collision loads to be performed.      \n"
       "     -threads <number>        Number of execution threads.                    \n"
+      "     -scaling                 Measure prepare throughput for 1,2,4..threads.  \n"
+      "     -incremental             Only update expired conditions at IOV changes.  \n"
       "\tArguments given: " << arguments(argc,argv) << endl << flush;
     ::exit(EINVAL);
   }
@@ -229,23 +239,40 @@ static int condition_example (Detector& description, int argc, char** argv)  {
     printout(INFO,"Example", "Setup %ld conditions for IOV:%s [%8.3f sec]",
              count, iov.str().c_str(),stop.AsDouble()-start.AsDouble());
     stats.total_created += count;
-    // Fill the event queue with 10 evt per run
-    for(int j=0; j<6; ++j)   {
-      events.push(make_pair((i*10)+j,num_run));
-    }
   }
+  auto fill_queue = [&events, num_iov, num_run]()  {
+    // Fill the event queue with 10 evt per run
+    for(int i=0; i<num_iov; ++i)
+      for(int j=0; j<6; ++j)
+        events.push(make_pair((i*10)+j,num_run));
+  };
 
   // ++++++++++++++++++++++++ Now compute the conditions for each of these IOVs
-  vector<thread*> threads;
-  for(int i=0; i<num_threads; ++i)  {
-    Executor* exec = new Executor(manager, iov_typ, i, events, stats);
-    exec->slice = new ConditionsSlice(*slice);
-    thread* t = new thread( [exec]{ exec->run(); delete exec; });
-    threads.push_back(t);
-  }
-  for(thread* t : threads)  {
-    t->join();
-    delete t;
+  auto run_threads = [&](int nthreads)  {
+    vector<thread*> threads;
+    for(int i=0; i<nthreads; ++i)  {
+      Executor* exec = new Executor(manager, iov_typ, i, events, stats);
+      exec->slice = new ConditionsSlice(*slice);
+      if ( incremental ) exec->slice->incremental();
+      thread* t = new thread( [exec]{ exec->run(); delete exec; });
+      threads.push_back(t);
+    }
+    for(thread* t : threads)  {
+      t->join();
+      delete t;
+    }
+  };
+  for(int nthreads = scaling ? 1 : num_threads; nthreads <= num_threads; nthreads *= 2)  {
+    Long64_t num_prepare = stats.prepare.GetN();
+    fill_queue();
+    TTimeStamp start;
+    run_threads(nthreads);
+    TTimeStamp stop;
+    if ( scaling )  {
+      double secs = stop.AsDouble()-start.AsDouble();
+      printout(ALWAYS,"Scaling","+++ Threads: %3d  %6lld prepare calls  Throughput: %10.2f prepare/sec",
+               nthreads, stats.prepare.GetN()-num_prepare, double(stats.prepare.GetN()-num_prepare)/secs);
+    }
   }
   printout(INFO,"Statistics",
            "+======= Summary: # of IOV: %3d  # of Threads: %3d ========================",
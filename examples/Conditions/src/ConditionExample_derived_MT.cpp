@@ -0,0 +1,229 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : agent
+//
+//==========================================================================
+/*
+   Plugin invocation:
+   ==================
+   This plugin behaves like a main program.
+   Invoke the plugin with something like this:
+
+   geoPluginRun -volmgr -destroy -plugin DD4hep_ConditionExample_derived_MT \
+   -input file:${DD4hep_DIR}/examples/AlignDet/compact/Telescope.xml -threads 4
+
+   Populate the conditions store by hand for a set of IOVs.
+   Then compute the derived conditions for each IOV twice: serially and
+   with the level-parallel evaluation (property DerivedConditionsThreads).
+   Both user pools must contain the same keys with identical values.
+   A probe dependency chain verifies that the parallel evaluation was
+   used: the serial evaluation creates all derived conditions before
+   resolving any of them, the level-parallel evaluation resolves the
+   first level before the second level is created.
+
+*/
+// Framework include files
+#include "ConditionExampleObjects.h"
+#include "DD4hep/Factories.h"
+
+// C/C++ include files
+#include <map>
+#include <atomic>
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::ConditionExamples;
+using cond::DependencyBuilder;
+
+namespace {
+
+  /// Collect the string representation of all conditions of a user pool
+  struct ConditionsCollector : public Condition::Processor  {
+    map<Condition::key_type,string>& values;
+    ConditionsCollector(map<Condition::key_type,string>& v) : values(v) {}
+    virtual int process(Condition c)  const override  {
+      int flags = Condition::WITH_IOV|Condition::WITH_DATATYPE|Condition::WITH_DATA;
+      try  {
+        values[c.key()] = c.str(flags);
+      }
+      catch(const exception&)  {
+        values[c.key()] = c.str(flags&~Condition::WITH_DATA);
+      }
+      return 1;
+    }
+  };
+
+  /// Probe callback detecting the level-parallel evaluation of derived conditions
+  class ProbeUpdate : public ConditionUpdateCall  {
+  public:
+    /// Number of resolved first level probes since the last reset
+    static std::atomic<long> num_resolved;
+    /// Number of second level probes created after a first level probe was resolved
+    static std::atomic<long> num_interleaved;
+    /// Level of the probe in the dependency chain
+    int level;
+    /// Initializing constructor
+    ProbeUpdate(int lvl) : level(lvl) {}
+    /// Interface to client Callback in order to update the condition
+    virtual Condition operator()(const ConditionKey& key, ConditionUpdateContext&) override  final  {
+      if ( level > 0 && num_resolved.load() > 0 ) ++num_interleaved;
+      Condition target(key.hash);
+      target.construct<int>();
+      return target;
+    }
+    /// Interface to client Callback in order to update the condition
+    virtual void resolve(Condition target, ConditionUpdateContext& context) override  final  {
+      target.get<int>() = level;
+      if ( level == 0 ) ++num_resolved;
+      context.condition(context.key(0));
+    }
+  };
+  std::atomic<long> ProbeUpdate::num_resolved    {0};
+  std::atomic<long> ProbeUpdate::num_interleaved {0};
+
+  /// Prepare the slice for one IOV with a given number of threads for the derived conditions
+  ConditionsManager::Result prepare(ConditionsManager manager, ConditionsSlice& slice, const IOV& iov,
+                                    int num_threads, map<Condition::key_type,string>& values)
+  {
+    manager["DerivedConditionsThreads"] = num_threads;
+    ConditionsManager::Result res = manager.prepare(iov, slice);
+    slice.pool->scan(ConditionsCollector(values));
+    return res;
+  }
+}
+
+/// Plugin function: Compare the serial and the parallel computation of derived conditions
+/**
+ *  Factory: DD4hep_ConditionExample_derived_MT
+ *
+ *  \author  agent
+ *  \version 1.0
+ */
+static int condition_example (Detector& description, int argc, char** argv)  {
+
+  string     input;
+  int        num_iov = 10, extend = 0, num_threads = 4;
+  bool       arg_error = false;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-input",argv[i],4) )
+      input = argv[++i];
+    else if ( 0 == ::strncmp("-iovs",argv[i],4) )
+      num_iov = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-extend",argv[i],4) )
+      extend = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-threads",argv[i],4) )
+      num_threads = ::atol(argv[++i]);
+    else
+      arg_error = true;
+  }
+  if ( arg_error || input.empty() )   {
+    /// Help printout describing the basic command line interface
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_ConditionExample_derived_MT              \n"
+      "     -input   <string>        Geometry file                                   \n"
+      "     -iovs    <number>        Number of parallel IOV slots for processing.    \n"
+      "     -extend  <number>        Number of additional dependency levels.         \n"
+      "     -threads <number>        Number of threads for the derived conditions.   \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+
+  // First we load the geometry
+  description.fromXML(input);
+
+  /******************** Initialize the conditions manager *****************/
+  ConditionsManager manager = installManager(description);
+  const IOVType*    iov_typ = manager.registerIOVType(0,"run").second;
+  if ( 0 == iov_typ )
+    except("ConditionsPrepare","++ Unknown IOV type supplied.");
+
+  /******************** Now as usual: create the slices *******************/
+  shared_ptr<ConditionsContent> content(new ConditionsContent());
+  shared_ptr<ConditionsSlice>   serial(new ConditionsSlice(manager,content));
+  shared_ptr<ConditionsSlice>   parallel(new ConditionsSlice(manager,content));
+  Scanner(ConditionsKeys(*content,INFO),description.world());
+  Scanner(ConditionsDependencyCreator(*content,DEBUG,false,extend),description.world());
+  {
+    DetElement world = description.world();
+    ConditionKey probe0(world,"derived_data/probe_0");
+    DependencyBuilder build_0(world, probe0.item_key(), std::make_shared<ProbeUpdate>(0));
+    DependencyBuilder build_1(world, "derived_data/probe_1", std::make_shared<ProbeUpdate>(1));
+    build_0.add(ConditionKey(world,"derived_data"));
+    build_1.add(probe0);
+    content->addDependency(build_0.release());
+    content->addDependency(build_1.release());
+  }
+
+  /******************** Populate the conditions store *********************/
+  for(int i=0; i<num_iov; ++i)  {
+    IOV iov(iov_typ, IOV::Key(1+i*10,(i+1)*10));
+    ConditionsPool*   iov_pool = manager.registerIOV(*iov.iovType, iov.key());
+    Scanner(ConditionsCreator(*serial, *iov_pool, DEBUG),description.world(),0,true);
+  }
+
+  // ++++++++++++++++++++++++ Compute the conditions serially and in parallel
+  size_t num_compared = 0, num_differences = 0;
+  ConditionsManager::Result total_serial, total_parallel;
+  for(int i=0; i<num_iov; ++i)  {
+    IOV req_iov(iov_typ,i*10+5);
+    map<Condition::key_type,string> serial_values, parallel_values;
+    ProbeUpdate::num_resolved = 0;
+    total_serial   += prepare(manager, *serial,   req_iov, 0,           serial_values);
+    if ( ProbeUpdate::num_interleaved.load() > 0 )  {
+      printout(ERROR,"Compare","++ Serial evaluation resolved derived conditions level by level.");
+      ++num_differences;
+    }
+    ProbeUpdate::num_resolved = 0;
+    ProbeUpdate::num_interleaved = 0;
+    total_parallel += prepare(manager, *parallel, req_iov, num_threads, parallel_values);
+    if ( ProbeUpdate::num_interleaved.load() == 0 )  {
+      printout(ERROR,"Compare","++ Derived conditions were not evaluated in parallel.");
+      ++num_differences;
+    }
+    ProbeUpdate::num_interleaved = 0;
+    for( const auto& v : serial_values )   {
+      auto j = parallel_values.find(v.first);
+      if ( j == parallel_values.end() )  {
+        printout(ERROR,"Compare","++ Condition %016llX missing in the parallel computation.",v.first);
+        ++num_differences;
+      }
+      else if ( j->second != v.second )  {
+        printout(ERROR,"Compare","++ Condition %016llX differs: '%s' <> '%s'",
+                 v.first, v.second.c_str(), j->second.c_str());
+        ++num_differences;
+      }
+    }
+    if ( serial_values.size() != parallel_values.size() )  {
+      printout(ERROR,"Compare","++ Number of conditions differs: %ld <> %ld",
+               serial_values.size(), parallel_values.size());
+      ++num_differences;
+    }
+    num_compared += serial_values.size();
+  }
+  printout(ALWAYS,"Statistics","+=========================================================================");
+  printout(ALWAYS,"Statistics","+  Serial:   %ld conditions (S:%6ld,L:%6ld,C:%6ld,M:%ld)",
+           total_serial.total(), total_serial.selected, total_serial.loaded,
+           total_serial.computed, total_serial.missing);
+  printout(ALWAYS,"Statistics","+  Parallel: %ld conditions (S:%6ld,L:%6ld,C:%6ld,M:%ld) with %d threads",
+           total_parallel.total(), total_parallel.selected, total_parallel.loaded,
+           total_parallel.computed, total_parallel.missing, num_threads);
+  printout(ALWAYS,"Statistics","+  Compared %ld conditions: %ld differences.", num_compared, num_differences);
+  printout(ALWAYS,"Statistics","+=========================================================================");
+  if ( num_differences > 0 || total_serial.computed != total_parallel.computed )
+    printout(ALWAYS,"Statistics","Test FAILED");
+  else
+    printout(ALWAYS,"Statistics","Test PASSED");
+  // All done.
+  return 1;
+}
+
+// first argument is the type from the xml file
+DECLARE_APPLY(DD4hep_ConditionExample_derived_MT,condition_example)
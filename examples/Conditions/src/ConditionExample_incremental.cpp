@@ -0,0 +1,165 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : agent
+//
+//==========================================================================
+/*
+   Plugin invocation:
+   ==================
+   This plugin behaves like a main program.
+   Invoke the plugin with something like this:
+
+   geoPluginRun -volmgr -destroy -plugin DD4hep_ConditionExample_incremental \
+   -input file:${DD4hep_DIR}/examples/AlignDet/compact/Telescope.xml -iovs 5 -cleanup 1
+
+   The conditions of each run range are created when the range is reached
+   (like a conditions loader would do). An incremental slice is prepared for
+   several IOVs of every run range. After each preparation the conditions
+   cache is cleaned: pools which were not used by the last preparation
+   are removed. The content of the incremental slice is compared with a
+   slice fully prepared for the same IOV.
+
+*/
+// Framework include files
+#include "ConditionExampleObjects.h"
+#include "DD4hep/Factories.h"
+
+// C/C++ include files
+#include <map>
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::ConditionExamples;
+
+namespace {
+
+  /// Collect the string representation of all conditions of a user pool
+  struct ConditionsCollector : public Condition::Processor  {
+    map<Condition::key_type,string>& values;
+    ConditionsCollector(map<Condition::key_type,string>& v) : values(v) {}
+    virtual int process(Condition c)  const override  {
+      int flags = Condition::WITH_IOV|Condition::WITH_DATATYPE|Condition::WITH_DATA;
+      try  {
+        values[c.key()] = c.str(flags);
+      }
+      catch(const exception&)  {
+        values[c.key()] = c.str(flags&~Condition::WITH_DATA);
+      }
+      return 1;
+    }
+  };
+}
+
+/// Plugin function: Incremental slice preparation with conditions cleanup
+/**
+ *  Factory: DD4hep_ConditionExample_incremental
+ *
+ *  \author  agent
+ *  \version 1.0
+ */
+static int condition_example (Detector& description, int argc, char** argv)  {
+
+  string     input;
+  int        num_iov = 5, num_events = 5, max_age = 1;
+  bool       arg_error = false;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-input",argv[i],4) )
+      input = argv[++i];
+    else if ( 0 == ::strncmp("-iovs",argv[i],4) )
+      num_iov = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-events",argv[i],4) )
+      num_events = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-cleanup",argv[i],4) )
+      max_age = ::atol(argv[++i]);
+    else
+      arg_error = true;
+  }
+  if ( arg_error || input.empty() || num_events < 1 || num_events > 9 )   {
+    /// Help printout describing the basic command line interface
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_ConditionExample_incremental             \n"
+      "     -input   <string>        Geometry file                                   \n"
+      "     -iovs    <number>        Number of run ranges.                           \n"
+      "     -events  <number>        Number of IOVs per run range [1...9].           \n"
+      "     -cleanup <number>        Maximal age of conditions pools.                \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+
+  // First we load the geometry
+  description.fromXML(input);
+
+  /******************** Initialize the conditions manager *****************/
+  ConditionsManager manager = installManager(description);
+  const IOVType*    iov_typ = manager.registerIOVType(0,"run").second;
+  if ( 0 == iov_typ )
+    except("ConditionsPrepare","++ Unknown IOV type supplied.");
+
+  /******************** Now as usual: create the slice ********************/
+  shared_ptr<ConditionsContent> content(new ConditionsContent());
+  shared_ptr<ConditionsSlice>   slice(new ConditionsSlice(manager,content));
+  Scanner(ConditionsKeys(*content,INFO),description.world());
+  Scanner(ConditionsDependencyCreator(*content,DEBUG),description.world());
+  slice->incremental();
+
+  // ++++++++++++++++++++++++ Prepare the incremental slice and clean the cache
+  size_t num_compared = 0, num_differences = 0;
+  ConditionsManager::Result total;
+  for(int i=0; i<num_iov; ++i)  {
+    IOV range(iov_typ, IOV::Key(1+i*10,(i+1)*10));
+    ConditionsPool* iov_pool = manager.registerIOV(*range.iovType, range.key());
+    Scanner(ConditionsCreator(*slice, *iov_pool, DEBUG),description.world(),0,true);
+    for(int j=1; j<=num_events; ++j)  {
+      IOV req_iov(iov_typ, i*10+j);
+      ConditionsManager::Result r = manager.prepare(req_iov,*slice);
+      total += r;
+      printout(INFO,"Prepare","Total %ld conditions (S:%ld,L:%ld,C:%ld,M:%ld,R:%ld) of IOV %s",
+               r.total(), r.selected, r.loaded, r.computed, r.missing, r.reused, req_iov.str().c_str());
+      manager.clean(iov_typ, max_age);
+
+      /// Reference: a fresh slice fully prepared for the same IOV
+      map<Condition::key_type,string> values, reference;
+      ConditionsSlice ref(manager,content);
+      manager.prepare(req_iov,ref);
+      slice->pool->scan(ConditionsCollector(values));
+      ref.pool->scan(ConditionsCollector(reference));
+      for( const auto& v : reference )   {
+        auto k = values.find(v.first);
+        if ( k == values.end() || k->second != v.second )  {
+          printout(ERROR,"Compare","++ IOV %s: Condition %016llX differs: '%s' <> '%s'",
+                   req_iov.str().c_str(), v.first, v.second.c_str(),
+                   k == values.end() ? "(missing)" : k->second.c_str());
+          ++num_differences;
+        }
+      }
+      if ( values.size() != reference.size() )  {
+        printout(ERROR,"Compare","++ IOV %s: Number of conditions differs: %ld <> %ld",
+                 req_iov.str().c_str(), values.size(), reference.size());
+        ++num_differences;
+      }
+      num_compared += reference.size();
+    }
+  }
+  printout(ALWAYS,"Statistics","+=========================================================================");
+  printout(ALWAYS,"Statistics","+  Accessed a total of %ld conditions (S:%6ld,L:%6ld,C:%6ld,M:%ld,R:%ld)",
+           total.total(), total.selected, total.loaded, total.computed, total.missing, total.reused);
+  printout(ALWAYS,"Statistics","+  Compared %ld conditions: %ld differences.", num_compared, num_differences);
+  printout(ALWAYS,"Statistics","+=========================================================================");
+  if ( num_differences > 0 || total.reused == 0 || total.missing > 0 )
+    printout(ALWAYS,"Statistics","Test FAILED");
+  else
+    printout(ALWAYS,"Statistics","Test PASSED");
+  // All done.
+  return 1;
+}
+
+// first argument is the type from the xml file
+DECLARE_APPLY(DD4hep_ConditionExample_incremental,condition_example)
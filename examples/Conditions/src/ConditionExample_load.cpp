@@ -28,6 +28,7 @@
 #include "ConditionExampleObjects.h"
 #include "DDCond/ConditionsIOVPool.h"
 #include "DDCond/ConditionsManager.h"
+#include "DDCond/ConditionsDataLoader.h"
 #include "DDCond/ConditionsRootPersistency.h"
 #include "DD4hep/Factories.h"
 
@@ -44,6 +45,7 @@ static void help(int argc, char** argv)  {
     "     -conditions  <string>    Conditions input file                           \n"
     "     -iovs        <number>    Number of parallel IOV slots for processing.    \n"
     "     -restore     <string>    Restore strategy: iovpool, userpool or condpool.\n"
+    "                              mmap: load on demand from a binary snapshot.    \n"
     "\tArguments given: " << arguments(argc,argv) << endl << flush;
   ::exit(EINVAL);
 }
@@ -82,44 +84,63 @@ static int condition_example (Detector& description, int argc, char** argv)  {
   detail::have_condition_item_inventory(1);
   
   /******************** Initialize the conditions manager *****************/
-  ConditionsManager manager = installManager(description);
+  ConditionsManager manager;
+  if ( restore == "mmap" )  {
+    /// Conditions are loaded on demand by the loader when preparing the slices
+    description.apply("DD4hep_ConditionsManagerInstaller",0,(char**)0);
+    manager = ConditionsManager::from(description);
+    manager["PoolType"]       = "DD4hep_ConditionsLinearPool";
+    manager["UserPoolType"]   = "DD4hep_ConditionsMapUserPool";
+    manager["UpdatePoolType"] = "DD4hep_ConditionsLinearUpdatePool";
+    manager["LoaderType"]     = "DD4hep_Conditions_mmap_Loader";
+    manager.initialize();
+    manager.registerIOVType(0,"run");
+    manager.loader().addSource(conditions);
+  }
+  else  {
+    manager = installManager(description);
+  }
   shared_ptr<ConditionsContent> content(new ConditionsContent());
   shared_ptr<ConditionsSlice>   slice(new ConditionsSlice(manager,content));
   Scanner(ConditionsKeys(*content,INFO),description.world());
   Scanner(ConditionsDependencyCreator(*content,DEBUG,false,extend),description.world());
 
   /******************** Load the conditions from file *********************/
-  printout(INFO,"ConditionsExample","+  Start conditions import from ROOT object(s): %s",
-           conditions.c_str());
-  try  {
-    auto pers = cond::ConditionsRootPersistency::load(conditions.c_str(),"DD4hep Conditions");
-    printout(ALWAYS,"Statistics","+=========================================================================");
-    printout(ALWAYS,"Statistics","+  Loaded conditions object from file %s. Took %8.3f seconds.",
-             conditions.c_str(),pers->duration);
-    size_t num_cond = 0;
-    if      ( restore == "iovpool" )
-      num_cond = pers->importIOVPool("ConditionsIOVPool No 1","run",manager);
-    else if ( restore == "userpool" )
-      num_cond = pers->importUserPool("*","run",manager);
-    else if ( restore == "condpool" )
-      num_cond = pers->importConditionsPool("*","run",manager);
-    else
-      help(argc,argv);
+  if ( restore != "mmap" )  {
+    try  {
+      printout(INFO,"ConditionsExample","+  Start conditions import from ROOT object(s): %s",
+               conditions.c_str());
+      auto pers = cond::ConditionsRootPersistency::load(conditions.c_str(),"DD4hep Conditions");
+      printout(ALWAYS,"Statistics","+=========================================================================");
+      printout(ALWAYS,"Statistics","+  Loaded conditions object from file %s. Took %8.3f seconds.",
+               conditions.c_str(),pers->duration);
+      size_t num_cond = 0;
+      if      ( restore == "iovpool" )
+        num_cond = pers->importIOVPool("ConditionsIOVPool No 1","run",manager);
+      else if ( restore == "userpool" )
+        num_cond = pers->importUserPool("*","run",manager);
+      else if ( restore == "condpool" )
+        num_cond = pers->importConditionsPool("*","run",manager);
+      else
+        help(argc,argv);
 
-    printout(ALWAYS,"Statistics","+  Imported %ld conditions from %s to IOV pool. Took %8.3f seconds.",
-             num_cond, restore.c_str(), pers->duration);
-    printout(ALWAYS,"Statistics","+=========================================================================");
-  }
-  catch(const exception& e)    {
-    printout(ERROR,"ConditionsExample","Failed to import ROOT object(s): %s",e.what());    
-    throw;
+      printout(ALWAYS,"Statistics","+  Imported %ld conditions from %s to IOV pool. Took %8.3f seconds.",
+               num_cond, restore.c_str(), pers->duration);
+      printout(ALWAYS,"Statistics","+=========================================================================");
+    }
+    catch(const exception& e)    {
+      printout(ERROR,"ConditionsExample","Failed to import ROOT object(s): %s",e.what());    
+      throw;
+    }
   }
   
   // ++++++++++++++++++++++++ Now compute the conditions for each of these IOVs
   const IOVType* iov_typ = manager.iovType("run");
   cond::ConditionsIOVPool* pool = manager.iovPool(*iov_typ);
-  for( const auto& p : pool->elements )
-    p.second->print("*");
+  if ( pool )  {
+    for( const auto& p : pool->elements )
+      p.second->print("*");
+  }
 
   ConditionsManager::Result total;
   for(int i=0; i<num_iov; ++i)  {
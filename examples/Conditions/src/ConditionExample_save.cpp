@@ -29,6 +29,7 @@
 #include "DDCond/ConditionsManager.h"
 #include "DDCond/ConditionsIOVPool.h"
 #include "DDCond/ConditionsRootPersistency.h"
+#include "DDCond/ConditionsBinarySnapshot.h"
 #include "DD4hep/Factories.h"
 
 using namespace std;
@@ -44,7 +45,7 @@ using namespace dd4hep::ConditionExamples;
  *  \date    01/12/2016
  */
 static int condition_example (Detector& description, int argc, char** argv)  {
-  string input, conditions;
+  string input, conditions, binary;
   int    num_iov = 10;
   bool   arg_error = false;
   bool   output_iovpool  = true;
@@ -58,6 +59,8 @@ static int condition_example (Detector& description, int argc, char** argv)  {
       conditions = argv[++i];
     else if ( 0 == ::strncmp("-iovs",argv[i],4) )
       num_iov = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-binary",argv[i],4) )
+      binary = argv[++i];
     else
       arg_error = true;
   }
@@ -69,6 +72,7 @@ static int condition_example (Detector& description, int argc, char** argv)  {
       "     -input       <string>    Geometry file                                   \n"
       "     -conditions  <string>    Conditions output file                          \n"
       "     -iovs        <number>    Number of parallel IOV slots for processing.    \n"
+      "     -binary      <string>    Optional memory mappable binary snapshot file.  \n"
       "\tArguments given: " << arguments(argc,argv) << endl << flush;
     ::exit(EINVAL);
   }
@@ -163,6 +167,11 @@ static int condition_example (Detector& description, int argc, char** argv)  {
              "+++ Successfully saved %ld condition to file.",total_count);
   }
   delete persist;
+  if ( !binary.empty() )  {
+    count = cond::ConditionsBinarySnapshot::save(manager, binary);
+    printout(ALWAYS,"Example",
+             "+++ Successfully saved %ld conditions to binary snapshot %s.",count,binary.c_str());
+  }
   
   printout(ALWAYS,"Statistics","+=========================================================================");
   printout(ALWAYS,"Statistics","+  Accessed a total of %ld conditions (S:%6ld,L:%6ld,C:%6ld,M:%ld)",